@@ -0,0 +1,403 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+/* Benchmarks the line Blitter of the FastBlitter.
+ *
+ * The benchmark compares Blitter::doFastLineBlit() with a reference
+ * implementation, which is the generic line loop that was used before the
+ * line Blitter was specialized for each octant and mode. The reference
+ * accesses memory through the memory interface only.
+ *
+ * In the first step, both implementations run a large number of random line
+ * blits. The test set includes lines drawn the way graphics.library draws
+ * them, blits with random register values, lines close to the end of Chip
+ * Ram, and blits running in partially mapped Chip Ram. After each blit, Chip
+ * Ram, BLTCON0, BLTCON1, the A, C and D pointers, BNEW, BZERO, and the data
+ * bus must match. The benchmark fails if a single blit differs.
+ *
+ * In the second step, three typical scenes are drawn with both
+ * implementations and the elapsed time is compared.
+ */
+
+// The benchmark sets up the internal registers of the Blitter directly
+#define private public
+#define protected public
+#include "Amiga.h"
+#undef private
+#undef protected
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+// Number of random line blits in the equivalence test
+static const int blitCount = 20000;
+
+// Number of times each scene is drawn
+static const int passes = 10;
+
+// Bytes per row of the bitplane the scenes are drawn into
+static const int bpr = 40;
+
+static std::mt19937 rng(7);
+
+static u32
+randomInt(u32 n)
+{
+    return rng() % n;
+}
+
+
+//
+// Reference implementation
+//
+
+static void
+referenceLineBlit(Blitter &b)
+{
+    Memory &mem = b.mem;
+
+    b.bltapt &= b.agnus.ptrMask;
+    b.bltcpt &= b.agnus.ptrMask;
+    b.bltdpt &= b.agnus.ptrMask;
+
+    u32 bltcon = HI_W_LO_W(b.bltcon0, b.bltcon1);
+
+    int height = b.bltsizeV;
+
+    u16 bltadat = 0;
+    u16 bltbdat = 0;
+    u16 bltcdat = b.chold;
+    u16 bltddat = 0;
+
+    u16 mask = (b.bnew >> b.bltconBSH()) | (b.bnew << (16 - b.bltconBSH()));
+    bool aEnabled = bltcon & 0x08000000;
+    bool cEnabled = bltcon & 0x02000000;
+
+    bool signedDecision = (((bltcon >> 6) & 1) == 1);
+    u32 decision = b.bltapt;
+
+    i16 incSigned = aEnabled ? b.bltbmod : 0;
+    i16 incUnsigned = aEnabled ? b.bltamod : 0;
+
+    u32 cpt = b.bltcpt;
+    u32 dpt = b.bltdpt;
+    u32 ash = b.bltconASH();
+    u32 zero = 0;
+
+    u32 sulsudaul = (bltcon >> 2) & 0x7;
+    bool xIndependent = (sulsudaul & 4);
+    bool xInc = xIndependent ? !(sulsudaul & 1) : !(sulsudaul & 2);
+    bool yInc = xIndependent ? !(sulsudaul & 2) : !(sulsudaul & 1);
+    bool singleDot = false;
+    MintermFunc minterm = mintermFunc((u8)(bltcon >> 16));
+
+    auto stepX = [&](bool inc) {
+        if (inc) {
+            if (++ash == 16) { ash = 0; cpt += 2; }
+        } else {
+            if (ash == 0) { ash = 16; cpt -= 2; }
+            ash--;
+        }
+    };
+    auto stepY = [&](bool inc) {
+        cpt += inc ? b.bltcmod : -b.bltcmod;
+    };
+
+    for (int i = 0; i < height; i++) {
+
+        if (cEnabled) bltcdat = mem.peek16 <AGNUS_ACCESS> (cpt);
+
+        bltadat = (b.anew & b.bltafwm) >> ash;
+
+        if (xIndependent && (bltcon & 0x00000002)) {
+            if (singleDot) {
+                bltadat = 0;
+            } else {
+                singleDot = true;
+            }
+        }
+
+        bltbdat = (mask & 1) ? 0xFFFF : 0;
+        bltddat = minterm(bltadat, bltbdat, bltcdat);
+
+        if (cEnabled) mem.poke16 <AGNUS_ACCESS> (dpt, bltddat);
+
+        zero |= bltddat;
+        mask = (mask << 1) | (mask >> 15);
+
+        if (signedDecision) {
+            decision += incSigned;
+        } else {
+            decision += incUnsigned;
+            if (!xIndependent) {
+                stepX(xInc);
+            } else {
+                stepY(yInc);
+                singleDot = false;
+            }
+        }
+        signedDecision = ((i16)decision < 0);
+
+        if (!xIndependent) stepY(yInc); else stepX(xInc);
+        dpt = cpt;
+    }
+
+    b.setBLTCON0ASH(ash);
+    b.bnew = bltbdat;
+    b.bltapt = decision & b.agnus.ptrMask;
+    b.bltcpt = cpt & b.agnus.ptrMask;
+    b.bltdpt = dpt & b.agnus.ptrMask;
+    b.bzero = zero == 0;
+}
+
+
+//
+// Test driver
+//
+
+// Sets up a line blit the way graphics.library does it
+static void
+setupLine(Blitter &b, u32 screen, int x1, int y1, int x2, int y2,
+          bool sing, u8 minterm)
+{
+    int dx = x2 - x1;
+    int dy = y2 - y1;
+    int adx = dx < 0 ? -dx : dx;
+    int ady = dy < 0 ? -dy : dy;
+    bool xMajor = adx >= ady;
+    int dmax = xMajor ? adx : ady;
+    int dmin = xMajor ? ady : adx;
+    int code = xMajor ?
+    (4 | (dy < 0) << 1 | (dx < 0)) :
+    (0 | (dx < 0) << 1 | (dy < 0));
+    int a = 4 * dmin - 2 * dmax;
+
+    b.bltcon0 = (x1 & 15) << 12 | 0x0B00 | minterm;
+    b.bltcon1 = (x1 & 15) << 12 | code << 2 | (a < 0 ? 0x40 : 0) | sing << 1 | 1;
+    b.bltapt = (u32)(i16)a;
+    b.bltamod = 4 * (dmin - dmax);
+    b.bltbmod = 4 * dmin;
+    b.bltcpt = b.bltdpt = screen + y1 * bpr + 2 * (x1 >> 4);
+    b.bltcmod = b.bltdmod = bpr;
+    b.bltsizeV = dmax + 1;
+    b.bltsizeH = 2;
+    b.anew = 0x8000;
+    b.bnew = 0xFFFF;
+    b.bltafwm = 0xFFFF;
+    b.chold = 0;
+}
+
+// Sets up a line blit with random register values
+static void
+setupRandom(Blitter &b, Memory &mem)
+{
+    u32 chipSize = (u32)mem.chipRamSize();
+
+    if (randomInt(4)) {
+
+        // A line in a bitplane that might be located at the end of Chip Ram
+        u32 screen = randomInt(2) ? 0x10000 : randomInt(chipSize) & ~1;
+        int x1 = randomInt(320), y1 = randomInt(256);
+        int x2 = randomInt(320), y2 = randomInt(256);
+        setupLine(b, screen, x1, y1, x2, y2,
+                  randomInt(2), randomInt(2) ? 0xCA : 0x4A);
+        if (randomInt(2)) b.bnew = (u16)rng();
+        b.chold = (u16)rng();
+
+    } else {
+
+        // Random register contents
+        b.bltcon0 = (u16)rng();
+        b.bltcon1 = (u16)rng() | 1;
+        b.bltapt = rng();
+        b.bltcpt = rng() & ~1;
+        b.bltdpt = randomInt(2) ? b.bltcpt : rng() & ~1;
+        b.bltamod = (i16)rng();
+        b.bltbmod = (i16)rng();
+        b.bltcmod = randomInt(2) ? ((i16)rng() & ~1) : randomInt(2) ? 40 : -80;
+        b.bltsizeV = randomInt(randomInt(2) ? 20 : 1024);
+        b.anew = (u16)rng();
+        b.bnew = (u16)rng();
+        b.bltafwm = (u16)rng();
+        b.chold = (u16)rng();
+    }
+    mem.dataBus = (u16)rng();
+}
+
+// The registers that are set up before a blit
+struct Registers {
+
+    u16 bltcon0, bltcon1;
+    u32 bltapt, bltcpt, bltdpt;
+    i16 bltamod, bltbmod, bltcmod, bltdmod;
+    u16 bltsizeH, bltsizeV;
+    u16 anew, bnew, bltafwm, chold;
+
+    Registers(Blitter &b) :
+    bltcon0(b.bltcon0), bltcon1(b.bltcon1),
+    bltapt(b.bltapt), bltcpt(b.bltcpt), bltdpt(b.bltdpt),
+    bltamod(b.bltamod), bltbmod(b.bltbmod), bltcmod(b.bltcmod), bltdmod(b.bltdmod),
+    bltsizeH(b.bltsizeH), bltsizeV(b.bltsizeV),
+    anew(b.anew), bnew(b.bnew), bltafwm(b.bltafwm), chold(b.chold) { }
+
+    void restore(Blitter &b) const {
+        b.bltcon0 = bltcon0; b.bltcon1 = bltcon1;
+        b.bltapt = bltapt; b.bltcpt = bltcpt; b.bltdpt = bltdpt;
+        b.bltamod = bltamod; b.bltbmod = bltbmod; b.bltcmod = bltcmod; b.bltdmod = bltdmod;
+        b.bltsizeH = bltsizeH; b.bltsizeV = bltsizeV;
+        b.anew = anew; b.bnew = bnew; b.bltafwm = bltafwm; b.chold = chold;
+    }
+};
+
+// The registers that are compared after a blit
+struct Result {
+
+    u16 bltcon0, bltcon1;
+    u32 bltapt, bltcpt, bltdpt;
+    u16 bnew;
+    bool bzero;
+    u16 dataBus;
+
+    Result(Blitter &b, Memory &m) :
+    bltcon0(b.bltcon0), bltcon1(b.bltcon1),
+    bltapt(b.bltapt), bltcpt(b.bltcpt), bltdpt(b.bltdpt),
+    bnew(b.bnew), bzero(b.bzero), dataBus(m.dataBus) { }
+
+    bool operator==(const Result &r) const {
+        return
+        bltcon0 == r.bltcon0 && bltcon1 == r.bltcon1 &&
+        bltapt == r.bltapt && bltcpt == r.bltcpt && bltdpt == r.bltdpt &&
+        bnew == r.bnew && bzero == r.bzero && dataBus == r.dataBus;
+    }
+};
+
+// Runs random line blits with both implementations and compares the results
+static bool
+checkEquivalence(Blitter &b, Memory &mem)
+{
+    u32 chipSize = (u32)mem.chipRamSize();
+    std::vector<u8> ram(chipSize);
+    MemorySource memSrc[256];
+
+    for (u32 i = 0; i < chipSize; i++) mem.chip[i] = (u8)rng();
+    memcpy(memSrc, mem.agnusMemSrc, sizeof(memSrc));
+
+    for (int i = 0; i < blitCount; i++) {
+
+        // Unmap some Chip Ram banks from time to time
+        int banks = randomInt(3) ? chipSize >> 16 : randomInt((chipSize >> 16) + 1);
+        for (int j = 0; j < 256; j++) {
+            mem.agnusMemSrc[j] = j < banks ? memSrc[j] : MEM_NONE;
+        }
+
+        // Modify some memory cells
+        for (int j = 0; j < 64; j++) {
+            u32 value = rng();
+            memcpy(mem.chip + randomInt(chipSize - 4), &value, 4);
+        }
+
+        setupRandom(b, mem);
+
+        Registers saved(b);
+        u16 dataBus = mem.dataBus;
+        memcpy(ram.data(), mem.chip, chipSize);
+
+        // Run the reference implementation
+        referenceLineBlit(b);
+        Result expected(b, mem);
+        std::swap_ranges(ram.begin(), ram.end(), mem.chip);
+
+        // Run the FastBlitter on the same input
+        saved.restore(b);
+        mem.dataBus = dataBus;
+        b.doFastLineBlit();
+        Result result(b, mem);
+
+        if (!(result == expected) || memcmp(ram.data(), mem.chip, chipSize)) {
+            printf("Blit %d differs (BLTCON0 = %04X BLTCON1 = %04X BLTSIZV = %d)\n",
+                   i, saved.bltcon0, saved.bltcon1, saved.bltsizeV);
+            memcpy(mem.agnusMemSrc, memSrc, sizeof(memSrc));
+            return false;
+        }
+    }
+
+    memcpy(mem.agnusMemSrc, memSrc, sizeof(memSrc));
+    printf("Line blit equivalence: %d random blits match\n", blitCount);
+    return true;
+}
+
+struct Line { int x1, y1, x2, y2; };
+
+// Draws a scene with both implementations and compares the elapsed time
+static bool
+drawScene(Blitter &b, Memory &mem, const char *name,
+          int count, int maxLength, bool sing)
+{
+    u32 chipSize = (u32)mem.chipRamSize();
+    std::vector<Line> lines;
+    std::vector<u8> ram[2];
+    double elapsed[2];
+
+    for (int i = 0; i < count; i++) {
+
+        Line l;
+        l.x1 = randomInt(320);
+        l.y1 = randomInt(256);
+        l.x2 = MAX(0, MIN(319, l.x1 + (int)randomInt(2 * maxLength + 1) - maxLength));
+        l.y2 = MAX(0, MIN(255, l.y1 + (int)randomInt(2 * maxLength + 1) - maxLength));
+        lines.push_back(l);
+    }
+
+    for (int v = 0; v < 2; v++) {
+
+        memset(mem.chip, 0, chipSize);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int p = 0; p < passes; p++) {
+
+            u32 screen = 0x20000 + 10240 * (p & 3);
+
+            for (const Line &l : lines) {
+
+                setupLine(b, screen, l.x1, l.y1, l.x2, l.y2,
+                          sing, sing ? 0x4A : 0xCA);
+                if (v == 0) referenceLineBlit(b); else b.doFastLineBlit();
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        elapsed[v] = std::chrono::duration<double>(end - start).count() * 1000;
+        ram[v].assign(mem.chip, mem.chip + chipSize);
+    }
+
+    bool identical = ram[0] == ram[1];
+    printf("%-28s %7.1f ms -> %7.1f ms (%.2fx) %s\n",
+           name, elapsed[0], elapsed[1], elapsed[0] / elapsed[1],
+           identical ? "" : "MEMORY DIFFERS");
+
+    return identical;
+}
+
+int main()
+{
+    Amiga *amiga = new Amiga();
+    amiga->configure(OPT_CHIP_RAM, 512);
+
+    Blitter &blitter = amiga->agnus.blitter;
+    Memory &mem = amiga->mem;
+    bool success = checkEquivalence(blitter, mem);
+
+    success &= drawScene(blitter, mem, "3D wireframe (length <= 40):", 20000, 40, false);
+    success &= drawScene(blitter, mem, "Vector fill edges (SING):", 20000, 60, true);
+    success &= drawScene(blitter, mem, "Long lines (length <= 320):", 5000, 320, false);
+
+    delete amiga;
+    return success ? 0 : 1;
+}
@@ -0,0 +1,259 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+/* Benchmarks the sprite collision checks of Denise.
+ *
+ * The benchmark prepares a set of sprite-heavy rasterlines with randomized
+ * playfield data, eight sprites per line, and a random value in CLXCON. For
+ * each line, checkS2SCollisions() and checkS2PCollisions() are run for all
+ * sprites and the resulting CLXDAT value is compared with the value computed
+ * by a reference implementation. The reference walks the zBuffer pixel by
+ * pixel, which is how the collision checks worked before the packed
+ * collision masks were introduced. The benchmark fails if a single line
+ * differs.
+ */
+
+// The benchmark sets up the internal pixel buffers of Denise directly
+#define private public
+#include "Amiga.h"
+#undef private
+
+#include <chrono>
+#include <random>
+
+// Number of different rasterlines
+static const int lineCount = 64;
+
+// Number of times each line is checked in a timing run
+static const int repeat = 64;
+
+// Number of timing runs (the fastest run is reported)
+static const int runs = 5;
+
+struct Line {
+    
+    u8 bBuffer[sizeof(Denise::bBuffer)];
+    u16 zBuffer[sizeof(Denise::zBuffer) / sizeof(u16)];
+    u64 sprMask[8][Denise::clxWords];
+    int start[8];
+    u16 clxcon;
+};
+
+static Line lines[lineCount];
+
+
+//
+// Reference implementation
+//
+
+static void
+referenceS2S(Denise &d, int x, int start, int end)
+{
+    if (IS_ODD(x) && !GET_BIT(d.clxcon, 12 + (x/2))) return;
+
+    u16 comp01 = Denise::Z_SP0 | (GET_BIT(d.clxcon, 12) ? Denise::Z_SP1 : 0);
+    u16 comp23 = Denise::Z_SP2 | (GET_BIT(d.clxcon, 13) ? Denise::Z_SP3 : 0);
+    u16 comp45 = Denise::Z_SP4 | (GET_BIT(d.clxcon, 14) ? Denise::Z_SP5 : 0);
+    u16 comp67 = Denise::Z_SP6 | (GET_BIT(d.clxcon, 15) ? Denise::Z_SP7 : 0);
+
+    for (int pos = end; pos >= start; pos -= 2) {
+
+        u16 z = d.zBuffer[pos];
+
+        if (!(z & (Denise::Z_SP01234567 ^ Denise::Z_SP[x]))) continue;
+        if (!(z & Denise::Z_SP[x])) continue;
+
+        if ((z & comp45) && (z & comp67)) SET_BIT(d.clxdat, 14);
+        if ((z & comp23) && (z & comp67)) SET_BIT(d.clxdat, 13);
+        if ((z & comp23) && (z & comp45)) SET_BIT(d.clxdat, 12);
+        if ((z & comp01) && (z & comp67)) SET_BIT(d.clxdat, 11);
+        if ((z & comp01) && (z & comp45)) SET_BIT(d.clxdat, 10);
+        if ((z & comp01) && (z & comp23)) SET_BIT(d.clxdat, 9);
+    }
+}
+
+static void
+referenceS2P(Denise &d, int x, int start, int end)
+{
+    if (IS_ODD(x) && !GET_BIT(d.clxcon, 12 + (x/2))) return;
+
+    u8 enabled1 = d.getENBP1();
+    u8 enabled2 = d.getENBP2();
+    u8 compare1 = d.getMVBP1() & enabled1;
+    u8 compare2 = d.getMVBP2() & enabled2;
+
+    for (int pos = end; pos >= start; pos -= 2) {
+
+        u16 z = d.zBuffer[pos];
+
+        if (!(z & Denise::Z_SP[x])) continue;
+
+        if ((d.bBuffer[pos] & enabled2) == compare2) {
+            SET_BIT(d.clxdat, 5 + (x / 2));
+        } else {
+            if (!(z & Denise::Z_DPF)) continue;
+        }
+        if ((d.bBuffer[pos] & enabled1) == compare1) {
+            SET_BIT(d.clxdat, 1 + (x / 2));
+        }
+    }
+}
+
+
+//
+// Test driver
+//
+
+typedef void (Denise::*CheckFunc)(int, int);
+
+static const CheckFunc checkS2S[8] = {
+    &Denise::checkS2SCollisions<0>, &Denise::checkS2SCollisions<1>,
+    &Denise::checkS2SCollisions<2>, &Denise::checkS2SCollisions<3>,
+    &Denise::checkS2SCollisions<4>, &Denise::checkS2SCollisions<5>,
+    &Denise::checkS2SCollisions<6>, &Denise::checkS2SCollisions<7>
+};
+
+static const CheckFunc checkS2P[8] = {
+    &Denise::checkS2PCollisions<0>, &Denise::checkS2PCollisions<1>,
+    &Denise::checkS2PCollisions<2>, &Denise::checkS2PCollisions<3>,
+    &Denise::checkS2PCollisions<4>, &Denise::checkS2PCollisions<5>,
+    &Denise::checkS2PCollisions<6>, &Denise::checkS2PCollisions<7>
+};
+
+static void
+generateLines()
+{
+    std::mt19937 rng(1);
+
+    for (Line &l : lines) {
+
+        // Random playfield data with random dual-playfield bits
+        for (size_t i = 0; i < sizeof(l.bBuffer); i++) {
+            l.bBuffer[i] = rng() & 0x3F;
+            l.zBuffer[i] = (rng() % 6) | ((rng() & 1) ? Denise::Z_0 : Denise::Z_1);
+        }
+        l.clxcon = (u16)rng();
+
+        // Eight sprites, placed in the same area to make them collide
+        memset(l.sprMask, 0, sizeof(l.sprMask));
+        int area = 2 * (rng() % 200);
+        for (int x = 0; x < 8; x++) {
+
+            l.start[x] = area + 2 * (rng() % 48);
+            u32 data = (u32)rng();
+
+            for (int p = 0; p < 32; p++) {
+
+                if (!(data & (1 << (p / 2)))) continue;
+
+                int pos = l.start[x] + p;
+                l.zBuffer[pos] |= Denise::Z_SP[x];
+                l.sprMask[x][pos >> 6] |= 1ULL << (pos & 63);
+            }
+        }
+    }
+}
+
+static void
+load(Denise &denise, const Line &l)
+{
+    memcpy(denise.bBuffer, l.bBuffer, sizeof(l.bBuffer));
+    memcpy(denise.zBuffer, l.zBuffer, sizeof(l.zBuffer));
+    memcpy(denise.sprMask, l.sprMask, sizeof(l.sprMask));
+    denise.clxcon = l.clxcon;
+    denise.clxdat = 0;
+}
+
+static void
+runReference(Denise &denise, const Line &l, bool playfield)
+{
+    for (int x = 7; x >= 0; x--) {
+        referenceS2S(denise, x, l.start[x], l.start[x] + 31);
+        if (playfield) referenceS2P(denise, x, l.start[x], l.start[x] + 31);
+    }
+}
+
+static void
+runDenise(Denise &denise, const Line &l, bool playfield)
+{
+    for (int x = 7; x >= 0; x--) {
+        (denise.*checkS2S[x])(l.start[x], l.start[x] + 31);
+        if (playfield) (denise.*checkS2P[x])(l.start[x], l.start[x] + 31);
+    }
+}
+
+// Returns the time needed to check a single line in nanoseconds
+static double
+measure(Denise &denise, bool playfield,
+        void (*run)(Denise &, const Line &, bool))
+{
+    double best = 0;
+    
+    for (int r = 0; r < runs; r++) {
+        
+        double elapsed = 0;
+        
+        for (const Line &l : lines) {
+            
+            load(denise, l);
+            
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < repeat; i++) run(denise, l, playfield);
+            auto end = std::chrono::steady_clock::now();
+            
+            elapsed += std::chrono::duration<double>(end - start).count();
+        }
+        
+        if (r == 0 || elapsed < best) best = elapsed;
+    }
+    
+    return best / (lineCount * repeat) * 1e9;
+}
+
+int main()
+{
+    Amiga *amiga = new Amiga();
+    Denise &denise = amiga->denise;
+    int mismatches = 0;
+    
+    generateLines();
+    
+    // Compare the computed collision bits with the reference implementation
+    for (int i = 0; i < lineCount; i++) {
+        
+        load(denise, lines[i]);
+        runReference(denise, lines[i], true);
+        u16 expected = denise.clxdat;
+        
+        load(denise, lines[i]);
+        runDenise(denise, lines[i], true);
+        
+        if (denise.clxdat != expected) {
+            printf("Line %d: CLXDAT is %04X (expected %04X)\n",
+                   i, denise.clxdat, expected);
+            mismatches++;
+        }
+    }
+    printf("CLXDAT equivalence: %d of %d lines match\n",
+           lineCount - mismatches, lineCount);
+    
+    // Measure the time needed to check all eight sprites of a line
+    for (int playfield = 0; playfield < 2; playfield++) {
+        
+        double reference = measure(denise, playfield, runReference);
+        double current = measure(denise, playfield, runDenise);
+        
+        printf("%-28s %7.1f ns -> %7.1f ns per line (%.2fx)\n",
+               playfield ? "Sprite-sprite + playfield:" : "Sprite-sprite:",
+               reference, current, reference / current);
+    }
+    
+    delete amiga;
+    return mismatches ? 1 : 0;
+}
@@ -17,7 +17,8 @@ Agnus::Agnus(Amiga& ref) : AmigaComponent(ref)
         
         &copper,
         &blitter,
-        &dmaDebugger
+        &dmaDebugger,
+        &dmaProfiler
     };
     
     config.revision = AGNUS_ECS_1MB;
@@ -974,7 +975,7 @@ Agnus::hsyncHandler()
     for (int i = 0; i < HPOS_CNT; i++) busOwner[i] = BUS_NONE;
 
     // Schedule the first BPL and DAS events
-    scheduleNextBplEvent();
+    if (!deferBplEvents(pos.h)) scheduleNextBplEvent();
     scheduleNextDasEvent();
 
 
@@ -1013,6 +1014,9 @@ Agnus::vsyncHandler()
     // Update statistics
     updateStats();
     mem.updateStats();
+
+    // Finish the profiled frame
+    dmaProfiler.vsyncHandler();
     
     // Count some sheep (zzzzzz) ...
     if (!amiga.inWarpMode()) {
@@ -16,6 +16,7 @@
 #include "Copper.h"
 #include "DDF.h"
 #include "DmaDebugger.h"
+#include "DmaProfiler.h"
 #include "Event.h"
 #include "Frame.h"
 #include "HardwareComponent.h"
@@ -66,6 +67,7 @@ public:
     Copper copper = Copper(amiga);
     Blitter blitter = Blitter(amiga);
     DmaDebugger dmaDebugger = DmaDebugger(amiga);
+    DmaProfiler dmaProfiler = DmaProfiler(amiga);
 
     
     //
@@ -98,6 +100,64 @@ private:
     // Jump tables connecting the scheduled events
     u8 nextBplEvent[HPOS_CNT];
     u8 nextDasEvent[HPOS_CNT];
+
+    // Everything a freshly built bplEvent table depends on
+    struct BplTableKey {
+
+        i16 strtOdd;
+        i16 strtEven;
+        i16 stopOdd;
+        i16 stopEven;
+        i8 scrollOdd;
+        i8 scrollEven;
+        u8 hires;
+        u8 channels;
+        u8 lastJump;
+
+        bool operator==(const BplTableKey &k) const {
+            return
+            strtOdd == k.strtOdd &&
+            strtEven == k.strtEven &&
+            stopOdd == k.stopOdd &&
+            stopEven == k.stopEven &&
+            scrollOdd == k.scrollOdd &&
+            scrollEven == k.scrollEven &&
+            hires == k.hires &&
+            channels == k.channels &&
+            lastJump == k.lastJump;
+        }
+    };
+
+    // A bplEvent table and its jump table as built by updateBplEvents()
+    struct BplTable {
+
+        BplTableKey key;
+        EventID event[HPOS_CNT];
+        u8 next[HPOS_CNT];
+        u64 used = 0;
+    };
+
+    // Recently built bplEvent tables (least recently used entry is replaced)
+    static const int bplCacheSize = 8;
+    BplTable bplCache[bplCacheSize];
+    int bplCacheFill = 0;
+    u64 bplCacheClock = 0;
+
+    /* Bitplane events are serviced in batches. After a BPL event has been
+     * processed, all remaining events of the rasterline are deferred and
+     * the BPL slot is scheduled for the end of the line. The bus is claimed
+     * for all deferred fetches right away. The deferred events are processed
+     * in a single run once the line ends or something happens that could
+     * observe the difference, e.g., a custom register access, the start of a
+     * blit, or a write into the Chip Ram region read by the deferred fetches.
+     */
+
+    // First deferred BPL event (0 = no events are deferred)
+    i16 bplDeferred;
+
+    // Chip Ram region read by the deferred BPL events
+    u32 bplGuardStart;
+    u32 bplGuardSize;
     
 
     //
@@ -497,6 +557,9 @@ private:
         & dasEvent
         & nextBplEvent
         & nextDasEvent
+        & bplDeferred
+        & bplGuardStart
+        & bplGuardSize
 
         & hsyncActions
         & changeRecorder
@@ -766,6 +829,19 @@ public:
     void updateBplEvents(int first = 0, int last = HPOS_MAX) {
         updateBplEvents(dmacon, bplcon0, first, last); }
     void updateDrawingFlags(bool hires);
+
+private:
+
+    // Looks up a previously built bplEvent table
+    BplTable *lookupBplTable(const BplTableKey &key);
+
+    // Stores the current bplEvent table in the cache
+    void cacheBplTable(const BplTableKey &key);
+
+    // Installs a cached table starting at position 'first'
+    void applyBplTable(const BplTable &table, int first);
+
+public:
         
     // Removes all events from the DAS event table
     void clearDasEvents();
@@ -792,6 +868,40 @@ public:
     void dumpDasEventTable(int from, int to);
     void dumpDasEventTable();
 
+
+    //
+    // Deferring bitplane DMA
+    //
+
+public:
+
+    /* Services all deferred BPL events up to the current DMA cycle. In CPU
+     * context, the event in the current cycle hasn't been reached yet. In
+     * Agnus context (Copper, Blitter, disk DMA), it has already been served.
+     */
+    template <Accessor s> void syncBplEvents() {
+        if (bplDeferred) serviceDeferredBplEvents(s == CPU_ACCESS ? pos.h : pos.h + 1);
+    }
+
+    // Informs Agnus about a write into Chip Ram
+    template <Accessor s> void syncBplEvents(u32 offset) {
+        if ((u32)(offset - bplGuardStart) < bplGuardSize) syncBplEvents<s>();
+    }
+
+private:
+
+    // Defers all BPL events following the given DMA cycle
+    bool deferBplEvents(i16 hpos);
+
+    // Services all deferred BPL events in front of the given DMA cycle
+    void serviceDeferredBplEvents(i16 until);
+
+    // Discards all deferred BPL events and releases the claimed bus cycles
+    void cancelDeferredBplEvents();
+
+    // Recomputes the Chip Ram region read by the deferred BPL events
+    bool updateBplGuard();
+
     
     //
     // Accessing registers
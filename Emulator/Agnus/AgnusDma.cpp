@@ -255,7 +255,11 @@ template <BusOwner owner> bool
 Agnus::busIsFree()
 {
     // Deny if the bus is already in use
-    if (busOwner[pos.h] != BUS_NONE) return false;
+    if (busOwner[pos.h] != BUS_NONE) {
+
+        if (owner == BUS_COPPER && copdma()) dmaProfiler.copperIsBlocked();
+        return false;
+    }
 
     switch (owner) {
 
@@ -381,7 +385,16 @@ Agnus::doSpriteDMA()
 u16
 Agnus::doCopperDMA(u32 addr)
 {
-    u16 result = mem.peek16 <AGNUS_ACCESS> (addr);
+    u16 result;
+
+    syncBplEvents<AGNUS_ACCESS>();
+
+    // Take the word from a compiled Copper list if possible
+    if (copper.lookup(addr, result)) {
+        mem.dataBus = result;
+    } else {
+        result = mem.peek16 <AGNUS_ACCESS> (addr);
+    }
 
     assert(pos.h < HPOS_CNT);
     busOwner[pos.h] = BUS_COPPER;
@@ -397,6 +410,7 @@ Agnus::doBlitterDMA(u32 addr)
     // Assure that the Blitter owns the bus when this function is called
     assert(busOwner[pos.h] == BUS_BLITTER);
 
+    syncBplEvents<AGNUS_ACCESS>();
     u16 result = mem.peek16 <AGNUS_ACCESS> (addr);
 
     assert(pos.h < HPOS_CNT);
@@ -433,6 +447,7 @@ Agnus::doCopperDMA(u32 addr, u16 value)
 void
 Agnus::doBlitterDMA(u32 addr, u16 value)
 {
+    syncBplEvents<AGNUS_ACCESS>();
     mem.poke16 <AGNUS_ACCESS> (addr, value);
     
     assert(pos.h < HPOS_CNT);
@@ -462,6 +477,25 @@ Agnus::updateBplEvents(u16 dmacon, u16 bplcon0, int first, int last)
 
     // Do the same if DDFSTRT is never reached in this line
     if (ddfstrtReached == -1) channels = 0;
+
+    // Check if the same table has been built before
+    BplTableKey key;
+    key.strtOdd = hires ? ddfHires.strtOdd : ddfLores.strtOdd;
+    key.strtEven = hires ? ddfHires.strtEven : ddfLores.strtEven;
+    key.stopOdd = hires ? ddfHires.stopOdd : ddfLores.stopOdd;
+    key.stopEven = hires ? ddfHires.stopEven : ddfLores.stopEven;
+    key.scrollOdd = hires ? scrollHiresOdd : scrollLoresOdd;
+    key.scrollEven = hires ? scrollHiresEven : scrollLoresEven;
+    key.hires = hires;
+    key.channels = channels;
+    key.lastJump = nextBplEvent[HPOS_MAX];
+
+    if (last == HPOS_MAX) {
+        if (BplTable *table = lookupBplTable(key)) {
+            applyBplTable(*table, first);
+            return;
+        }
+    }
     
     // Allocate slots
     if (hires) {
@@ -498,6 +532,82 @@ Agnus::updateBplEvents(u16 dmacon, u16 bplcon0, int first, int last)
 
     // Update the drawing flags and update the jump table
     updateDrawingFlags(hires);
+
+    // Remember the table if it has been built from scratch
+    if (first == 0 && last == HPOS_MAX) cacheBplTable(key);
+}
+
+Agnus::BplTable *
+Agnus::lookupBplTable(const BplTableKey &key)
+{
+    for (int i = 0; i < bplCacheFill; i++) {
+
+        if (bplCache[i].key == key) {
+
+            bplCache[i].used = ++bplCacheClock;
+            return &bplCache[i];
+        }
+    }
+    return NULL;
+}
+
+void
+Agnus::cacheBplTable(const BplTableKey &key)
+{
+    int slot = bplCacheFill;
+
+    // Replace the least recently used table if the cache is full
+    if (slot == bplCacheSize) {
+
+        slot = 0;
+        for (int i = 1; i < bplCacheSize; i++) {
+            if (bplCache[i].used < bplCache[slot].used) slot = i;
+        }
+    } else {
+
+        bplCacheFill++;
+    }
+
+    BplTable &table = bplCache[slot];
+    table.key = key;
+    table.used = ++bplCacheClock;
+    memcpy(table.event, bplEvent, sizeof(bplEvent));
+    memcpy(table.next, nextBplEvent, sizeof(nextBplEvent));
+}
+
+void
+Agnus::applyBplTable(const BplTable &table, int first)
+{
+    const BplTableKey &key = table.key;
+
+    // Starting at 'first', both tables match the cached ones
+    memcpy(bplEvent + first, table.event + first, (HPOS_CNT - first) * sizeof(EventID));
+    memcpy(nextBplEvent + first, table.next + first, HPOS_CNT - first);
+
+    if (first == 0) return;
+
+    /* The events in front of 'first' are kept. Like in updateBplEvents(),
+     * shift register events and drawing flags are added to them.
+     */
+    int sr = key.hires ? 3 : 7;
+    int step = key.hires ? 4 : 8;
+
+    for (int i = key.strtEven; i < MIN(key.strtOdd, first); i++)
+        if ((i & sr) == sr && bplEvent[i] == EVENT_NONE) bplEvent[i] = BPL_SR;
+    for (int i = key.stopOdd; i < MIN(key.stopEven, first); i++)
+        if ((i & sr) == sr && bplEvent[i] == EVENT_NONE) bplEvent[i] = BPL_SR;
+
+    for (int i = key.scrollOdd; i < first; i += step)
+        bplEvent[i] = (EventID)(bplEvent[i] | 1);
+    for (int i = key.scrollEven; i < first; i += step)
+        bplEvent[i] = (EventID)(bplEvent[i] | 2);
+
+    // Connect the kept events with the cached part of the jump table
+    u8 next = bplEvent[first] ? first : nextBplEvent[first];
+    for (int i = first - 1; i >= 0; i--) {
+        nextBplEvent[i] = next;
+        if (bplEvent[i]) next = i;
+    }
 }
 
 void
@@ -564,6 +674,79 @@ Agnus::updateDasJumpTable(i16 end)
     }
 }
 
+bool
+Agnus::deferBplEvents(i16 hpos)
+{
+    if (NO_BPL_BATCHING) return false;
+
+    // Check if there is anything to defer
+    i16 first = nextBplEvent[hpos];
+    if (first == 0 || first >= HPOS_MAX) return false;
+
+    // Only defer fetches from Chip Ram
+    bplDeferred = first;
+    if (!updateBplGuard()) {
+        bplDeferred = 0;
+        return false;
+    }
+
+    // Claim the bus for all deferred fetches
+    for (i16 i = first; i < HPOS_MAX; i = nextBplEvent[i]) {
+        if (int x = bplxEventNr(bplEvent[i])) busOwner[i] = BusOwner(BUS_BPL1 + x - 1);
+    }
+
+    // Wake up at the end of the line
+    scheduleRel<BPL_SLOT>(DMA_CYCLES(HPOS_MAX - pos.h), bplEvent[HPOS_MAX]);
+    return true;
+}
+
+void
+Agnus::cancelDeferredBplEvents()
+{
+    assert(bplDeferred >= pos.h);
+
+    // Release the bus cycles claimed in deferBplEvents()
+    for (i16 i = bplDeferred; i < HPOS_MAX; i++) {
+        if (busOwner[i] >= BUS_BPL1 && busOwner[i] <= BUS_BPL6) busOwner[i] = BUS_NONE;
+    }
+
+    bplDeferred = 0;
+    bplGuardSize = 0;
+}
+
+bool
+Agnus::updateBplGuard()
+{
+    u32 pt[6];
+    for (int i = 0; i < 6; i++) pt[i] = bplpt[i];
+
+    u32 lo = UINT32_MAX, hi = 0;
+
+    // Replay the pointer arithmetic of all deferred fetches
+    for (i16 i = bplDeferred; i < HPOS_MAX; i = nextBplEvent[i]) {
+
+        EventID id = bplEvent[i];
+        int nr = bplxEventNr(id) - 1;
+        if (nr < 0) continue;
+
+        u32 addr = pt[nr] & ptrMask;
+        if (mem.getMemSrc<AGNUS_ACCESS>(addr) != MEM_CHIP) return false;
+
+        lo = MIN(lo, addr & mem.chipMask);
+        hi = MAX(hi, addr & mem.chipMask);
+        pt[nr] += 2;
+
+        // Add modulo if this is the last fetch unit
+        if (isHiresBplEvent(id) ? i >= ddfHires.stopOdd - 4 : i >= ddfLores.stopOdd - 8) {
+            pt[nr] += (nr % 2) ? bpl2mod : bpl1mod;
+        }
+    }
+
+    bplGuardStart = lo;
+    bplGuardSize = lo <= hi ? hi + 2 - lo : 0;
+    return true;
+}
+
 void
 Agnus::dumpEventTable(EventID *table, char str[256][3], int from, int to)
 {
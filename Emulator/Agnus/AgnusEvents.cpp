@@ -80,6 +80,9 @@ Agnus::serviceREGEvent(Cycle until)
 {
     assert(pos.h <= HPOS_MAX);
 
+    // Catch up with the bitplane DMA
+    if (bplDeferred) serviceDeferredBplEvents(pos.h);
+
     // Iterate through all recorded register changes
     while (!changeRecorder.isEmpty()) {
 
@@ -144,6 +147,17 @@ Agnus::serviceREGEvent(Cycle until)
                 warn("Register change ID %d is invalid.\n", change.addr);
                 assert(false);
         }
+
+        // Check if the deferred fetches can still be serviced in a batch
+        if (bplDeferred && change.addr >= SET_BPL1MOD && change.addr <= SET_BPL6PTL) {
+
+            if (!updateBplGuard()) {
+
+                i16 first = bplDeferred;
+                cancelDeferredBplEvents();
+                scheduleBplEventForCycle(first);
+            }
+        }
     }
 
     // Schedule next event
@@ -153,7 +167,19 @@ Agnus::serviceREGEvent(Cycle until)
 void
 Agnus::serviceBPLEvent()
 {
-    switch ((int)slot[BPL_SLOT].id) {
+    // Service all deferred events first (if any)
+    if (bplDeferred) serviceDeferredBplEvents(pos.h);
+
+    serviceBPLEvent(slot[BPL_SLOT].id);
+
+    // Schedule next event (the BPL_EOL event concludes the line)
+    if (pos.h != HPOS_MAX && !deferBplEvents(pos.h)) scheduleNextBplEvent();
+}
+
+void
+Agnus::serviceBPLEvent(EventID id)
+{
+    switch ((int)id) {
 
         case EVENT_NONE | DRAW_ODD:
             hires() ? denise.drawHiresOdd() : denise.drawLoresOdd();
@@ -378,30 +404,74 @@ Agnus::serviceBPLEvent()
             
         case BPL_EOL:
             assert(pos.h == 0xE2);
-            return;
+            break;
 
         case BPL_EOL | DRAW_ODD:
             assert(pos.h == 0xE2);
             hires() ? denise.drawHiresOdd() : denise.drawLoresOdd();
-            return;
+            break;
 
         case BPL_EOL | DRAW_EVEN:
             assert(pos.h == 0xE2);
             hires() ? denise.drawHiresEven() : denise.drawLoresEven();
-            return;
+            break;
 
         case BPL_EOL | DRAW_ODD | DRAW_EVEN:
             assert(pos.h == 0xE2);
             hires() ? denise.drawHiresBoth() : denise.drawLoresBoth();
-            return;
+            break;
             
         default:
             dumpEvents();
             assert(false);
     }
+}
 
-    // Schedule next event
-    scheduleNextBplEvent();
+void
+Agnus::serviceDeferredBplEvents(i16 until)
+{
+    assert(bplDeferred > 0 && bplDeferred < HPOS_MAX);
+    assert(until <= HPOS_CNT);
+
+    i16 posh = pos.h;
+    u16 bus = mem.dataBus;
+    i16 last = -1;
+
+    // Service all due events in the DMA cycles they belong to
+    while (bplDeferred < until) {
+
+        pos.h = bplDeferred;
+
+        EventID id = bplEvent[pos.h];
+        serviceBPLEvent(id);
+        if (bplxEventNr(id)) last = pos.h;
+
+        bplDeferred = nextBplEvent[pos.h];
+        if (bplDeferred >= HPOS_MAX) {
+
+            // The BPL_EOL event is already scheduled
+            bplDeferred = 0;
+            bplGuardSize = 0;
+            break;
+        }
+    }
+    pos.h = posh;
+
+    /* The fetches have overwritten the data bus. Restore the old value if
+     * the CPU or another DMA channel has used the bus after the last fetch.
+     * The Copper and the Blitter are skipped. Both catch up with bitplane DMA
+     * before they transfer data, so they can't have used the bus in between.
+     */
+    if (last >= 0) {
+        for (i16 i = last + 1; i < until; i++) {
+            BusOwner owner = busOwner[i];
+            if (owner != BUS_NONE && owner != BUS_REFRESH &&
+                owner != BUS_COPPER && owner != BUS_BLITTER) {
+                mem.dataBus = bus;
+                break;
+            }
+        }
+    }
 }
 
 template <int nr> void
@@ -250,7 +250,10 @@ Agnus::peekDMACONR()
     u16 result = dmacon;
     
     assert((result & ((1 << 14) | (1 << 13))) == 0);
-    
+
+    // The zero flag of a concurrent blit is known after it has been joined
+    blitter.joinBlit();
+
     if (blitter.isBusy()) result |= (1 << 14);
     if (blitter.isZero()) result |= (1 << 13);
     
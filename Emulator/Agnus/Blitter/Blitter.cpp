@@ -8,10 +8,13 @@
 // -----------------------------------------------------------------------------
 
 #include "Amiga.h"
+#include "SSEUtils.h"
 
 Blitter::Blitter(Amiga& ref) : AmigaComponent(ref)
 {
     setDescription("Blitter");
+
+    config.helperThread = false;
     
     // Initialize fill pattern lookup tables
     
@@ -38,6 +41,15 @@ Blitter::Blitter(Amiga& ref) : AmigaComponent(ref)
     }
 }
 
+Blitter::~Blitter()
+{
+    if (helper.joinable()) {
+
+        joinBlit();
+        stopHelperThread();
+    }
+}
+
 void
 Blitter::_initialize()
 {    
@@ -48,6 +60,8 @@ Blitter::_initialize()
 void
 Blitter::_reset(bool hard)
 {
+    joinBlit();
+
     RESET_SNAPSHOT_ITEMS(hard)
 
     if (hard) {
@@ -56,12 +70,19 @@ Blitter::_reset(bool hard)
     }
 }
 
+void
+Blitter::_pause()
+{
+    joinBlit();
+}
+
 long
 Blitter::getConfigItem(ConfigOption option)
 {
     switch (option) {
             
         case OPT_BLITTER_ACCURACY: return config.accuracy;
+        case OPT_BLITTER_THREAD:   return config.helperThread;
         default: assert(false);
     }
 }
@@ -91,6 +112,16 @@ Blitter::setConfigItem(ConfigOption option, long value)
             amiga.resume();
 
             return true;
+
+        case OPT_BLITTER_THREAD:
+
+            if (config.helperThread == value) {
+                return false;
+            }
+
+            config.helperThread = value;
+            setHelperThread(value);
+            return true;
             
         default:
             return false;
@@ -100,6 +131,9 @@ Blitter::setConfigItem(ConfigOption option, long value)
 void
 Blitter::_inspect()
 {
+    // The helper thread may still be updating the pointer and hold registers
+    joinBlit();
+
     synchronized {
         
         info.bltcon0 = bltcon0;
@@ -140,6 +174,7 @@ void
 Blitter::_dump()
 {
     msg("  Accuracy: %d\n", config.accuracy);
+    msg("    Thread: %s\n", config.helperThread ? "yes" : "no");
     msg("\n");
     msg("   bltcon0: %X\n", bltcon0);
     msg("\n");
@@ -201,264 +236,7 @@ Blitter::doMintermLogic(u16 a, u16 b, u16 c, u8 minterm)
 u16
 Blitter::doMintermLogicQuick(u16 a, u16 b, u16 c, u8 minterm)
 {
-    switch (minterm) {
-        case 0: return 0;
-        case 1: return (~c & ~b & ~a);
-        case 2: return (c & ~b & ~a);
-        case 3: return (~b & ~a);
-        case 4: return (~c & b & ~a);
-        case 5: return (~c & ~a);
-        case 6: return (c & ~b & ~a) | (~c & b & ~a);
-        case 7: return (~b & ~a) | (~c & ~a);
-        case 8: return (c & b & ~a);
-        case 9: return (~c & ~b & ~a) | (c & b & ~a);
-        case 10: return (c & ~a);
-        case 11: return (~b & ~a) | (c & ~a);
-        case 12: return (b & ~a);
-        case 13: return (~c & ~a) | (b & ~a);
-        case 14: return (c & ~a) | (b & ~a);
-        case 15: return (~a);
-        case 16: return (~c & ~b & a);
-        case 17: return (~c & ~b);
-        case 18: return (c & ~b & ~a) | (~c & ~b & a);
-        case 19: return (~b & ~a) | (~c & ~b);
-        case 20: return (~c & b & ~a) | (~c & ~b & a);
-        case 21: return (~c & ~a) | (~c & ~b);
-        case 22: return (c & ~b & ~a) | (~c & b & ~a) | (~c & ~b & a);
-        case 23: return (~b & ~a) | (~c & ~a) | (~c & ~b);
-        case 24: return (c & b & ~a) | (~c & ~b & a);
-        case 25: return (~c & ~b) | (c & b & ~a);
-        case 26: return (c & ~a) | (~c & ~b & a);
-        case 27: return (~b & ~a) | (c & ~a) | (~c & ~b);
-        case 28: return (b & ~a) | (~c & ~b & a);
-        case 29: return (~c & ~a) | (b & ~a) | (~c & ~b);
-        case 30: return (c & ~a) | (b & ~a) | (~c & ~b & a);
-        case 31: return (~a) | (~c & ~b);
-        case 32: return (c & ~b & a);
-        case 33: return (~c & ~b & ~a) | (c & ~b & a);
-        case 34: return (c & ~b);
-        case 35: return (~b & ~a) | (c & ~b);
-        case 36: return (~c & b & ~a) | (c & ~b & a);
-        case 37: return (~c & ~a) | (c & ~b & a);
-        case 38: return (c & ~b) | (~c & b & ~a);
-        case 39: return (~b & ~a) | (~c & ~a) | (c & ~b);
-        case 40: return (c & b & ~a) | (c & ~b & a);
-        case 41: return (~c & ~b & ~a) | (c & b & ~a) | (c & ~b & a);
-        case 42: return (c & ~a) | (c & ~b);
-        case 43: return (~b & ~a) | (c & ~a) | (c & ~b);
-        case 44: return (b & ~a) | (c & ~b & a);
-        case 45: return (~c & ~a) | (b & ~a) | (c & ~b & a);
-        case 46: return (c & ~a) | (b & ~a) | (c & ~b);
-        case 47: return (~a) | (c & ~b);
-        case 48: return (~b & a);
-        case 49: return (~c & ~b) | (~b & a);
-        case 50: return (c & ~b) | (~b & a);
-        case 51: return (~b);
-        case 52: return (~c & b & ~a) | (~b & a);
-        case 53: return (~c & ~a) | (~b & a);
-        case 54: return (c & ~b) | (~c & b & ~a) | (~b & a);
-        case 55: return (~b) | (~c & ~a);
-        case 56: return (c & b & ~a) | (~b & a);
-        case 57: return (~c & ~b) | (c & b & ~a) | (~b & a);
-        case 58: return (c & ~a) | (~b & a);
-        case 59: return (~b) | (c & ~a);
-        case 60: return (b & ~a) | (~b & a);
-        case 61: return (~c & ~a) | (b & ~a) | (~b & a);
-        case 62: return (c & ~a) | (b & ~a) | (~b & a);
-        case 63: return (~a) | (~b);
-        case 64: return (~c & b & a);
-        case 65: return (~c & ~b & ~a) | (~c & b & a);
-        case 66: return (c & ~b & ~a) | (~c & b & a);
-        case 67: return (~b & ~a) | (~c & b & a);
-        case 68: return (~c & b);
-        case 69: return (~c & ~a) | (~c & b);
-        case 70: return (c & ~b & ~a) | (~c & b);
-        case 71: return (~b & ~a) | (~c & ~a) | (~c & b);
-        case 72: return (c & b & ~a) | (~c & b & a);
-        case 73: return (~c & ~b & ~a) | (c & b & ~a) | (~c & b & a);
-        case 74: return (c & ~a) | (~c & b & a);
-        case 75: return (~b & ~a) | (c & ~a) | (~c & b & a);
-        case 76: return (b & ~a) | (~c & b);
-        case 77: return (~c & ~a) | (b & ~a) | (~c & b);
-        case 78: return (c & ~a) | (b & ~a) | (~c & b);
-        case 79: return (~a) | (~c & b);
-        case 80: return (~c & a);
-        case 81: return (~c & ~b) | (~c & a);
-        case 82: return (c & ~b & ~a) | (~c & a);
-        case 83: return (~b & ~a) | (~c & a);
-        case 84: return (~c & b) | (~c & a);
-        case 85: return (~c);
-        case 86: return (c & ~b & ~a) | (~c & b) | (~c & a);
-        case 87: return (~b & ~a) | (~c);
-        case 88: return (c & b & ~a) | (~c & a);
-        case 89: return (~c & ~b) | (c & b & ~a) | (~c & a);
-        case 90: return (c & ~a) | (~c & a);
-        case 91: return (~b & ~a) | (c & ~a) | (~c & a);
-        case 92: return (b & ~a) | (~c & a);
-        case 93: return (~c) | (b & ~a);
-        case 94: return (c & ~a) | (b & ~a) | (~c & a);
-        case 95: return (~a) | (~c);
-        case 96: return (c & ~b & a) | (~c & b & a);
-        case 97: return (~c & ~b & ~a) | (c & ~b & a) | (~c & b & a);
-        case 98: return (c & ~b) | (~c & b & a);
-        case 99: return (~b & ~a) | (c & ~b) | (~c & b & a);
-        case 100: return (~c & b) | (c & ~b & a);
-        case 101: return (~c & ~a) | (c & ~b & a) | (~c & b);
-        case 102: return (c & ~b) | (~c & b);
-        case 103: return (~b & ~a) | (~c & ~a) | (c & ~b) | (~c & b);
-        case 104: return (c & b & ~a) | (c & ~b & a) | (~c & b & a);
-        case 105: return (~c & ~b & ~a) | (c & b & ~a) | (c & ~b & a) | (~c & b & a);
-        case 106: return (c & ~a) | (c & ~b) | (~c & b & a);
-        case 107: return (~b & ~a) | (c & ~a) | (c & ~b) | (~c & b & a);
-        case 108: return (b & ~a) | (c & ~b & a) | (~c & b);
-        case 109: return (~c & ~a) | (b & ~a) | (c & ~b & a) | (~c & b);
-        case 110: return (c & ~a) | (b & ~a) | (c & ~b) | (~c & b);
-        case 111: return (~a) | (c & ~b) | (~c & b);
-        case 112: return (~b & a) | (~c & a);
-        case 113: return (~c & ~b) | (~b & a) | (~c & a);
-        case 114: return (c & ~b) | (~b & a) | (~c & a);
-        case 115: return (~b) | (~c & a);
-        case 116: return (~c & b) | (~b & a);
-        case 117: return (~c) | (~b & a);
-        case 118: return (c & ~b) | (~c & b) | (~b & a);
-        case 119: return (~b) | (~c);
-        case 120: return (c & b & ~a) | (~b & a) | (~c & a);
-        case 121: return (~c & ~b) | (c & b & ~a) | (~b & a) | (~c & a);
-        case 122: return (c & ~a) | (~b & a) | (~c & a);
-        case 123: return (~b) | (c & ~a) | (~c & a);
-        case 124: return (b & ~a) | (~b & a) | (~c & a);
-        case 125: return (~c) | (b & ~a) | (~b & a);
-        case 126: return (c & ~a) | (b & ~a) | (~b & a) | (~c & a);
-        case 127: return (~a) | (~b) | (~c);
-        case 128: return (c & b & a);
-        case 129: return (~c & ~b & ~a) | (c & b & a);
-        case 130: return (c & ~b & ~a) | (c & b & a);
-        case 131: return (~b & ~a) | (c & b & a);
-        case 132: return (~c & b & ~a) | (c & b & a);
-        case 133: return (~c & ~a) | (c & b & a);
-        case 134: return (c & ~b & ~a) | (~c & b & ~a) | (c & b & a);
-        case 135: return (~b & ~a) | (~c & ~a) | (c & b & a);
-        case 136: return (c & b);
-        case 137: return (~c & ~b & ~a) | (c & b);
-        case 138: return (c & ~a) | (c & b);
-        case 139: return (~b & ~a) | (c & ~a) | (c & b);
-        case 140: return (b & ~a) | (c & b);
-        case 141: return (~c & ~a) | (b & ~a) | (c & b);
-        case 142: return (c & ~a) | (b & ~a) | (c & b);
-        case 143: return (~a) | (c & b);
-        case 144: return (~c & ~b & a) | (c & b & a);
-        case 145: return (~c & ~b) | (c & b & a);
-        case 146: return (c & ~b & ~a) | (~c & ~b & a) | (c & b & a);
-        case 147: return (~b & ~a) | (~c & ~b) | (c & b & a);
-        case 148: return (~c & b & ~a) | (~c & ~b & a) | (c & b & a);
-        case 149: return (~c & ~a) | (~c & ~b) | (c & b & a);
-        case 150: return (c & ~b & ~a) | (~c & b & ~a) | (~c & ~b & a) | (c & b & a);
-        case 151: return (~b & ~a) | (~c & ~a) | (~c & ~b) | (c & b & a);
-        case 152: return (c & b) | (~c & ~b & a);
-        case 153: return (~c & ~b) | (c & b);
-        case 154: return (c & ~a) | (~c & ~b & a) | (c & b);
-        case 155: return (~b & ~a) | (c & ~a) | (~c & ~b) | (c & b);
-        case 156: return (b & ~a) | (~c & ~b & a) | (c & b);
-        case 157: return (~c & ~a) | (b & ~a) | (~c & ~b) | (c & b);
-        case 158: return (c & ~a) | (b & ~a) | (~c & ~b & a) | (c & b);
-        case 159: return (~a) | (~c & ~b) | (c & b);
-        case 160: return (c & a);
-        case 161: return (~c & ~b & ~a) | (c & a);
-        case 162: return (c & ~b) | (c & a);
-        case 163: return (~b & ~a) | (c & a);
-        case 164: return (~c & b & ~a) | (c & a);
-        case 165: return (~c & ~a) | (c & a);
-        case 166: return (c & ~b) | (~c & b & ~a) | (c & a);
-        case 167: return (~b & ~a) | (~c & ~a) | (c & a);
-        case 168: return (c & b) | (c & a);
-        case 169: return (~c & ~b & ~a) | (c & b) | (c & a);
-        case 170: return (c);
-        case 171: return (~b & ~a) | (c);
-        case 172: return (b & ~a) | (c & a);
-        case 173: return (~c & ~a) | (b & ~a) | (c & a);
-        case 174: return (c) | (b & ~a);
-        case 175: return (~a) | (c);
-        case 176: return (~b & a) | (c & a);
-        case 177: return (~c & ~b) | (~b & a) | (c & a);
-        case 178: return (c & ~b) | (~b & a) | (c & a);
-        case 179: return (~b) | (c & a);
-        case 180: return (~c & b & ~a) | (~b & a) | (c & a);
-        case 181: return (~c & ~a) | (~b & a) | (c & a);
-        case 182: return (c & ~b) | (~c & b & ~a) | (~b & a) | (c & a);
-        case 183: return (~b) | (~c & ~a) | (c & a);
-        case 184: return (c & b) | (~b & a);
-        case 185: return (~c & ~b) | (c & b) | (~b & a);
-        case 186: return (c) | (~b & a);
-        case 187: return (~b) | (c);
-        case 188: return (b & ~a) | (~b & a) | (c & a);
-        case 189: return (~c & ~a) | (b & ~a) | (~b & a) | (c & a);
-        case 190: return (c) | (b & ~a) | (~b & a);
-        case 191: return (~a) | (~b) | (c);
-        case 192: return (b & a);
-        case 193: return (~c & ~b & ~a) | (b & a);
-        case 194: return (c & ~b & ~a) | (b & a);
-        case 195: return (~b & ~a) | (b & a);
-        case 196: return (~c & b) | (b & a);
-        case 197: return (~c & ~a) | (b & a);
-        case 198: return (c & ~b & ~a) | (~c & b) | (b & a);
-        case 199: return (~b & ~a) | (~c & ~a) | (b & a);
-        case 200: return (c & b) | (b & a);
-        case 201: return (~c & ~b & ~a) | (c & b) | (b & a);
-        case 202: return (c & ~a) | (b & a);
-        case 203: return (~b & ~a) | (c & ~a) | (b & a);
-        case 204: return (b);
-        case 205: return (~c & ~a) | (b);
-        case 206: return (c & ~a) | (b);
-        case 207: return (~a) | (b);
-        case 208: return (~c & a) | (b & a);
-        case 209: return (~c & ~b) | (b & a);
-        case 210: return (c & ~b & ~a) | (~c & a) | (b & a);
-        case 211: return (~b & ~a) | (~c & a) | (b & a);
-        case 212: return (~c & b) | (~c & a) | (b & a);
-        case 213: return (~c) | (b & a);
-        case 214: return (c & ~b & ~a) | (~c & b) | (~c & a) | (b & a);
-        case 215: return (~b & ~a) | (~c) | (b & a);
-        case 216: return (c & b) | (~c & a);
-        case 217: return (~c & ~b) | (c & b) | (b & a);
-        case 218: return (c & ~a) | (~c & a) | (b & a);
-        case 219: return (~b & ~a) | (c & ~a) | (~c & a) | (b & a);
-        case 220: return (b) | (~c & a);
-        case 221: return (~c) | (b);
-        case 222: return (c & ~a) | (b) | (~c & a);
-        case 223: return (~a) | (~c) | (b);
-        case 224: return (c & a) | (b & a);
-        case 225: return (~c & ~b & ~a) | (c & a) | (b & a);
-        case 226: return (c & ~b) | (b & a);
-        case 227: return (~b & ~a) | (c & a) | (b & a);
-        case 228: return (~c & b) | (c & a);
-        case 229: return (~c & ~a) | (c & a) | (b & a);
-        case 230: return (c & ~b) | (~c & b) | (b & a);
-        case 231: return (~b & ~a) | (~c & ~a) | (c & a) | (b & a);
-        case 232: return (c & b) | (c & a) | (b & a);
-        case 233: return (~c & ~b & ~a) | (c & b) | (c & a) | (b & a);
-        case 234: return (c) | (b & a);
-        case 235: return (~b & ~a) | (c) | (b & a);
-        case 236: return (b) | (c & a);
-        case 237: return (~c & ~a) | (b) | (c & a);
-        case 238: return (c) | (b);
-        case 239: return (~a) | (c) | (b);
-        case 240: return (a);
-        case 241: return (~c & ~b) | (a);
-        case 242: return (c & ~b) | (a);
-        case 243: return (~b) | (a);
-        case 244: return (~c & b) | (a);
-        case 245: return (~c) | (a);
-        case 246: return (c & ~b) | (~c & b) | (a);
-        case 247: return (~b) | (~c) | (a);
-        case 248: return (c & b) | (a);
-        case 249: return (~c & ~b) | (c & b) | (a);
-        case 250: return (c) | (a);
-        case 251: return (~b) | (c) | (a);
-        case 252: return (b) | (a);
-        case 253: return (~c) | (b) | (a);
-        case 254: return (c) | (b) | (a);
-        default:  return 0xFFFF;
-    }
+    return mintermFunc(minterm)(a, b, c);
 }
 
 void
@@ -484,6 +262,8 @@ Blitter::doFill(u16 &data, bool &carry)
 void
 Blitter::prepareBlit()
 {
+    joinBlit();
+
     remaining = bltsizeH * bltsizeV;
     cntA = cntB = cntC = cntD = bltsizeH;
 
@@ -501,8 +281,14 @@ Blitter::beginBlit()
 {
     int level = config.accuracy;
 
+    // Let the deferred bitplane fetches see the memory contents before the blit
+    agnus.syncBplEvents<AGNUS_ACCESS>();
+
     if (BLT_GUARD) memset(memguard, 0, sizeof(memguard));
-    
+
+    // Record the blit if profiling is enabled
+    dmaProfiler.blitterWillStart(bltcon0, bltcon1, bltsizeH, bltsizeV, level);
+
     if (bltconLINE()) {
 
         if (BLT_CHECKSUM) {
@@ -542,6 +328,8 @@ Blitter::beginBlit()
 
         beginCopyBlit(level);
     }
+
+    dmaProfiler.endSpan();
 }
 
 void
@@ -616,6 +404,9 @@ Blitter::endBlit()
         */
     }
     
+    // Finish the profiler record
+    dmaProfiler.blitterDidTerminate();
+
     // Let the Copper know about the termination
     copper.blitterDidTerminate();
 }
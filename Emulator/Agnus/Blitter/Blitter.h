@@ -10,6 +10,8 @@
 #ifndef _BLITTER_H
 #define _BLITTER_H
 
+#include <condition_variable>
+
 /* The Blitter supports three accuracy levels:
  *
  * Level 0: Moves data in a single chunk.
@@ -28,6 +30,8 @@ class Blitter : public AmigaComponent
 {
     friend class Agnus;
 
+private:
+
     // Current configuration
     BlitterConfig config;
 
@@ -86,6 +90,24 @@ class Blitter : public AmigaComponent
 
     // The Fast Blitter's blit functions
     void (Blitter::*blitfunc[32])(void);
+    void (Blitter::*directfunc[32])(const i64 *, const i32 *, bool);
+    void (Blitter::*linefunc[64])(void);
+
+    // Maximum number of words in a single row of a blit
+    static const int maxRow = 2048;
+
+    /* Row buffers used by the direct copy blit path. Data is stored in memory
+     * order, starting at index 1 in rowA and rowB. The additional elements on
+     * both sides are needed by the barrel shifter. rowW holds the D row in big
+     * endian format.
+     */
+    u16 rowA[maxRow + 2];
+    u16 rowB[maxRow + 2];
+    u16 rowC[maxRow];
+    u16 rowD[maxRow];
+    u16 holdA[maxRow];
+    u16 holdB[maxRow];
+    u16 rowW[maxRow];
 
 
     //
@@ -93,7 +115,8 @@ class Blitter : public AmigaComponent
     //
 
     // Micro-programs for copy blits
-    void (Blitter::*copyBlitInstr[16][2][2][6])(void);
+    void (Blitter::*copyBlitInstr[16][2][2])(void);
+    void (Blitter::*fakeCopyBlitInstr[16][2])(void);
 
     // Micro-program for line blits
     void (Blitter::*lineBlitInstr[6])(void);
@@ -162,6 +185,50 @@ private:
     // Counter for tracking the remaining words to process
     int remaining;
 
+
+    //
+    // Helper thread
+    //
+
+    // Minimum number of words a blit must have to run on the helper thread
+    static const int concurrentWords = 4096;
+
+    // The helper thread executing big copy blits concurrently (if enabled)
+    std::thread helper;
+
+    // Synchronization primitives guarding helperBusy and helperQuit
+    std::mutex helperLock;
+    std::condition_variable helperCond;
+
+    // Indicates that the helper thread is processing a blit
+    bool helperBusy = false;
+
+    // Indicates that the helper thread should terminate
+    bool helperQuit = false;
+
+    // The blit function executed by the helper thread
+    int helperJob = 0;
+
+    // Location of the blit channels in Chip Ram (see locateCopyBlit())
+    i64 helperOffset[4] = { };
+    i32 helperStep[4] = { };
+
+    // Kernel time the helper thread has spent on the most recent blit
+    u64 helperTime = 0;
+
+    /* Indicates that a blit has been handed over to the helper thread and
+     * hasn't been joined yet. This variable is owned by the emulator thread.
+     */
+    bool concurrent = false;
+
+    /* Chip Ram regions accessed by the concurrent blit, one per channel. The
+     * guard region is the bounding box of all regions.
+     */
+    u32 regionStart[4] = { };
+    u32 regionSize[4] = { };
+    u32 guardStart = 0;
+    u32 guardSize = 0;
+
     // Debug counters
     int copycount;
     int linecount;
@@ -183,12 +250,14 @@ public:
 public:
     
     Blitter(Amiga& ref);
+    ~Blitter();
 
     void initFastBlitter();
     void initSlowBlitter();
 
     void _initialize() override;
     void _reset(bool hard) override;
+    void _pause() override;
 
     
     //
@@ -275,9 +344,10 @@ private:
         & remaining;
     }
 
+    // Concurrent blits are joined by class Amiga before serializing starts
     size_t _size() override { COMPUTE_SNAPSHOT_SIZE }
-    size_t _load(u8 *buffer) override { LOAD_SNAPSHOT_ITEMS }
-    size_t _save(u8 *buffer) override { SAVE_SNAPSHOT_ITEMS }
+    size_t _load(u8 *buffer) override { assert(!concurrent); LOAD_SNAPSHOT_ITEMS }
+    size_t _save(u8 *buffer) override { assert(!concurrent); SAVE_SNAPSHOT_ITEMS }
 
     
     //
@@ -291,6 +361,11 @@ public:
     long getConfigItem(ConfigOption option);
     bool setConfigItem(ConfigOption option, long value) override;
 
+private:
+
+    // Launches or terminates the helper thread
+    void setHelperThread(bool enable);
+
     
     //
     // Analyzing
@@ -410,7 +485,10 @@ public:
 
 private:
     
-    // Emulates the minterm logic circuit
+    /* Emulates the minterm logic circuit. The first function is a reference
+     * implementation. The second function calls a function that is
+     * specialized for the given minterm.
+     */
     u16 doMintermLogic(u16 a, u16 b, u16 c, u8 minterm);
     u16 doMintermLogicQuick(u16 a, u16 b, u16 c, u8 minterm);
 
@@ -452,10 +530,81 @@ private:
     // Performs a copy blit operation via the FastBlitter
     template <bool useA, bool useB, bool useC, bool useD, bool desc>
     void doFastCopyBlit();
+
+    /* Performs a copy blit operation row by row directly in Chip Ram. The
+     * channels must have been located with locateCopyBlit() before. If async
+     * is true, the function is executed by the helper thread and leaves all
+     * state alone that is owned by the emulator thread (data bus, Copper).
+     */
+    template <bool useA, bool useB, bool useC, bool useD, bool desc>
+    void doFastCopyBlitDirect(const i64 offset[4], const i32 step[4], bool async);
+
+    /* Returns the Chip Ram offset of the first row of a blit channel or -1 if
+     * one of the rows wraps around or leaves Chip Ram.
+     */
+    i64 chipRows(u32 addr, int words, int rows, i32 step, bool desc);
+
+    // Checks if all addresses in [lo; hi] are mapped to Chip Ram
+    bool inChipRam(i64 lo, i64 hi);
+
+    // Checks if writing a row of D overwrites source words before they are read
+    bool overlaps(i64 src, i64 dst, int bytes, bool desc);
     
+    /* Locates all channels of a copy blit in Chip Ram. For each channel, the
+     * offset of the first row and the distance between two rows is returned.
+     * The function returns false if the blit needs to be performed word by
+     * word, because a row leaves Chip Ram, wraps around, or is overwritten
+     * before it has been read completely.
+     */
+    bool locateCopyBlit(u16 use, bool desc, i64 offset[4], i32 step[4]);
+
     // Performs a line blit operation via the FastBlitter
     void doFastLineBlit();
 
+    /* Performs a line blit operation for a particular octant and mode. If
+     * direct is true, Chip Ram is accessed without the help of the memory
+     * interface. This requires the whole line to be located in Chip Ram.
+     */
+    template <int octant, bool sing, bool useC, bool direct>
+    void doFastLineBlit();
+
+
+    //
+    //  Executing the Fast Blitter concurrently
+    //
+
+public:
+
+    // Waits until the blit running on the helper thread has been completed
+    void joinBlit() { if (concurrent) completeConcurrentBlit(); }
+
+    // Joins the concurrent blit if it accesses the specified Chip Ram offset
+    void joinBlit(u32 offset) {
+        if ((u32)(offset - guardStart) < guardSize) joinBlitIfAccessed(offset);
+    }
+
+private:
+
+    /* Hands a copy blit over to the helper thread. Returns false if the blit
+     * is too small, or can't be processed directly in Chip Ram.
+     */
+    bool beginConcurrentCopyBlit();
+
+    void completeConcurrentBlit();
+    void joinBlitIfAccessed(u32 offset);
+
+    /* Terminates a concurrent blit. This function is called when the blit's
+     * termination event fires. It is also called if a new blit is started
+     * before the event has fired.
+     */
+    void endConcurrentBlit();
+
+    // Terminates the helper thread
+    void stopHelperThread();
+
+    // Main function of the helper thread
+    void helperMain();
+
 
     //
     //  Executing the Slow Blitter
@@ -463,6 +612,9 @@ private:
 
 private:
     
+    // Returns the number of DMA cycles a copy blit takes on a free bus
+    int copyBlitCycles();
+
     // Starts a level 1 blit
     void beginFakeCopyBlit();
     void beginFakeLineBlit();
@@ -471,8 +623,12 @@ private:
     void beginSlowLineBlit();
     void beginSlowCopyBlit();
 
+    // Emulates the next micro-instruction of a copy blit micro-program
+    template <u16 nr, bool fill, bool desc> void execCopyProgram();
+    template <u16 nr, bool fill> void fakeExecCopyProgram();
+
     // Emulates a Blitter micro-instruction
-    template <u16 instr> void exec();
+    template <u16 instr, bool desc> void exec();
     template <u16 instr> void fakeExec();
 
     // Checks iterations
@@ -50,17 +50,28 @@ Blitter::serviceEvent(EventID id)
         case BLT_COPY_SLOW:
 
             trace(BLT_DEBUG, "Instruction %d:%d\n", bltconUSE(), bltpc);
-            (this->*copyBlitInstr[bltconUSE()][0][bltconFE()][bltpc])();
+            dmaProfiler.beginSpan();
+            (this->*copyBlitInstr[bltconUSE()][bltconFE()][bltconDESC()])();
+            dmaProfiler.endSpan();
             break;
 
         case BLT_COPY_FAKE:
 
             trace(BLT_DEBUG, "Faked instruction %d:%d\n", bltconUSE(), bltpc);
-            (this->*copyBlitInstr[bltconUSE()][1][bltconFE()][bltpc])();
+            dmaProfiler.beginSpan();
+            (this->*fakeCopyBlitInstr[bltconUSE()][bltconFE()])();
+            dmaProfiler.endSpan();
             break;
 
         case BLT_LINE_FAKE:
+            dmaProfiler.beginSpan();
             (this->*lineBlitInstr[bltpc])();
+            dmaProfiler.endSpan();
+            break;
+
+        case BLT_COPY_ASYNC:
+
+            endConcurrentBlit();
             break;
 
         default:
@@ -21,6 +21,7 @@ void
 Blitter::setBLTCON0(u16 value)
 {
     trace(BLT_GUARD && running, "BLTCON0 written while Blitter is running\n");
+    joinBlit();
 
     bltcon0 = value;
 }
@@ -40,6 +41,7 @@ void
 Blitter::setBLTCON0L(u16 value)
 {
     trace(BLT_GUARD && running, "BLTCON0L written while Blitter is running\n");
+    joinBlit();
 
     bltcon0 = HI_LO(HI_BYTE(bltcon0), LO_BYTE(value));
 }
@@ -63,6 +65,7 @@ void
 Blitter::setBLTCON1(u16 value)
 {
     trace(BLT_GUARD && running, "BLTCON1 written while Blitter is running\n");
+    joinBlit();
 
     bltcon1 = value;
 }
@@ -80,6 +83,7 @@ Blitter::pokeBLTAPTH(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTAPTH(%X)\n", value);
     trace(BLT_GUARD && running, "BLTAPTH written while Blitter is running\n");
+    joinBlit();
 
     bltapt = REPLACE_HI_WORD(bltapt, value);
 
@@ -93,6 +97,7 @@ Blitter::pokeBLTAPTL(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTAPTL(%X)\n", value);
     trace(BLT_GUARD && running, "BLTAPTL written while Blitter is running\n");
+    joinBlit();
 
     bltapt = REPLACE_LO_WORD(bltapt, value & 0xFFFE);
 }
@@ -102,6 +107,7 @@ Blitter::pokeBLTBPTH(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTBPTH(%X)\n", value);
     trace(BLT_GUARD && running, "BLTBPTH written while Blitter is running\n");
+    joinBlit();
 
     bltbpt = REPLACE_HI_WORD(bltbpt, value);
     
@@ -115,6 +121,7 @@ Blitter::pokeBLTBPTL(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTBPTL(%X)\n", value);
     trace(BLT_GUARD && running, "BLTBPTL written while Blitter is running\n");
+    joinBlit();
 
     bltbpt = REPLACE_LO_WORD(bltbpt, value & 0xFFFE);
 }
@@ -124,6 +131,7 @@ Blitter::pokeBLTCPTH(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTCPTH(%X)\n", value);
     trace(BLT_GUARD && running, "BLTCPTH written while Blitter is running\n");
+    joinBlit();
 
     bltcpt = REPLACE_HI_WORD(bltcpt, value);
     
@@ -137,6 +145,7 @@ Blitter::pokeBLTCPTL(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTCPTL(%X)\n", value);
     trace(BLT_GUARD && running, "BLTCPTL written while Blitter is running\n");
+    joinBlit();
 
     bltcpt = REPLACE_LO_WORD(bltcpt, value & 0xFFFE);
 }
@@ -146,6 +155,7 @@ Blitter::pokeBLTDPTH(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTDPTH(%X)\n", value);
     trace(BLT_GUARD && running, "BLTDPTH written while Blitter is running\n");
+    joinBlit();
 
     bltdpt = REPLACE_HI_WORD(bltdpt, value);
     
@@ -159,6 +169,7 @@ Blitter::pokeBLTDPTL(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTDPTL(%X)\n", value);
     trace(BLT_GUARD && running, "BLTDPTL written while Blitter is running\n");
+    joinBlit();
 
     bltdpt = REPLACE_LO_WORD(bltdpt, value & 0xFFFE);
 }
@@ -168,6 +179,7 @@ Blitter::pokeBLTAFWM(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTAFWM(%X)\n", value);
     trace(BLT_GUARD && running, "BLTAFWM written while Blitter is running\n");
+    joinBlit();
 
     bltafwm = value;
 }
@@ -177,6 +189,7 @@ Blitter::pokeBLTALWM(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTALWM(%X)\n", value);
     trace(BLT_GUARD && running, "BLTALWM written while Blitter is running\n");
+    joinBlit();
 
     bltalwm = value;
 }
@@ -199,6 +212,7 @@ Blitter::setBLTSIZE(u16 value)
 {
     debug(BLTREG_DEBUG, "setBLTSIZE(%X)\n", value);
     trace(BLT_GUARD && running, "BLTSIZE written while Blitter is running\n");
+    joinBlit();
 
     // 15 14 13 12 11 10 09 08 07 06 05 04 03 02 01 00
     // h9 h8 h7 h6 h5 h4 h3 h2 h1 h0 w5 w4 w3 w2 w1 w0
@@ -209,6 +223,9 @@ Blitter::setBLTSIZE(u16 value)
     if (!bltsizeV) bltsizeV = 0x0400;
     if (!bltsizeH) bltsizeH = 0x0040;
 
+    // Terminate a concurrent blit whose termination event hasn't fired yet
+    if (agnus.hasEvent<BLT_SLOT>(BLT_COPY_ASYNC)) endConcurrentBlit();
+
     // Warn if the previous Blitter operation is overwritten
     if (agnus.hasEvent<BLT_SLOT>()) {
         trace(XFILES, "XFILES: Overwriting Blitter event %d\n", agnus.slot[BLT_SLOT].id);
@@ -234,6 +251,7 @@ void
 Blitter::setBLTSIZV(u16 value)
 {
     trace(BLT_GUARD && running, "BLTSIZV written while Blitter is running\n");
+    joinBlit();
 
     // 15  14  13  12  11  10 09 08 07 06 05 04 03 02 01 00
     //  0 h14 h13 h12 h11 h10 h9 h8 h7 h6 h5 h4 h3 h2 h1 h0
@@ -249,6 +267,7 @@ Blitter::pokeBLTSIZH(u16 value)
     if (agnus.isOCS()) return;
 
     trace(BLT_GUARD && running, "BLTSIZH written while Blitter is running\n");
+    joinBlit();
 
     // 15  14  13  12  11  10 09 08 07 06 05 04 03 02 01 00
     //  0   0   0   0   0 w10 w9 w8 w7 w6 w5 w4 w3 w2 w1 w0
@@ -258,6 +277,9 @@ Blitter::pokeBLTSIZH(u16 value)
     if (!bltsizeV) bltsizeV = 0x8000;
     if (!bltsizeH) bltsizeH = 0x0800;
 
+    // Terminate a concurrent blit whose termination event hasn't fired yet
+    if (agnus.hasEvent<BLT_SLOT>(BLT_COPY_ASYNC)) endConcurrentBlit();
+
     agnus.scheduleRel<BLT_SLOT>(DMA_CYCLES(1), BLT_STRT1);
 }
 
@@ -266,6 +288,7 @@ Blitter::pokeBLTAMOD(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTAMOD(%X)\n", value);
     trace(BLT_GUARD && running, "BLTAMOD written while Blitter is running\n");
+    joinBlit();
 
     bltamod = (i16)(value & 0xFFFE);
 }
@@ -274,6 +297,7 @@ Blitter::pokeBLTBMOD(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTBMOD(%X)\n", value);
     trace(BLT_GUARD && running, "BLTBMOD written while Blitter is running\n");
+    joinBlit();
 
     bltbmod = (i16)(value & 0xFFFE);
 }
@@ -283,6 +307,7 @@ Blitter::pokeBLTCMOD(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTCMOD(%X)\n", value);
     trace(BLT_GUARD && running, "BLTCMOD written while Blitter is running\n");
+    joinBlit();
 
     bltcmod = (i16)(value & 0xFFFE);
 }
@@ -292,6 +317,7 @@ Blitter::pokeBLTDMOD(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTDMOD(%X)\n", value);
     trace(BLT_GUARD && running, "BLTDMOD written while Blitter is running\n");
+    joinBlit();
 
     bltdmod = (i16)(value & 0xFFFE);
 }
@@ -301,6 +327,7 @@ Blitter::pokeBLTADAT(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTADAT(%X)\n", value);
     trace(BLT_GUARD && running, "BLTADAT written while Blitter is running\n");
+    joinBlit();
 
     anew = value;
 }
@@ -310,6 +337,7 @@ Blitter::pokeBLTBDAT(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTBDAT(%X)\n", value);
     trace(BLT_GUARD && running, "BLTBDAT written while Blitter is running\n");
+    joinBlit();
 
     bnew = value;
 }
@@ -319,6 +347,7 @@ Blitter::pokeBLTCDAT(u16 value)
 {
     debug(BLTREG_DEBUG, "pokeBLTCDAT(%X)\n", value);
     trace(BLT_GUARD && running, "BLTCDAT written while Blitter is running\n");
+    joinBlit();
 
     chold = value;
 }
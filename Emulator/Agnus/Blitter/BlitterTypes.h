@@ -15,6 +15,7 @@
 typedef struct
 {
     int accuracy;
+    bool helperThread;
 }
 BlitterConfig;
 
@@ -8,6 +8,7 @@
 // -----------------------------------------------------------------------------
 
 #include "Amiga.h"
+#include "SSEUtils.h"
 
 void
 Blitter::initFastBlitter()
@@ -33,6 +34,66 @@ Blitter::initFastBlitter()
 
     assert(sizeof(this->blitfunc) == sizeof(blitfunc));
     memcpy(this->blitfunc, blitfunc, sizeof(blitfunc));
+
+    void (Blitter::*directfunc[32])(const i64 *, const i32 *, bool) = {
+        &Blitter::doFastCopyBlitDirect<0,0,0,0,0>, &Blitter::doFastCopyBlitDirect<0,0,0,0,1>,
+        &Blitter::doFastCopyBlitDirect<0,0,0,1,0>, &Blitter::doFastCopyBlitDirect<0,0,0,1,1>,
+        &Blitter::doFastCopyBlitDirect<0,0,1,0,0>, &Blitter::doFastCopyBlitDirect<0,0,1,0,1>,
+        &Blitter::doFastCopyBlitDirect<0,0,1,1,0>, &Blitter::doFastCopyBlitDirect<0,0,1,1,1>,
+        &Blitter::doFastCopyBlitDirect<0,1,0,0,0>, &Blitter::doFastCopyBlitDirect<0,1,0,0,1>,
+        &Blitter::doFastCopyBlitDirect<0,1,0,1,0>, &Blitter::doFastCopyBlitDirect<0,1,0,1,1>,
+        &Blitter::doFastCopyBlitDirect<0,1,1,0,0>, &Blitter::doFastCopyBlitDirect<0,1,1,0,1>,
+        &Blitter::doFastCopyBlitDirect<0,1,1,1,0>, &Blitter::doFastCopyBlitDirect<0,1,1,1,1>,
+        &Blitter::doFastCopyBlitDirect<1,0,0,0,0>, &Blitter::doFastCopyBlitDirect<1,0,0,0,1>,
+        &Blitter::doFastCopyBlitDirect<1,0,0,1,0>, &Blitter::doFastCopyBlitDirect<1,0,0,1,1>,
+        &Blitter::doFastCopyBlitDirect<1,0,1,0,0>, &Blitter::doFastCopyBlitDirect<1,0,1,0,1>,
+        &Blitter::doFastCopyBlitDirect<1,0,1,1,0>, &Blitter::doFastCopyBlitDirect<1,0,1,1,1>,
+        &Blitter::doFastCopyBlitDirect<1,1,0,0,0>, &Blitter::doFastCopyBlitDirect<1,1,0,0,1>,
+        &Blitter::doFastCopyBlitDirect<1,1,0,1,0>, &Blitter::doFastCopyBlitDirect<1,1,0,1,1>,
+        &Blitter::doFastCopyBlitDirect<1,1,1,0,0>, &Blitter::doFastCopyBlitDirect<1,1,1,0,1>,
+        &Blitter::doFastCopyBlitDirect<1,1,1,1,0>, &Blitter::doFastCopyBlitDirect<1,1,1,1,1>
+    };
+
+    assert(sizeof(this->directfunc) == sizeof(directfunc));
+    memcpy(this->directfunc, directfunc, sizeof(directfunc));
+
+    void (Blitter::*linefunc[64])(void) = {
+        &Blitter::doFastLineBlit<0,0,0,0>, &Blitter::doFastLineBlit<0,0,0,1>,
+        &Blitter::doFastLineBlit<0,0,1,0>, &Blitter::doFastLineBlit<0,0,1,1>,
+        &Blitter::doFastLineBlit<0,1,0,0>, &Blitter::doFastLineBlit<0,1,0,1>,
+        &Blitter::doFastLineBlit<0,1,1,0>, &Blitter::doFastLineBlit<0,1,1,1>,
+        &Blitter::doFastLineBlit<1,0,0,0>, &Blitter::doFastLineBlit<1,0,0,1>,
+        &Blitter::doFastLineBlit<1,0,1,0>, &Blitter::doFastLineBlit<1,0,1,1>,
+        &Blitter::doFastLineBlit<1,1,0,0>, &Blitter::doFastLineBlit<1,1,0,1>,
+        &Blitter::doFastLineBlit<1,1,1,0>, &Blitter::doFastLineBlit<1,1,1,1>,
+        &Blitter::doFastLineBlit<2,0,0,0>, &Blitter::doFastLineBlit<2,0,0,1>,
+        &Blitter::doFastLineBlit<2,0,1,0>, &Blitter::doFastLineBlit<2,0,1,1>,
+        &Blitter::doFastLineBlit<2,1,0,0>, &Blitter::doFastLineBlit<2,1,0,1>,
+        &Blitter::doFastLineBlit<2,1,1,0>, &Blitter::doFastLineBlit<2,1,1,1>,
+        &Blitter::doFastLineBlit<3,0,0,0>, &Blitter::doFastLineBlit<3,0,0,1>,
+        &Blitter::doFastLineBlit<3,0,1,0>, &Blitter::doFastLineBlit<3,0,1,1>,
+        &Blitter::doFastLineBlit<3,1,0,0>, &Blitter::doFastLineBlit<3,1,0,1>,
+        &Blitter::doFastLineBlit<3,1,1,0>, &Blitter::doFastLineBlit<3,1,1,1>,
+        &Blitter::doFastLineBlit<4,0,0,0>, &Blitter::doFastLineBlit<4,0,0,1>,
+        &Blitter::doFastLineBlit<4,0,1,0>, &Blitter::doFastLineBlit<4,0,1,1>,
+        &Blitter::doFastLineBlit<4,1,0,0>, &Blitter::doFastLineBlit<4,1,0,1>,
+        &Blitter::doFastLineBlit<4,1,1,0>, &Blitter::doFastLineBlit<4,1,1,1>,
+        &Blitter::doFastLineBlit<5,0,0,0>, &Blitter::doFastLineBlit<5,0,0,1>,
+        &Blitter::doFastLineBlit<5,0,1,0>, &Blitter::doFastLineBlit<5,0,1,1>,
+        &Blitter::doFastLineBlit<5,1,0,0>, &Blitter::doFastLineBlit<5,1,0,1>,
+        &Blitter::doFastLineBlit<5,1,1,0>, &Blitter::doFastLineBlit<5,1,1,1>,
+        &Blitter::doFastLineBlit<6,0,0,0>, &Blitter::doFastLineBlit<6,0,0,1>,
+        &Blitter::doFastLineBlit<6,0,1,0>, &Blitter::doFastLineBlit<6,0,1,1>,
+        &Blitter::doFastLineBlit<6,1,0,0>, &Blitter::doFastLineBlit<6,1,0,1>,
+        &Blitter::doFastLineBlit<6,1,1,0>, &Blitter::doFastLineBlit<6,1,1,1>,
+        &Blitter::doFastLineBlit<7,0,0,0>, &Blitter::doFastLineBlit<7,0,0,1>,
+        &Blitter::doFastLineBlit<7,0,1,0>, &Blitter::doFastLineBlit<7,0,1,1>,
+        &Blitter::doFastLineBlit<7,1,0,0>, &Blitter::doFastLineBlit<7,1,0,1>,
+        &Blitter::doFastLineBlit<7,1,1,0>, &Blitter::doFastLineBlit<7,1,1,1>
+    };
+
+    assert(sizeof(this->linefunc) == sizeof(linefunc));
+    memcpy(this->linefunc, linefunc, sizeof(linefunc));
 }
 
 void
@@ -56,6 +117,9 @@ Blitter::beginFastCopyBlit()
     // Only call this function in copy blit mode
     assert(!bltconLINE());
 
+    // Let the helper thread process big blits
+    if (beginConcurrentCopyBlit()) return;
+
     // Run the fast copy Bliter
     int nr = ((bltcon0 >> 7) & 0b11110) | !!bltconDESC();
     (this->*blitfunc[nr])();
@@ -69,6 +133,16 @@ Blitter::beginFastCopyBlit()
 template <bool useA, bool useB, bool useC, bool useD, bool desc>
 void Blitter::doFastCopyBlit()
 {
+    i64 offset[4];
+    i32 step[4];
+
+    // Take the fast path if all data resides in Chip Ram
+    u16 use = useA << 3 | useB << 2 | useC << 1 | useD;
+    if (locateCopyBlit(use, desc, offset, step)) {
+        doFastCopyBlitDirect<useA,useB,useC,useD,desc>(offset, step, false);
+        return;
+    }
+
     u32 apt = bltapt;
     u32 bpt = bltbpt;
     u32 cpt = bltcpt;
@@ -85,6 +159,9 @@ void Blitter::doFastCopyBlit()
     i32 cmod = desc ? -bltcmod : bltcmod;
     i32 dmod = desc ? -bltdmod : bltdmod;
 
+    // Look up the minterm function
+    MintermFunc minterm = mintermFunc(bltcon0 & 0xFF);
+
     aold = 0;
     bold = 0;
 
@@ -140,7 +217,7 @@ void Blitter::doFastCopyBlit()
 
             // Run the minterm logic circuit
             trace(BLT_DEBUG, "    Minterms: ahold = %X bhold = %X chold = %X bltcon0 = %X (hex)\n", ahold, bhold, chold, bltcon0);
-            dhold = doMintermLogicQuick(ahold, bhold, chold, bltcon0 & 0xFF);
+            dhold = minterm(ahold, bhold, chold);
             assert(releaseBuild() || dhold == doMintermLogic(ahold, bhold, chold, bltcon0 & 0xFF));
 
             // Run the fill logic circuit
@@ -180,6 +257,382 @@ void Blitter::doFastCopyBlit()
     bltdpt = dpt;
 }
 
+template <bool useA, bool useB, bool useC, bool useD, bool desc>
+void Blitter::doFastCopyBlitDirect(const i64 offset[4], const i32 step[4],
+                                   bool async)
+{
+    int w = bltsizeH;
+    int bytes = 2 * w;
+
+    i64 a0 = offset[0], b0 = offset[1], c0 = offset[2], d0 = offset[3];
+    i32 astep = step[0], bstep = step[1], cstep = step[2], dstep = step[3];
+
+    bool fill = bltconFE();
+    bool exclusive = bltconEFE();
+    MintermKernel minterm = mintermKernel(bltcon0 & 0xFF);
+    int ash = bltconASH();
+    int bsh = bltconBSH();
+
+    // Indices of the first and the last processed word in each row
+    int first = desc ? w - 1 : 0;
+    int last = desc ? 0 : w - 1;
+
+    u16 *a = rowA + 1;
+    u16 *b = rowB + 1;
+    u8 *pa = mem.chip + a0;
+    u8 *pb = mem.chip + b0;
+    u8 *pc = mem.chip + c0;
+    u8 *pd = mem.chip + d0;
+
+    aold = 0;
+    bold = 0;
+
+    /* If a channel is disabled, its input is the same in each row. Only the
+     * first row differs, because the barrel shifter starts with an empty old
+     * value. Hence, the input of a disabled channel is set up in the first
+     * two rows, only. If all source channels are disabled, the second row is
+     * stored in rowW and copied to all remaining rows.
+     */
+    for (int y = 0; y < bltsizeV; y++) {
+
+        if (!useA && !useB && !useC && y >= 2) {
+
+            if (useD) {
+                memcpy(pd, rowW, bytes);
+                pd += dstep;
+            }
+            continue;
+        }
+
+        // Fetch A and run the barrel shifter
+        if (useA || y < 2) {
+
+            if (useA) {
+                copySwapped16((u8 *)a, pa, w);
+                anew = a[last];
+                pa += astep;
+            } else {
+                for (int i = 0; i < w; i++) a[i] = anew;
+            }
+            a[last] &= bltalwm;
+            a[first] &= bltafwm;
+            a[desc ? w : -1] = aold;
+            aold = a[last];
+            desc ? shiftLeft16(holdA, a, w, ash) : shiftRight16(holdA, a, w, ash);
+        }
+
+        // Fetch B and run the barrel shifter
+        if (useB || y < 2) {
+
+            if (useB) {
+                copySwapped16((u8 *)b, pb, w);
+                bnew = b[last];
+                pb += bstep;
+            } else {
+                for (int i = 0; i < w; i++) b[i] = bnew;
+            }
+            b[desc ? w : -1] = bold;
+            bold = b[last];
+            desc ? shiftLeft16(holdB, b, w, bsh) : shiftRight16(holdB, b, w, bsh);
+        }
+
+        // Fetch C
+        if (useC) {
+            copySwapped16((u8 *)rowC, pc, w);
+            chold = rowC[last];
+            pc += cstep;
+        } else if (y == 0) {
+            for (int i = 0; i < w; i++) rowC[i] = chold;
+        }
+
+        // Run the minterm logic circuit
+        u16 any = minterm(rowD, holdA, holdB, rowC, w);
+
+        // Run the fill logic circuit
+        if (fill) {
+
+            u16 carry = bltconFCI() ? 0xFFFF : 0;
+            any = 0;
+
+            for (int i = 0; i < w; i++) {
+
+                u16 &data = rowD[desc ? w - 1 - i : i];
+
+                // The carry bit toggles with each set bit (right to left)
+                u16 prefix = data;
+                prefix ^= prefix << 1;
+                prefix ^= prefix << 2;
+                prefix ^= prefix << 4;
+                prefix ^= prefix << 8;
+
+                u16 fillMask = (u16)(prefix << 1) ^ carry;
+                data = exclusive ? data ^ fillMask : data | fillMask;
+                if (prefix & 0x8000) carry = ~carry;
+                any |= data;
+            }
+        }
+
+        // Update the zero flag
+        if (any) bzero = false;
+
+        // Write D
+        if (useD) {
+
+            if (!useA && !useB && !useC) {
+                copySwapped16((u8 *)rowW, (u8 *)rowD, w);
+                memcpy(pd, rowW, bytes);
+            } else {
+                copySwapped16(pd, (u8 *)rowD, w);
+            }
+            pd += dstep;
+        }
+
+        ahold = holdA[last];
+        bhold = holdB[last];
+        dhold = rowD[last];
+    }
+
+    /* Emulate the value that was transferred last on the data bus and let
+     * the Copper know about the modified memory. Blits running on the helper
+     * thread skip this step, because both are owned by the emulator thread.
+     */
+    if (!async) {
+
+        if (useD) mem.dataBus = dhold;
+        else if (useC) mem.dataBus = chold;
+        else if (useB) mem.dataBus = bnew;
+        else if (useA) mem.dataBus = anew;
+
+        if (useD) {
+            i64 d1 = d0 + (i64)(bltsizeV - 1) * dstep;
+            copper.invalidate(MIN(d0, d1), MAX(d0, d1) + bytes);
+            mem.markChipDirty(MIN(d0, d1), MAX(d0, d1) + bytes);
+        }
+    }
+
+    // Write back pointer registers
+    if (useA) bltapt += astep * bltsizeV;
+    if (useB) bltbpt += bstep * bltsizeV;
+    if (useC) bltcpt += cstep * bltsizeV;
+    if (useD) bltdpt += dstep * bltsizeV;
+}
+
+bool
+Blitter::locateCopyBlit(u16 use, bool desc, i64 offset[4], i32 step[4])
+{
+    // Let the word by word implementation handle all debug features
+    if (BLT_DEBUG != 0 || BLT_CHECKSUM != 0 || BLT_GUARD != 0) return false;
+
+    // Narrow blits are processed faster word by word
+    if (bltsizeH < 8) return false;
+
+    int w = bltsizeH;
+    int bytes = 2 * w;
+    assert(w <= maxRow);
+
+    u32 pt[4] = { bltapt, bltbpt, bltcpt, bltdpt };
+    i16 mod[4] = { bltamod, bltbmod, bltcmod, bltdmod };
+
+    for (int i = 0; i < 4; i++) {
+
+        step[i] = desc ? -(bytes + mod[i]) : bytes + mod[i];
+        offset[i] = (use & (8 >> i)) ? chipRows(pt[i], w, bltsizeV, step[i], desc) : 0;
+        if (offset[i] < 0) return false;
+    }
+
+    // Make sure that no D row overwrites source words before they are read
+    if (use & 1) {
+
+        for (int y = 0; y < bltsizeV; y++) {
+
+            i64 d = offset[3] + (i64)y * step[3];
+
+            for (int i = 0; i < 3; i++) {
+
+                if (!(use & (8 >> i))) continue;
+                if (overlaps(offset[i] + (i64)y * step[i], d, bytes, desc)) return false;
+            }
+        }
+    }
+    return true;
+}
+
+i64
+Blitter::chipRows(u32 addr, int words, int rows, i32 step, bool desc)
+{
+    i64 span = 2 * (words - 1);
+
+    // In descending mode, addr points to the last word of the first row
+    i64 first = (i64)(addr & agnus.ptrMask) - (desc ? span : 0);
+    i64 last = first + (i64)(rows - 1) * step;
+
+    // The rows must neither wrap around nor leave Chip Ram
+    i64 lo = MIN(first, last);
+    i64 hi = MAX(first, last) + span + 1;
+    return inChipRam(lo, hi) ? first : -1;
+}
+
+bool
+Blitter::inChipRam(i64 lo, i64 hi)
+{
+    if (lo < 0 || hi > agnus.ptrMask || hi >= (i64)mem.chipRamSize()) return false;
+
+    for (i64 bank = lo >> 16; bank <= hi >> 16; bank++) {
+        if (mem.agnusMemSrc[bank] != MEM_CHIP) return false;
+    }
+    return true;
+}
+
+bool
+Blitter::overlaps(i64 src, i64 dst, int bytes, bool desc)
+{
+    return desc ? (dst < src && src - dst < bytes) : (dst > src && dst - src < bytes);
+}
+
+void
+Blitter::setHelperThread(bool enable)
+{
+    if (enable == helper.joinable()) return;
+
+    amiga.suspend();
+
+    if (enable) {
+
+        helperQuit = false;
+        helper = std::thread(&Blitter::helperMain, this);
+
+    } else {
+
+        joinBlit();
+        stopHelperThread();
+    }
+
+    amiga.resume();
+}
+
+bool
+Blitter::beginConcurrentCopyBlit()
+{
+    if (!helper.joinable() || bltsizeH * bltsizeV < concurrentWords) return false;
+
+    // Only blits that are processed directly in Chip Ram are supported
+    i64 *offset = helperOffset;
+    i32 *step = helperStep;
+    u16 use = bltconUSE();
+    if (!locateCopyBlit(use, bltconDESC(), offset, step)) return false;
+
+    // Determine the memory regions the blit is going to access
+    u32 lo = 0xFFFFFFFF, hi = 0;
+    for (int i = 0; i < 4; i++) {
+
+        if (use & (8 >> i)) {
+
+            i64 last = offset[i] + (i64)(bltsizeV - 1) * step[i];
+            regionStart[i] = (u32)MIN(offset[i], last);
+            regionSize[i] = (u32)(MAX(offset[i], last) - regionStart[i] + 2 * bltsizeH);
+            lo = MIN(lo, regionStart[i]);
+            hi = MAX(hi, regionStart[i] + regionSize[i]);
+
+        } else {
+
+            regionStart[i] = 0;
+            regionSize[i] = 0;
+        }
+    }
+    if (lo > hi) return false;
+    guardStart = lo;
+    guardSize = hi - lo;
+
+    // Let the Copper know about the memory that is going to be modified
+    if (use & 1) {
+        copper.invalidate(regionStart[3], regionStart[3] + regionSize[3]);
+        mem.markChipDirty(regionStart[3], regionStart[3] + regionSize[3]);
+    }
+
+    // Hand the blit over to the helper thread
+    helperJob = ((bltcon0 >> 7) & 0b11110) | !!bltconDESC();
+    concurrent = true;
+    {   std::unique_lock<std::mutex> lock(helperLock);
+        helperBusy = true;
+    }
+    helperCond.notify_all();
+
+    // Terminate when the real Blitter would have finished
+    agnus.scheduleRel<BLT_SLOT>(DMA_CYCLES(copyBlitCycles()), BLT_COPY_ASYNC);
+    return true;
+}
+
+void
+Blitter::completeConcurrentBlit()
+{
+    assert(concurrent);
+
+    {   std::unique_lock<std::mutex> lock(helperLock);
+        helperCond.wait(lock, [this] { return !helperBusy; });
+    }
+    dmaProfiler.blitterDidJoin(helperTime);
+
+    concurrent = false;
+    guardStart = 0;
+    guardSize = 0;
+}
+
+void
+Blitter::endConcurrentBlit()
+{
+    // Wait for the helper thread and terminate
+    joinBlit();
+    signalEnd();
+    paula.raiseIrq(INT_BLIT);
+    endBlit();
+}
+
+void
+Blitter::joinBlitIfAccessed(u32 offset)
+{
+    for (int i = 0; i < 4; i++) {
+
+        if (offset - regionStart[i] < regionSize[i]) {
+
+            trace(BLT_DEBUG, "Access to %x joins the concurrent blit\n", offset);
+            completeConcurrentBlit();
+            return;
+        }
+    }
+}
+
+void
+Blitter::stopHelperThread()
+{
+    {   std::unique_lock<std::mutex> lock(helperLock);
+        helperQuit = true;
+    }
+    helperCond.notify_all();
+    helper.join();
+}
+
+void
+Blitter::helperMain()
+{
+    std::unique_lock<std::mutex> lock(helperLock);
+
+    while (1) {
+
+        helperCond.wait(lock, [this] { return helperQuit || helperBusy; });
+        if (helperQuit) break;
+
+        // Run the blit without holding the lock
+        lock.unlock();
+        u64 start = mach_absolute_time();
+        (this->*directfunc[helperJob])(helperOffset, helperStep, true);
+        helperTime = mach_absolute_time() - start;
+        lock.lock();
+
+        helperBusy = false;
+        helperCond.notify_all();
+    }
+}
+
 #define blitterLineIncreaseX(a_shift, cpt) \
 if (a_shift < 15) a_shift++; \
 else \
@@ -208,6 +661,36 @@ Blitter::doFastLineBlit()
     bltcpt &= agnus.ptrMask;
     bltdpt &= agnus.ptrMask;
 
+    /* Check if the line stays in Chip Ram. In each iteration, the C pointer
+     * moves by at most one row and one word. If the line can't leave Chip
+     * Ram, memory is accessed directly.
+     */
+    i64 reach = (i64)bltsizeV * ((bltcmod < 0 ? -bltcmod : bltcmod) + 2);
+    bool direct =
+    BLT_GUARD == 0 &&
+    inChipRam(bltcpt - reach, bltcpt + reach + 1) &&
+    inChipRam(bltdpt, bltdpt + 1);
+
+    // Let the Copper know about the memory that is going to be modified
+    if (direct && bltconUSEC()) {
+        copper.invalidate(bltcpt - reach, bltcpt + reach + 2);
+        copper.invalidate(bltdpt, bltdpt + 2);
+        mem.markChipDirty(bltcpt - reach, bltcpt + reach + 2);
+        mem.markChipDirty(bltdpt, bltdpt + 2);
+    }
+
+    // Run the line Blitter specialized for the current octant and mode
+    int nr =
+    ((bltcon1 >> 2) & 0b111) << 3 |
+    !!(bltcon1 & 0b10) << 2 |
+    bltconUSEC() << 1 |
+    direct;
+    (this->*linefunc[nr])();
+}
+
+template <int octant, bool sing, bool useC, bool direct>
+void Blitter::doFastLineBlit()
+{
     //
     // Adapted from WinFellow
     //
@@ -223,7 +706,6 @@ Blitter::doFastLineBlit()
     
     u16 mask = (bnew >> bltconBSH()) | (bnew << (16 - bltconBSH()));
     bool a_enabled = bltcon & 0x08000000;
-    bool c_enabled = bltcon & 0x02000000;
     
     bool decision_is_signed = (((bltcon >> 6) & 1) == 1);
     u32 decision_variable = bltapt;
@@ -238,31 +720,33 @@ Blitter::doFastLineBlit()
     u32 bzero_local = 0;
     u32 i;
     
-    u32 sulsudaul = (bltcon >> 2) & 0x7;
-    bool x_independent = (sulsudaul & 4);
-    bool x_inc = ((!x_independent) && !(sulsudaul & 2)) || (x_independent && !(sulsudaul & 1));
-    bool y_inc = ((!x_independent) && !(sulsudaul & 1)) || (x_independent && !(sulsudaul & 2));
+    // Decode the octant
+    constexpr bool x_independent = octant & 4;
+    constexpr bool x_inc = x_independent ? !(octant & 1) : !(octant & 2);
+    constexpr bool y_inc = x_independent ? !(octant & 2) : !(octant & 1);
     bool single_dot = false;
-    u8 minterm = (u8)(bltcon >> 16);
+    MintermFunc minterm = mintermFunc((u8)(bltcon >> 16));
     
     for (i = 0; i < height; ++i)
     {
         // Read C-data from memory if the C-channel is enabled
-        if (c_enabled) {
-            bltcdat_local = mem.peek16 <AGNUS_ACCESS> (bltcpt_local);
+        if (useC) {
+            if (direct) {
+                bltcdat_local = READ_16(mem.chip + bltcpt_local);
+            } else {
+                bltcdat_local = mem.peek16 <AGNUS_ACCESS> (bltcpt_local);
+            }
         }
         
         // Calculate data for the A-channel
         bltadat_local = (anew & bltafwm) >> blit_a_shift_local;
         
         // Check for single dot
-        if (x_independent) {
-            if (bltcon & 0x00000002) {
-                if (single_dot) {
-                    bltadat_local = 0;
-                } else {
-                    single_dot = TRUE;
-                }
+        if (x_independent && sing) {
+            if (single_dot) {
+                bltadat_local = 0;
+            } else {
+                single_dot = TRUE;
             }
         }
         
@@ -270,11 +754,15 @@ Blitter::doFastLineBlit()
         bltbdat_local = (mask & 1) ? 0xFFFF : 0;
         
         // Calculate result
-        bltddat_local = doMintermLogicQuick(bltadat_local, bltbdat_local, bltcdat_local, minterm);
+        bltddat_local = minterm(bltadat_local, bltbdat_local, bltcdat_local);
         
         // Save result to D-channel, same as the C ptr after first pixel.
-        if (c_enabled) { // C-channel must be enabled
-            mem.poke16 <AGNUS_ACCESS> (bltdpt_local, bltddat_local);
+        if (useC) { // C-channel must be enabled
+            if (direct) {
+                WRITE_16(mem.chip + bltdpt_local, bltddat_local);
+            } else {
+                mem.poke16 <AGNUS_ACCESS> (bltdpt_local, bltddat_local);
+            }
 
             if (BLT_CHECKSUM) {
                 check1 = fnv_1a_it32(check1, bltddat_local);
@@ -340,6 +828,9 @@ Blitter::doFastLineBlit()
     }
     bltcon = bltcon & 0x0FFFFFFBF;
     if (decision_is_signed) bltcon |= 0x00000040;
+
+    // Emulate the value that was transferred last on the data bus
+    if (direct && useC && height) mem.dataBus = bltddat_local;
     
     setBLTCON0ASH(blit_a_shift_local);
     bnew   = bltbdat_local;
@@ -48,773 +48,479 @@ static const u16 BLTDONE   = 0b0000'0100'0000'0000;
 static const u16 REPEAT    = 0b0000'1000'0000'0000;
 static const u16 FETCH     = FETCH_A | FETCH_B | FETCH_C;
 
-void
-Blitter::initSlowBlitter()
-{
-    /* Micro programs
-     *
-     * The Copy Blitter micro programs are stored in array
-     *
-     *   copyBlitInstr[16][2][2][6]
-     *
-     * For each program, four different versions are stored:
-     *
-     *   [][0][0][] : Performs a Copy Blit in accuracy level 2
-     *   [][0][1][] : Performs a Fill Copy Blit in accuracy level 2
-     *   [][1][0][] : Performs a Copy Blit in accuracy level 1
-     *   [][1][1][] : Performs a Fill Copy Blit in accuracy level 1
-     *
-     * Level 2 microprograms operate the bus and all Blitter components.
-     * Level 1 microprograms are a stripped down version that operates
-     * the bus only. This is what we call "fake execution", because the
-     * blit itself has already been carried out by the Fast Blitter.
-     *
-     * The programs below have been derived from Table 6.2 of the HRM.
-     * The published table doesn't seem to be 100% accurate. See the
-     * microprograms below for applied modifications.
-     *
-     *           Active
-     * BLTCON0  Channels            Cycle sequence
-     *    F     A B C D    A0 B0 C0 -- A1 B1 C1 D0 A2 B2 C2 D1 D2
-     *    E     A B C      A0 B0 C0 A1 B1 C1 A2 B2 C2
-     *    D     A B   D    A0 B0 -- A1 B1 D0 A2 B2 D1 -- D2
-     *    C     A B        A0 B0 -- A1 B1 -- A2 B2
-     *    B     A   C D    A0 C0 -- A1 C1 D0 A2 C2 D1 -- D2
-     *    A     A   C      A0 C0 A1 C1 A2 C2
-     *    9     A     D    A0 -- A1 D0 A2 D1 -- D2
-     *    8     A          A0 -- A1 -- A2
-     *    7       B C D    B0 C0 -- -- B1 C1 D0 -- B2 C2 D1 -- D2
-     *    6       B C      B0 C0 -- B1 C1 -- B2 C2
-     *    5       B   D    B0 -- -- B1 D0 -- B2 D1 -- D2
-     *    4       B        B0 -- -- B1 -- -- B2
-     *    3         C D    C0 -- -- C1 D0 -- C2 D1 -- D2
-     *    2         C      C0 -- C1 -- C2
-     *    1           D    D0 -- D1 -- D2
-     *    0                -- -- -- --
-     *
-     * The programs below apply of the fill bit is set. They have been derived
-     * from the "Errata for the Amiga Hardware Manual" (October 17, 1985).
-     * The published table doesn't seem to be 100% accurate. See the
-     * microprograms below for applied modifications.
-     *
-     *           Active
-     * BLTCON0  Channels            Cycle sequence
-     *    D     A B   D    A0 B0 -- -- A1 B1 D0 -- A2 B2 D1 -- D2
-     *    9     A     D    A0 -- -- A1 D0 A2 D1 -- D2
-     *    5       B   D    B0 -- -- -- B1 D0 -- -- B2 D1 -- D2
-     *    1           D    -- -- -- D0 -- -- D1 -- -- D2
-     *
-     * For all other BLTCON0 combinations, the fill bit has no effect on timing.
-     */
-    void (Blitter::*copyBlitInstr[16][2][2][6])(void) = {
-
-        // 0: -- -- | -- --
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <BUSIDLE>,
-                    &Blitter::exec <BUSIDLE | REPEAT>,
-
-                    &Blitter::exec <NOTHING>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <BUSIDLE>,
-                    &Blitter::exec <BUSIDLE | REPEAT>,
-
-                    &Blitter::exec <NOTHING>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <BUSIDLE>,
-                    &Blitter::fakeExec <BUSIDLE | REPEAT>,
-
-                    &Blitter::fakeExec <NOTHING>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <BUSIDLE>,
-                    &Blitter::fakeExec <BUSIDLE | REPEAT>,
-
-                    &Blitter::fakeExec <NOTHING>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                }
-            }
+/* Micro programs
+ *
+ * The Copy Blitter micro programs are stored in array
+ *
+ *   copyBlitProgram[16][2][6]
+ *
+ * For each program, two different versions are stored:
+ *
+ *   [][0][] : Performs a Copy Blit
+ *   [][1][] : Performs a Fill Copy Blit
+ *
+ * Each program is executed in two different ways. In accuracy level 2, the
+ * micro-instructions operate the bus and all Blitter components. In accuracy
+ * level 1, a stripped down version is executed that operates the bus only.
+ * This is what we call "fake execution", because the blit itself has already
+ * been carried out by the Fast Blitter.
+ *
+ * The programs below have been derived from Table 6.2 of the HRM.
+ * The published table doesn't seem to be 100% accurate. See the
+ * microprograms below for applied modifications.
+ *
+ *           Active
+ * BLTCON0  Channels            Cycle sequence
+ *    F     A B C D    A0 B0 C0 -- A1 B1 C1 D0 A2 B2 C2 D1 D2
+ *    E     A B C      A0 B0 C0 A1 B1 C1 A2 B2 C2
+ *    D     A B   D    A0 B0 -- A1 B1 D0 A2 B2 D1 -- D2
+ *    C     A B        A0 B0 -- A1 B1 -- A2 B2
+ *    B     A   C D    A0 C0 -- A1 C1 D0 A2 C2 D1 -- D2
+ *    A     A   C      A0 C0 A1 C1 A2 C2
+ *    9     A     D    A0 -- A1 D0 A2 D1 -- D2
+ *    8     A          A0 -- A1 -- A2
+ *    7       B C D    B0 C0 -- -- B1 C1 D0 -- B2 C2 D1 -- D2
+ *    6       B C      B0 C0 -- B1 C1 -- B2 C2
+ *    5       B   D    B0 -- -- B1 D0 -- B2 D1 -- D2
+ *    4       B        B0 -- -- B1 -- -- B2
+ *    3         C D    C0 -- -- C1 D0 -- C2 D1 -- D2
+ *    2         C      C0 -- C1 -- C2
+ *    1           D    D0 -- D1 -- D2
+ *    0                -- -- -- --
+ *
+ * The programs below apply of the fill bit is set. They have been derived
+ * from the "Errata for the Amiga Hardware Manual" (October 17, 1985).
+ * The published table doesn't seem to be 100% accurate. See the
+ * microprograms below for applied modifications.
+ *
+ *           Active
+ * BLTCON0  Channels            Cycle sequence
+ *    D     A B   D    A0 B0 -- -- A1 B1 D0 -- A2 B2 D1 -- D2
+ *    9     A     D    A0 -- -- A1 D0 A2 D1 -- D2
+ *    5       B   D    B0 -- -- -- B1 D0 -- -- B2 D1 -- D2
+ *    1           D    -- -- -- D0 -- -- D1 -- -- D2
+ *
+ * For all other BLTCON0 combinations, the fill bit has no effect on timing.
+ */
+static constexpr u16 copyBlitProgram[16][2][6] = {
+
+    // 0: -- -- | -- --
+    {
+        {   // No fill
+            BUSIDLE,
+            BUSIDLE | REPEAT,
+
+            NOTHING,
+            BLTDONE,
+            BLTDONE,
+            BLTDONE
         },
-
-        // 1:  -- D0 -- D1 | -- D2
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <HOLD_D | BUSIDLE>,
-                    &Blitter::exec <WRITE_D | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <FILL | HOLD_D | BUSIDLE>,
-                    &Blitter::exec <WRITE_D>,
-                    &Blitter::exec <BUSIDLE | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <HOLD_D | BUSIDLE>,
-                    &Blitter::fakeExec <WRITE_D | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <FILL | HOLD_D | BUSIDLE>,
-                    &Blitter::fakeExec <WRITE_D>,
-                    &Blitter::fakeExec <BUSIDLE | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                }
-            }
+        {   // Fill
+            BUSIDLE,
+            BUSIDLE | REPEAT,
+
+            NOTHING,
+            BLTDONE,
+            BLTDONE,
+            BLTDONE
+        }
+    },
+
+    // 1:  -- D0 -- D1 | -- D2
+    {
+        {   // No fill
+            HOLD_D | BUSIDLE,
+            WRITE_D | HOLD_A | HOLD_B | REPEAT,
+
+            HOLD_D,
+            WRITE_D | BLTDONE,
+            BLTDONE,
+            BLTDONE
         },
-
-        // 2: C0 -- C1 -- | -- C2
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <HOLD_D | BUSIDLE>,
-                    &Blitter::exec <FETCH_C | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>,
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <FILL | HOLD_D | BUSIDLE>,
-                    &Blitter::exec <FETCH_C | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <HOLD_D | BUSIDLE>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <FILL | HOLD_D | BUSIDLE>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                }
-            }
+        {   // Fill
+            FILL | HOLD_D | BUSIDLE,
+            WRITE_D,
+            BUSIDLE | HOLD_A | HOLD_B | REPEAT,
+
+            FILL | HOLD_D,
+            WRITE_D | BLTDONE,
+            BLTDONE
+        }
+    },
+
+    // 2: C0 -- C1 -- | -- C2
+    {
+        {   // No fill
+            HOLD_D | BUSIDLE,
+            FETCH_C | HOLD_A | HOLD_B | REPEAT,
+
+            HOLD_D,
+            BLTDONE,
+            BLTDONE,
+            BLTDONE,
         },
-
-        // 3: C0 -- -- C1 D0 -- C2 D1 -- | -- D2
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <HOLD_D | BUSIDLE>,
-                    &Blitter::exec <FETCH_C | HOLD_A | HOLD_B>,
-                    &Blitter::exec <WRITE_D | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <FILL | HOLD_D | BUSIDLE>,
-                    &Blitter::exec <FETCH_C | HOLD_A | HOLD_B>,
-                    &Blitter::exec <WRITE_D | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <HOLD_D | BUSIDLE>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_A | HOLD_B>,
-                    &Blitter::fakeExec <WRITE_D | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <FILL | HOLD_D | BUSIDLE>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_A | HOLD_B>,
-                    &Blitter::fakeExec <WRITE_D | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                }
-            }
+        {   // Fill
+            FILL | HOLD_D | BUSIDLE,
+            FETCH_C | HOLD_A | HOLD_B | REPEAT,
+
+            FILL | HOLD_D,
+            BLTDONE,
+            BLTDONE,
+            BLTDONE
+        }
+    },
+
+    // 3: C0 -- -- C1 D0 -- C2 D1 -- | -- D2
+    {
+        {   // No fill
+            HOLD_D | BUSIDLE,
+            FETCH_C | HOLD_A | HOLD_B,
+            WRITE_D | REPEAT,
+
+            HOLD_D,
+            WRITE_D | BLTDONE,
+            BLTDONE
         },
-
-        // 4: B0 -- -- B1 -- -- | -- B2
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <HOLD_D | BUSIDLE>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <HOLD_B | BUSIDLE | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <FILL | HOLD_D | BUSIDLE>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <HOLD_B | BUSIDLE | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <HOLD_D | BUSIDLE>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <HOLD_B | BUSIDLE | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <FILL | HOLD_D | BUSIDLE>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <HOLD_B | BUSIDLE | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                }
-            }
+        {   // Fill
+            FILL | HOLD_D | BUSIDLE,
+            FETCH_C | HOLD_A | HOLD_B,
+            WRITE_D | REPEAT,
+
+            FILL | HOLD_D,
+            WRITE_D | BLTDONE,
+            BLTDONE
+        }
+    },
+
+    // 4: B0 -- -- B1 -- -- | -- B2
+    {
+        {   // No fill
+            HOLD_D | BUSIDLE,
+            FETCH_B | HOLD_A,
+            HOLD_B | BUSIDLE | REPEAT,
+
+            HOLD_D,
+            BLTDONE,
+            BLTDONE
         },
-
-        // 5: B0 -- -- B1 D0 -- B2 D1 -- | -- D2
-        // 5: B0 -- -- -- B1 D0 -- -- B2 D1 -- -- | -- D2
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <BUSIDLE | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <WRITE_D | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <BUSIDLE | FILL | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <WRITE_D | HOLD_B>,
-                    &Blitter::exec <BUSIDLE | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <BUSIDLE | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <WRITE_D | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <BUSIDLE | FILL | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <WRITE_D | HOLD_B>,
-                    &Blitter::fakeExec <BUSIDLE | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>
-                }
-            }
+        {   // Fill
+            FILL | HOLD_D | BUSIDLE,
+            FETCH_B | HOLD_A,
+            HOLD_B | BUSIDLE | REPEAT,
+
+            FILL | HOLD_D,
+            BLTDONE,
+            BLTDONE
+        }
+    },
+
+    // 5: B0 -- -- B1 D0 -- B2 D1 -- | -- D2
+    // 5: B0 -- -- -- B1 D0 -- -- B2 D1 -- -- | -- D2
+    {
+        {   // No fill
+            BUSIDLE | HOLD_D,
+            FETCH_B | HOLD_A,
+            WRITE_D | HOLD_B | REPEAT,
+
+            HOLD_D,
+            WRITE_D | BLTDONE,
+            BLTDONE
         },
-
-        // 6: B0 C0 -- B1 C1 -- | -- --
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <BUSIDLE | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <FETCH_C | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <BUSIDLE | FILL | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <FETCH_C | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <BUSIDLE | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <BUSIDLE | FILL | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                }
-            }
+        {   // Fill
+            BUSIDLE | FILL | HOLD_D,
+            FETCH_B | HOLD_A,
+            WRITE_D | HOLD_B,
+            BUSIDLE | REPEAT,
+
+            FILL | HOLD_D,
+            WRITE_D | BLTDONE
+        }
+    },
+
+    // 6: B0 C0 -- B1 C1 -- | -- --
+    {
+        {   // No fill
+            BUSIDLE | HOLD_D,
+            FETCH_B | HOLD_A,
+            FETCH_C | HOLD_B | REPEAT,
+
+            HOLD_D,
+            BLTDONE,
+            BLTDONE
         },
-
-        // 7: B0 C0 -- -- B1 C1 D0 -- B2 C2 D1 -- | -- D2
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <BUSIDLE | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <FETCH_C | HOLD_B>,
-                    &Blitter::exec <WRITE_D | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>
-                },
-                {
-                    // Full execution, fill
-                    &Blitter::exec <BUSIDLE | FILL | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <FETCH_C | HOLD_B>,
-                    &Blitter::exec <WRITE_D | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <BUSIDLE | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_B>,
-                    &Blitter::fakeExec <WRITE_D | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <BUSIDLE | FILL | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_B>,
-                    &Blitter::fakeExec <WRITE_D | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>
-                }
-            }
+        {   // Fill
+            BUSIDLE | FILL | HOLD_D,
+            FETCH_B | HOLD_A,
+            FETCH_C | HOLD_B | REPEAT,
+
+            FILL | HOLD_D,
+            BLTDONE,
+            BLTDONE
+        }
+    },
+
+    // 7: B0 C0 -- -- B1 C1 D0 -- B2 C2 D1 -- | -- D2
+    {
+        {   // No fill
+            BUSIDLE | HOLD_D,
+            FETCH_B | HOLD_A,
+            FETCH_C | HOLD_B,
+            WRITE_D | REPEAT,
+
+            HOLD_D,
+            WRITE_D | BLTDONE
         },
-
-        // 8: A0 -- A1 -- | -- --
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <FETCH_A | HOLD_D>,
-                    &Blitter::exec <HOLD_A | HOLD_B | BUSIDLE | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::exec <HOLD_A | HOLD_B | BUSIDLE | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <FETCH_A | HOLD_D>,
-                    &Blitter::fakeExec <HOLD_A | HOLD_B | BUSIDLE | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::fakeExec <HOLD_A | HOLD_B | BUSIDLE | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                }
-            }
+        {   // Fill
+            BUSIDLE | FILL | HOLD_D,
+            FETCH_B | HOLD_A,
+            FETCH_C | HOLD_B,
+            WRITE_D | REPEAT,
+
+            FILL | HOLD_D,
+            WRITE_D | BLTDONE
+        }
+    },
+
+    // 8: A0 -- A1 -- | -- --
+    {
+        {   // No fill
+            FETCH_A | HOLD_D,
+            HOLD_A | HOLD_B | BUSIDLE | REPEAT,
+
+            HOLD_D,
+            BLTDONE,
+            BLTDONE,
+            BLTDONE
         },
-
-        // 9: A0 -- A1 D0 A2 D1 | -- D2
-        // 9: A0 -- -- A1 D0 -- A2 D1 -- | -- D2
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <FETCH_A | HOLD_D>,
-                    &Blitter::exec <WRITE_D | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::exec <WRITE_D | HOLD_A | HOLD_B>,
-                    &Blitter::exec <BUSIDLE | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <FETCH_A | HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | HOLD_A | HOLD_B>,
-                    &Blitter::fakeExec <BUSIDLE | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                }
-            }
+        {   // Fill
+            FETCH_A | FILL | HOLD_D,
+            HOLD_A | HOLD_B | BUSIDLE | REPEAT,
+
+            FILL | HOLD_D,
+            BLTDONE,
+            BLTDONE,
+            BLTDONE
+        }
+    },
+
+    // 9: A0 -- A1 D0 A2 D1 | -- D2
+    // 9: A0 -- -- A1 D0 -- A2 D1 -- | -- D2
+    {
+        {   // No fill
+            FETCH_A | HOLD_D,
+            WRITE_D | HOLD_A | HOLD_B | REPEAT,
+
+            HOLD_D,
+            WRITE_D | BLTDONE,
+            BLTDONE,
+            BLTDONE
         },
-
-        // A: A0 C0 A1 C1 A2 C2 | -- --
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <FETCH_A | HOLD_D>,
-                    &Blitter::exec <FETCH_C | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::exec <FETCH_C | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <FETCH_A | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_A | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                }
-            }
+        {   // Fill
+            FETCH_A | FILL | HOLD_D,
+            WRITE_D | HOLD_A | HOLD_B,
+            BUSIDLE | REPEAT,
+
+            FILL | HOLD_D,
+            WRITE_D | BLTDONE,
+            BLTDONE
+        }
+    },
+
+    // A: A0 C0 A1 C1 A2 C2 | -- --
+    {
+        {   // No fill
+            FETCH_A | HOLD_D,
+            FETCH_C | HOLD_A | HOLD_B | REPEAT,
+
+            HOLD_D,
+            BLTDONE,
+            BLTDONE,
+            BLTDONE
         },
-
-        // B: A0 C0 -- A1 C1 D0 A2 C2 D1 | -- D2
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <FETCH_A | HOLD_D>,
-                    &Blitter::exec <FETCH_C | HOLD_A | HOLD_B>,
-                    &Blitter::exec <WRITE_D | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::exec <FETCH_C | HOLD_A | HOLD_B>,
-                    &Blitter::exec <WRITE_D | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <FETCH_A | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_A | HOLD_B>,
-                    &Blitter::fakeExec <WRITE_D | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_A | HOLD_B>,
-                    &Blitter::fakeExec <WRITE_D | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                }
-            }
+        {   // Fill
+            FETCH_A | FILL | HOLD_D,
+            FETCH_C | HOLD_A | HOLD_B | REPEAT,
+
+            FILL | HOLD_D,
+            BLTDONE,
+            BLTDONE,
+            BLTDONE
+        }
+    },
+
+    // B: A0 C0 -- A1 C1 D0 A2 C2 D1 | -- D2
+    {
+        {   // No fill
+            FETCH_A | HOLD_D,
+            FETCH_C | HOLD_A | HOLD_B,
+            WRITE_D | REPEAT,
+
+            HOLD_D,
+            WRITE_D | BLTDONE,
+            BLTDONE
         },
-
-        // C: A0 B0 -- A1 B1 -- A2 B2 -- | -- --
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <FETCH_A | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <HOLD_B  | BUSIDLE | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <HOLD_B  | BUSIDLE | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <FETCH_A | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <HOLD_B  | BUSIDLE | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <HOLD_B  | BUSIDLE | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                }
-            }
+        {   // Fill
+            FETCH_A | FILL | HOLD_D,
+            FETCH_C | HOLD_A | HOLD_B,
+            WRITE_D | REPEAT,
+
+            FILL | HOLD_D,
+            WRITE_D | BLTDONE,
+            BLTDONE
+        }
+    },
+
+    // C: A0 B0 -- A1 B1 -- A2 B2 -- | -- --
+    {
+        {   // No fill
+            FETCH_A | HOLD_D,
+            FETCH_B | HOLD_A,
+            HOLD_B  | BUSIDLE | REPEAT,
+
+            HOLD_D,
+            BLTDONE,
+            BLTDONE
         },
-
-        // D: A0 B0 -- A1 B1 D0 A2 B2 D1 | -- D2
-        // D: A0 B0 -- -- A1 B1 D0 -- A2 B2 D1 -- | -- D2
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <FETCH_A | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <WRITE_D | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <WRITE_D | HOLD_B>,
-                    &Blitter::exec <BUSIDLE | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <FETCH_A | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <WRITE_D | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <WRITE_D | HOLD_B>,
-                    &Blitter::fakeExec <BUSIDLE | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>
-                }
-            }
+        {   // Fill
+            FETCH_A | FILL | HOLD_D,
+            FETCH_B | HOLD_A,
+            HOLD_B  | BUSIDLE | REPEAT,
+
+            FILL | HOLD_D,
+            BLTDONE,
+            BLTDONE
+        }
+    },
+
+    // D: A0 B0 -- A1 B1 D0 A2 B2 D1 | -- D2
+    // D: A0 B0 -- -- A1 B1 D0 -- A2 B2 D1 -- | -- D2
+    {
+        {   // No fill
+            FETCH_A | HOLD_D,
+            FETCH_B | HOLD_A,
+            WRITE_D | HOLD_B | REPEAT,
+
+            HOLD_D,
+            WRITE_D | BLTDONE,
+            BLTDONE
         },
-
-        // E: A0 B0 C0 A1 B1 C1 A2 B2 C2 | -- --
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <FETCH_A | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <FETCH_C | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <FETCH_C | HOLD_B | REPEAT>,
-
-                    &Blitter::exec <FILL | HOLD_D>,
-                    &Blitter::exec <BLTDONE>,
-                    &Blitter::exec <BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <FETCH_A | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_B | REPEAT>,
-
-                    &Blitter::fakeExec <FILL | HOLD_D>,
-                    &Blitter::fakeExec <BLTDONE>,
-                    &Blitter::fakeExec <BLTDONE>
-                }
-            }
+        {   // Fill
+            FETCH_A | FILL | HOLD_D,
+            FETCH_B | HOLD_A,
+            WRITE_D | HOLD_B,
+            BUSIDLE | REPEAT,
+
+            FILL | HOLD_D,
+            WRITE_D | BLTDONE
+        }
+    },
+
+    // E: A0 B0 C0 A1 B1 C1 A2 B2 C2 | -- --
+    {
+        {   // No fill
+            FETCH_A | HOLD_D,
+            FETCH_B | HOLD_A,
+            FETCH_C | HOLD_B | REPEAT,
+
+            HOLD_D,
+            BLTDONE,
+            BLTDONE
         },
-
-        // F: A0 B0 C0 -- A1 B1 C1 D0 A2 B2 C2 D1 | -- D2
-        {
-            {
-                {   // Full execution, no fill
-                    &Blitter::exec <FETCH_A | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <FETCH_C | HOLD_B>,
-                    &Blitter::exec <WRITE_D | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>
-                },
-                {   // Full execution, fill
-                    &Blitter::exec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::exec <FETCH_B | HOLD_A>,
-                    &Blitter::exec <FETCH_C | HOLD_B>,
-                    &Blitter::exec <WRITE_D | REPEAT>,
-
-                    &Blitter::exec <HOLD_D>,
-                    &Blitter::exec <WRITE_D | BLTDONE>
-                }
-            },
-            {
-                {   // Fake execution, no fill
-                    &Blitter::fakeExec <FETCH_A | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_B>,
-                    &Blitter::fakeExec <WRITE_D | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>
-                },
-                {   // Fake execution, fill
-                    &Blitter::fakeExec <FETCH_A | FILL | HOLD_D>,
-                    &Blitter::fakeExec <FETCH_B | HOLD_A>,
-                    &Blitter::fakeExec <FETCH_C | HOLD_B>,
-                    &Blitter::fakeExec <WRITE_D | REPEAT>,
-
-                    &Blitter::fakeExec <HOLD_D>,
-                    &Blitter::fakeExec <WRITE_D | BLTDONE>
-                }
-            }
+        {   // Fill
+            FETCH_A | FILL | HOLD_D,
+            FETCH_B | HOLD_A,
+            FETCH_C | HOLD_B | REPEAT,
+
+            FILL | HOLD_D,
+            BLTDONE,
+            BLTDONE
+        }
+    },
+
+    // F: A0 B0 C0 -- A1 B1 C1 D0 A2 B2 C2 D1 | -- D2
+    {
+        {   // No fill
+            FETCH_A | HOLD_D,
+            FETCH_B | HOLD_A,
+            FETCH_C | HOLD_B,
+            WRITE_D | REPEAT,
+
+            HOLD_D,
+            WRITE_D | BLTDONE
+        },
+        {   // Fill
+            FETCH_A | FILL | HOLD_D,
+            FETCH_B | HOLD_A,
+            FETCH_C | HOLD_B,
+            WRITE_D | REPEAT,
+
+            HOLD_D,
+            WRITE_D | BLTDONE
         }
+    }
+};
+
+void
+Blitter::initSlowBlitter()
+{
+    /* Each micro program is executed by a specialized function that knows
+     * about the executed micro-instructions at compile time. For level 2
+     * blits, a separate version exists for ascending and descending mode.
+     */
+    void (Blitter::*copyBlitInstr[16][2][2])(void) = {
+
+        { { &Blitter::execCopyProgram<0,0,0>, &Blitter::execCopyProgram<0,0,1> },
+          { &Blitter::execCopyProgram<0,1,0>, &Blitter::execCopyProgram<0,1,1> } },
+        { { &Blitter::execCopyProgram<1,0,0>, &Blitter::execCopyProgram<1,0,1> },
+          { &Blitter::execCopyProgram<1,1,0>, &Blitter::execCopyProgram<1,1,1> } },
+        { { &Blitter::execCopyProgram<2,0,0>, &Blitter::execCopyProgram<2,0,1> },
+          { &Blitter::execCopyProgram<2,1,0>, &Blitter::execCopyProgram<2,1,1> } },
+        { { &Blitter::execCopyProgram<3,0,0>, &Blitter::execCopyProgram<3,0,1> },
+          { &Blitter::execCopyProgram<3,1,0>, &Blitter::execCopyProgram<3,1,1> } },
+        { { &Blitter::execCopyProgram<4,0,0>, &Blitter::execCopyProgram<4,0,1> },
+          { &Blitter::execCopyProgram<4,1,0>, &Blitter::execCopyProgram<4,1,1> } },
+        { { &Blitter::execCopyProgram<5,0,0>, &Blitter::execCopyProgram<5,0,1> },
+          { &Blitter::execCopyProgram<5,1,0>, &Blitter::execCopyProgram<5,1,1> } },
+        { { &Blitter::execCopyProgram<6,0,0>, &Blitter::execCopyProgram<6,0,1> },
+          { &Blitter::execCopyProgram<6,1,0>, &Blitter::execCopyProgram<6,1,1> } },
+        { { &Blitter::execCopyProgram<7,0,0>, &Blitter::execCopyProgram<7,0,1> },
+          { &Blitter::execCopyProgram<7,1,0>, &Blitter::execCopyProgram<7,1,1> } },
+        { { &Blitter::execCopyProgram<8,0,0>, &Blitter::execCopyProgram<8,0,1> },
+          { &Blitter::execCopyProgram<8,1,0>, &Blitter::execCopyProgram<8,1,1> } },
+        { { &Blitter::execCopyProgram<9,0,0>, &Blitter::execCopyProgram<9,0,1> },
+          { &Blitter::execCopyProgram<9,1,0>, &Blitter::execCopyProgram<9,1,1> } },
+        { { &Blitter::execCopyProgram<10,0,0>, &Blitter::execCopyProgram<10,0,1> },
+          { &Blitter::execCopyProgram<10,1,0>, &Blitter::execCopyProgram<10,1,1> } },
+        { { &Blitter::execCopyProgram<11,0,0>, &Blitter::execCopyProgram<11,0,1> },
+          { &Blitter::execCopyProgram<11,1,0>, &Blitter::execCopyProgram<11,1,1> } },
+        { { &Blitter::execCopyProgram<12,0,0>, &Blitter::execCopyProgram<12,0,1> },
+          { &Blitter::execCopyProgram<12,1,0>, &Blitter::execCopyProgram<12,1,1> } },
+        { { &Blitter::execCopyProgram<13,0,0>, &Blitter::execCopyProgram<13,0,1> },
+          { &Blitter::execCopyProgram<13,1,0>, &Blitter::execCopyProgram<13,1,1> } },
+        { { &Blitter::execCopyProgram<14,0,0>, &Blitter::execCopyProgram<14,0,1> },
+          { &Blitter::execCopyProgram<14,1,0>, &Blitter::execCopyProgram<14,1,1> } },
+        { { &Blitter::execCopyProgram<15,0,0>, &Blitter::execCopyProgram<15,0,1> },
+          { &Blitter::execCopyProgram<15,1,0>, &Blitter::execCopyProgram<15,1,1> } }
+    };
+
+    void (Blitter::*fakeCopyBlitInstr[16][2])(void) = {
+
+        { &Blitter::fakeExecCopyProgram<0,0>, &Blitter::fakeExecCopyProgram<0,1> },
+        { &Blitter::fakeExecCopyProgram<1,0>, &Blitter::fakeExecCopyProgram<1,1> },
+        { &Blitter::fakeExecCopyProgram<2,0>, &Blitter::fakeExecCopyProgram<2,1> },
+        { &Blitter::fakeExecCopyProgram<3,0>, &Blitter::fakeExecCopyProgram<3,1> },
+        { &Blitter::fakeExecCopyProgram<4,0>, &Blitter::fakeExecCopyProgram<4,1> },
+        { &Blitter::fakeExecCopyProgram<5,0>, &Blitter::fakeExecCopyProgram<5,1> },
+        { &Blitter::fakeExecCopyProgram<6,0>, &Blitter::fakeExecCopyProgram<6,1> },
+        { &Blitter::fakeExecCopyProgram<7,0>, &Blitter::fakeExecCopyProgram<7,1> },
+        { &Blitter::fakeExecCopyProgram<8,0>, &Blitter::fakeExecCopyProgram<8,1> },
+        { &Blitter::fakeExecCopyProgram<9,0>, &Blitter::fakeExecCopyProgram<9,1> },
+        { &Blitter::fakeExecCopyProgram<10,0>, &Blitter::fakeExecCopyProgram<10,1> },
+        { &Blitter::fakeExecCopyProgram<11,0>, &Blitter::fakeExecCopyProgram<11,1> },
+        { &Blitter::fakeExecCopyProgram<12,0>, &Blitter::fakeExecCopyProgram<12,1> },
+        { &Blitter::fakeExecCopyProgram<13,0>, &Blitter::fakeExecCopyProgram<13,1> },
+        { &Blitter::fakeExecCopyProgram<14,0>, &Blitter::fakeExecCopyProgram<14,1> },
+        { &Blitter::fakeExecCopyProgram<15,0>, &Blitter::fakeExecCopyProgram<15,1> }
     };
 
     /* The Line Blitter uses the same micro program in all situations.
@@ -837,6 +543,9 @@ Blitter::initSlowBlitter()
     assert(sizeof(this->copyBlitInstr) == sizeof(copyBlitInstr));
     memcpy(this->copyBlitInstr, copyBlitInstr, sizeof(copyBlitInstr));
 
+    assert(sizeof(this->fakeCopyBlitInstr) == sizeof(fakeCopyBlitInstr));
+    memcpy(this->fakeCopyBlitInstr, fakeCopyBlitInstr, sizeof(fakeCopyBlitInstr));
+
     assert(sizeof(this->lineBlitInstr) == sizeof(lineBlitInstr));
     memcpy(this->lineBlitInstr, lineBlitInstr, sizeof(lineBlitInstr));
 }
@@ -955,7 +664,54 @@ Blitter::beginSlowCopyBlit()
     }
 }
 
-template <u16 instr> void
+int
+Blitter::copyBlitCycles()
+{
+    const u16 *program = copyBlitProgram[bltconUSE()][bltconFE()];
+
+    // Locate the end of the main loop and the last instruction
+    int loop = 0, done = 0;
+    while (!(program[loop] & REPEAT)) loop++;
+    while (!(program[done] & BLTDONE)) done++;
+
+    return bltsizeH * bltsizeV * (loop + 1) + (done - loop);
+}
+
+template <u16 nr, bool fill, bool desc> void
+Blitter::execCopyProgram()
+{
+    switch (bltpc) {
+
+        case 0: exec <copyBlitProgram[nr][fill][0], desc> (); break;
+        case 1: exec <copyBlitProgram[nr][fill][1], desc> (); break;
+        case 2: exec <copyBlitProgram[nr][fill][2], desc> (); break;
+        case 3: exec <copyBlitProgram[nr][fill][3], desc> (); break;
+        case 4: exec <copyBlitProgram[nr][fill][4], desc> (); break;
+        case 5: exec <copyBlitProgram[nr][fill][5], desc> (); break;
+
+        default:
+            assert(false);
+    }
+}
+
+template <u16 nr, bool fill> void
+Blitter::fakeExecCopyProgram()
+{
+    switch (bltpc) {
+
+        case 0: fakeExec <copyBlitProgram[nr][fill][0]> (); break;
+        case 1: fakeExec <copyBlitProgram[nr][fill][1]> (); break;
+        case 2: fakeExec <copyBlitProgram[nr][fill][2]> (); break;
+        case 3: fakeExec <copyBlitProgram[nr][fill][3]> (); break;
+        case 4: fakeExec <copyBlitProgram[nr][fill][4]> (); break;
+        case 5: fakeExec <copyBlitProgram[nr][fill][5]> (); break;
+
+        default:
+            assert(false);
+    }
+}
+
+template <u16 instr, bool desc> void
 Blitter::exec()
 {
     bool bus, busidle;
@@ -1060,7 +816,7 @@ Blitter::exec()
 
         // Run the barrel shifters on data path A
         trace(BLT_DEBUG, "    ash = %d mask = %X\n", bltconASH(), mask);
-        if (bltconDESC()) {
+        if (desc) {
             ahold = HI_W_LO_W(anew & mask, aold) >> ash;
         } else {
             ahold = HI_W_LO_W(aold, anew & mask) >> ash;
@@ -1075,7 +831,7 @@ Blitter::exec()
 
         // Run the barrel shifters on data path B
         trace(BLT_DEBUG, "    bsh = %d\n", bltconBSH());
-        if (bltconDESC()) {
+        if (desc) {
             bhold = HI_W_LO_W(bnew, bold) >> bsh;
         } else {
             bhold = HI_W_LO_W(bold, bnew) >> bsh;
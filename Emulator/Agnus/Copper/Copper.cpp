@@ -18,6 +18,8 @@ void
 Copper::_reset(bool hard)
 {
     RESET_SNAPSHOT_ITEMS(hard)
+
+    flushCache();
 }
 
 void
@@ -52,6 +54,13 @@ Copper::_dump()
     msg("   cop2lc: %X\n", cop2lc);
     msg("  cop1end: %X\n", cop1end);
     msg("  cop2end: %X\n", cop2end);
+    msg("\n");
+    for (int i = 0; i < cacheSlots; i++) {
+        if (cache[i].size == 0) continue;
+        msg("    cache: %X - %X (%s)\n",
+            cache[i].start, cache[i].start + cache[i].size,
+            cache[i].compiled ? "compiled" : "watched");
+    }
 }
 
 void
@@ -509,6 +518,7 @@ Copper::vsyncHandler()
      *  automatically forced to restart its operations at the address contained
      *  in COP1LC." [HRM]
      */
+    updateCache();
     agnus.scheduleRel<COP_SLOT>(DMA_CYCLES(0), COP_VBLANK);
     
     if (COP_CHECKSUM) {
@@ -535,6 +545,141 @@ Copper::blitterDidTerminate()
     }
 }
 
+bool
+Copper::lookup(u32 addr, u16 &word)
+{
+    addr &= agnus.ptrMask;
+
+    // Check the list of the most recent hit first
+    CachedList *list = &cache[lastHit];
+
+    if (!list->compiled || addr - list->start >= list->size) {
+
+        int i;
+        for (i = 0; i < cacheSlots; i++) {
+            if (cache[i].compiled && addr - cache[i].start < cache[i].size) break;
+        }
+        if (i == cacheSlots) return false;
+
+        lastHit = i;
+        list = &cache[i];
+    }
+
+    word = list->words[(addr - list->start) >> 1];
+    return true;
+}
+
+void
+Copper::invalidate(i64 lo, i64 hi)
+{
+    for (int i = 0; i < cacheSlots; i++) {
+
+        if (cache[i].size == 0) continue;
+
+        i64 start = cache[i].start & mem.chipMask;
+        if (lo < start + cache[i].size && hi > start) {
+
+            trace(COP_DEBUG, "Dropping Copper list at %X\n", cache[i].start);
+            cache[i].size = 0;
+            cache[i].compiled = false;
+        }
+    }
+    updateGuard();
+}
+
+void
+Copper::flushCache()
+{
+    for (int i = 0; i < cacheSlots; i++) {
+
+        cache[i].size = 0;
+        cache[i].compiled = false;
+    }
+    updateGuard();
+}
+
+void
+Copper::updateCache()
+{
+    if (activeInThisFrame) {
+
+        updateCache(cop1lc, cop1end);
+        updateCache(cop2lc, cop2end);
+    }
+    updateGuard();
+}
+
+void
+Copper::updateCache(u32 lc, u32 end)
+{
+    u32 start = lc & agnus.ptrMask;
+    u32 size = (end & agnus.ptrMask) + 2 - start;
+
+    // Only cache lists of reasonable size that reside entirely in Chip Ram
+    if ((end & agnus.ptrMask) <= start || size > maxListSize) return;
+    if ((start & mem.chipMask) + size > mem.chipRamSize()) return;
+
+    if (mem.getMemSrc <AGNUS_ACCESS> (start) != MEM_CHIP) return;
+    if (mem.getMemSrc <AGNUS_ACCESS> (start + size - 2) != MEM_CHIP) return;
+
+    // Check if the list is already known
+    for (int i = 0; i < cacheSlots; i++) {
+
+        CachedList &list = cache[i];
+        if (list.size != size || list.start != start) continue;
+
+        // Compile the list if it hasn't been modified for an entire frame
+        if (!list.compiled) {
+
+            trace(COP_DEBUG, "Compiling Copper list at %X\n", start);
+
+            // Make sure the Blitter isn't writing into the list
+            blitter.joinBlit();
+
+            list.words.resize(size / 2);
+            for (u32 j = 0; j < size / 2; j++) {
+                list.words[j] = mem.spypeek16 <AGNUS_ACCESS> (start + 2 * j);
+            }
+            list.compiled = true;
+        }
+        list.frame = agnus.frame.nr;
+        return;
+    }
+
+    // Start watching the list in a free or the least recently used slot
+    int slot = 0;
+    for (int i = 1; i < cacheSlots; i++) {
+
+        if (cache[slot].size == 0) break;
+        if (cache[i].size == 0 || cache[i].frame < cache[slot].frame) slot = i;
+    }
+
+    trace(COP_DEBUG, "Watching Copper list at %X\n", start);
+
+    cache[slot].start = start;
+    cache[slot].size = size;
+    cache[slot].compiled = false;
+    cache[slot].frame = agnus.frame.nr;
+}
+
+void
+Copper::updateGuard()
+{
+    i64 lo = INT64_MAX, hi = 0;
+
+    for (int i = 0; i < cacheSlots; i++) {
+
+        if (cache[i].size == 0) continue;
+
+        i64 start = cache[i].start & mem.chipMask;
+        lo = MIN(lo, start);
+        hi = MAX(hi, start + cache[i].size);
+    }
+
+    guardStart = lo < hi ? (u32)lo : 0;
+    guardSize = lo < hi ? (u32)(hi - lo) : 0;
+}
+
 int
 Copper::instrCount(int nr)
 {
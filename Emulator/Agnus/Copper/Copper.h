@@ -59,6 +59,50 @@ class Copper : public AmigaComponent
     // Storage for disassembled instruction
     char disassembly[128];
 
+
+    //
+    // Compiled Copper lists
+    //
+
+    // Maximum number of cached Copper lists
+    static const int cacheSlots = 4;
+
+    // Maximum size of a cached Copper list in bytes
+    static const u32 maxListSize = 0x4000;
+
+    /* A Copper list that has been executed in a previous frame. After a list
+     * has been executed, it is watched for an entire frame. If no write to
+     * the list has been observed, it is compiled into a copy which is used
+     * to feed the Copper instead of Chip Ram. Writing into a watched or
+     * compiled list removes it from the cache.
+     */
+    struct CachedList {
+
+        // Location of the list (masked by agnus.ptrMask)
+        u32 start = 0;
+
+        // Size of the list in bytes (0 = slot is unused)
+        u32 size = 0;
+
+        // Indicates if the list has been compiled
+        bool compiled = false;
+
+        // The last frame the list has been executed in
+        i64 frame = 0;
+
+        // The compiled list
+        vector<u16> words;
+    };
+
+    CachedList cache[cacheSlots];
+
+    // The slot of the most recent cache hit
+    int lastHit = 0;
+
+    // Chip Ram region covering all cached lists
+    u32 guardStart = 0;
+    u32 guardSize = 0;
+
 public:
 
     // Indicates if Copper is currently servicing an event (for debugging only)
@@ -139,6 +183,7 @@ private:
     }
 
     size_t _size() override { COMPUTE_SNAPSHOT_SIZE }
+    // The Copper cache is flushed by class Amiga once loading has finished
     size_t _load(u8 *buffer) override { LOAD_SNAPSHOT_ITEMS }
     size_t _save(u8 *buffer) override { SAVE_SNAPSHOT_ITEMS }
 
@@ -207,6 +252,36 @@ private:
     void scheduleWaitWakeup(bool bfd);
 
 
+    //
+    // Caching Copper lists
+    //
+
+public:
+
+    /* Looks up a word in the compiled Copper lists. Returns false if the
+     * word isn't cached and needs to be fetched from memory.
+     */
+    bool lookup(u32 addr, u16 &word);
+
+    // Informs the Copper about a write into Chip Ram
+    void invalidate(u32 offset) {
+        if ((u32)(offset - guardStart) < guardSize) invalidate(offset, offset + 2);
+    }
+    void invalidate(i64 lo, i64 hi);
+
+    // Discards all cached Copper lists
+    void flushCache();
+
+private:
+
+    // Watches or compiles the Copper lists executed in the current frame
+    void updateCache();
+    void updateCache(u32 lc, u32 end);
+
+    // Recomputes the guard region
+    void updateGuard();
+
+
     //
     // Analyzing Copper instructions
     //
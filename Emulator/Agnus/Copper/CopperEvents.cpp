@@ -106,6 +106,7 @@ Copper::serviceEvent(EventID id)
             advancePC();
 
             if (COP_CHECKSUM) checksum = fnv_1a_it32(checksum, cop2ins);
+            dmaProfiler.copperDidMove();
 
             // Extract register number from the first instruction word
             reg = (cop1ins & 0x1FE);
@@ -148,7 +149,13 @@ Copper::serviceEvent(EventID id)
             if (COP_CHECKSUM) checksum = fnv_1a_it32(checksum, cop2ins);
 
             // Fork execution depending on the instruction type
-            schedule(isWaitCmd() ? COP_WAIT1 : COP_SKIP1);
+            if (isWaitCmd()) {
+                dmaProfiler.copperDidWait();
+                schedule(COP_WAIT1);
+            } else {
+                dmaProfiler.copperDidSkip();
+                schedule(COP_SKIP1);
+            }
             break;
 
         case COP_WAIT1:
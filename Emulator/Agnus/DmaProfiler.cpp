@@ -0,0 +1,318 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "Amiga.h"
+
+DmaProfiler::DmaProfiler(Amiga &ref) : AmigaComponent(ref)
+{
+    setDescription("DmaProfiler");
+
+    mach_timebase_info(&tb);
+
+    current = FrameRecord();
+    total = FrameRecord();
+}
+
+void
+DmaProfiler::setEnabled(bool value)
+{
+    if (enabled == value) return;
+
+    amiga.suspend();
+
+    if (value) clear();
+    enabled = value;
+    blitActive = false;
+
+    amiga.resume();
+}
+
+void
+DmaProfiler::clear()
+{
+    amiga.suspend();
+
+    synchronized {
+
+        current = FrameRecord();
+        current.profile.frame = agnus.frame.nr;
+        total = FrameRecord();
+        total.profile.frame = agnus.frame.nr;
+
+        w = 0;
+        count = 0;
+    }
+
+    amiga.resume();
+}
+
+int
+DmaProfiler::frameCount()
+{
+    int result;
+    synchronized { result = count; }
+    return result;
+}
+
+FrameProfile
+DmaProfiler::getFrame(int nr)
+{
+    FrameProfile result;
+
+    synchronized {
+
+        // The frame count may have changed since the caller has queried it
+        if (nr < 0 || nr >= count) return FrameProfile();
+        result = history[(w - 1 - nr + historySize) % historySize].profile;
+    }
+    return result;
+}
+
+FrameProfile
+DmaProfiler::getTotal()
+{
+    FrameProfile result;
+    synchronized { result = total.profile; }
+    return result;
+}
+
+vector<BlitProfile>
+DmaProfiler::getHistogram(int nr)
+{
+    vector<BlitProfile> result;
+
+    synchronized {
+
+        if (nr < 0 || nr >= count) return result;
+        result = sorted(history[(w - 1 - nr + historySize) % historySize].blits);
+    }
+    return result;
+}
+
+vector<BlitProfile>
+DmaProfiler::getTotalHistogram()
+{
+    vector<BlitProfile> result;
+    synchronized { result = sorted(total.blits); }
+    return result;
+}
+
+vector<BlitProfile>
+DmaProfiler::sorted(const map<u64, BlitProfile> &blits)
+{
+    vector<BlitProfile> result;
+
+    for (auto &it : blits) result.push_back(it.second);
+
+    std::stable_sort(result.begin(), result.end(),
+                     [](const BlitProfile &a, const BlitProfile &b) {
+        return a.cycles != b.cycles ? a.cycles > b.cycles : a.hostTime > b.hostTime;
+    });
+    return result;
+}
+
+void
+DmaProfiler::dumpJSON(FILE *file)
+{
+    synchronized {
+
+        fprintf(file, "{\n");
+        fprintf(file, "  \"total\": {\n");
+        dumpJSON(file, total.profile);
+        fprintf(file, ",\n");
+        dumpJSON(file, total.blits);
+        fprintf(file, "\n  },\n");
+        fprintf(file, "  \"frames\": [");
+
+        for (int i = count - 1; i >= 0; i--) {
+
+            FrameRecord &record = history[(w - 1 - i + historySize) % historySize];
+
+            fprintf(file, "%s\n  {\n", i == count - 1 ? "" : ",");
+            dumpJSON(file, record.profile);
+            fprintf(file, ",\n");
+            dumpJSON(file, record.blits);
+            fprintf(file, "\n  }");
+        }
+        fprintf(file, "\n  ]\n}\n");
+    }
+}
+
+bool
+DmaProfiler::dumpJSON(const char *path)
+{
+    FILE *file = fopen(path, "w");
+
+    if (file == NULL) {
+        warn("Failed to open %s\n", path);
+        return false;
+    }
+
+    dumpJSON(file);
+    fclose(file);
+    return true;
+}
+
+void
+DmaProfiler::dumpJSON(FILE *file, const FrameProfile &profile)
+{
+    fprintf(file, "    \"frame\": %lld,\n", (long long)profile.frame);
+    fprintf(file, "    \"blitter\": { \"blits\": %ld, \"cycles\": %lld, \"hostTime\": %lld, ",
+            profile.blits,
+            (long long)profile.blitCycles, (long long)profile.blitHostTime);
+    fprintf(file, "\"paths\": {");
+    for (int i = 0; i < BLIT_PATH_COUNT; i++) {
+        fprintf(file, "%s \"%s\": %ld", i ? "," : "",
+                blitPathName((BlitPath)i), profile.blitPaths[i]);
+    }
+    fprintf(file, " } },\n");
+    fprintf(file, "    \"copper\": { \"instructions\": %ld, \"moves\": %ld, ",
+            profile.copperMoves + profile.copperWaits + profile.copperSkips,
+            profile.copperMoves);
+    fprintf(file, "\"waits\": %ld, \"skips\": %ld, \"blocked\": %ld }",
+            profile.copperWaits, profile.copperSkips, profile.copperBlocked);
+}
+
+void
+DmaProfiler::dumpJSON(FILE *file, const map<u64, BlitProfile> &blits)
+{
+    vector<BlitProfile> histogram = sorted(blits);
+
+    fprintf(file, "    \"histogram\": [");
+
+    for (size_t i = 0; i < histogram.size(); i++) {
+
+        BlitProfile &b = histogram[i];
+
+        fprintf(file, "%s\n      { ", i ? "," : "");
+        fprintf(file, "\"bltcon0\": %u, \"bltcon1\": %u, ", b.bltcon0, b.bltcon1);
+        fprintf(file, "\"minterm\": %u, ", b.bltcon0 & 0xFF);
+        fprintf(file, "\"channels\": \"%s%s%s%s\", ",
+                (b.bltcon0 & 0x800) ? "A" : "",
+                (b.bltcon0 & 0x400) ? "B" : "",
+                (b.bltcon0 & 0x200) ? "C" : "",
+                (b.bltcon0 & 0x100) ? "D" : "");
+        fprintf(file, "\"line\": %s, ", (b.bltcon1 & 1) ? "true" : "false");
+        fprintf(file, "\"width\": %u, \"height\": %u, ", b.bltsizeH, b.bltsizeV);
+        fprintf(file, "\"path\": \"%s\", ", blitPathName(b.path));
+        fprintf(file, "\"count\": %ld, \"cycles\": %lld, \"hostTime\": %lld }",
+                b.count, (long long)b.cycles, (long long)b.hostTime);
+    }
+    fprintf(file, "%s]", histogram.empty() ? "" : "\n    ");
+}
+
+void
+DmaProfiler::blitterWillStart(u16 bltcon0, u16 bltcon1, u16 bltsizeH, u16 bltsizeV,
+                              int level)
+{
+    if (!enabled) return;
+
+    blit = BlitProfile();
+    blit.bltcon0 = bltcon0;
+    blit.bltcon1 = bltcon1;
+    blit.bltsizeH = bltsizeH;
+    blit.bltsizeV = bltsizeV;
+    blit.count = 1;
+
+    // There is no slow line Blitter. Level 2 line blits are faked
+    switch (level) {
+        case 0: blit.path = BLIT_PATH_FAST; break;
+        case 1: blit.path = BLIT_PATH_FAKE; break;
+        default: blit.path = (bltcon1 & 1) ? BLIT_PATH_FAKE : BLIT_PATH_SLOW;
+    }
+
+    blitActive = true;
+    blitStart = agnus.clock;
+    spanStart = mach_absolute_time();
+}
+
+void
+DmaProfiler::blitterDidJoin(u64 helperTime)
+{
+    if (!blitActive) return;
+
+    blit.path = BLIT_PATH_CONCURRENT;
+    addHostTime(helperTime);
+}
+
+void
+DmaProfiler::blitterDidTerminate()
+{
+    if (!blitActive) return;
+
+    endSpan();
+    blitActive = false;
+
+    blit.cycles = AS_DMA_CYCLES(agnus.clock - blitStart);
+    blit.hostTime = (i64)((u64)blit.hostTime * tb.numer / tb.denom);
+
+    add(current, blit);
+}
+
+void
+DmaProfiler::addHostTime(u64 kernelTime)
+{
+    blit.hostTime += kernelTime;
+}
+
+void
+DmaProfiler::add(FrameRecord &record, const BlitProfile &blit)
+{
+    // Compute the signature
+    u64 key =
+    (u64)blit.bltcon0 << 46 |
+    (u64)blit.bltcon1 << 30 |
+    (u64)blit.bltsizeV << 14 |
+    (u64)(blit.bltsizeH & 0xFFF) << 2 |
+    (u64)blit.path;
+
+    auto it = record.blits.find(key);
+
+    if (it == record.blits.end()) {
+        record.blits[key] = blit;
+    } else {
+        it->second.count += blit.count;
+        it->second.cycles += blit.cycles;
+        it->second.hostTime += blit.hostTime;
+    }
+
+    record.profile.blits += blit.count;
+    record.profile.blitCycles += blit.cycles;
+    record.profile.blitHostTime += blit.hostTime;
+    record.profile.blitPaths[blit.path] += blit.count;
+}
+
+void
+DmaProfiler::add(FrameRecord &record, const FrameRecord &frame)
+{
+    for (auto &it : frame.blits) add(record, it.second);
+
+    record.profile.copperMoves += frame.profile.copperMoves;
+    record.profile.copperWaits += frame.profile.copperWaits;
+    record.profile.copperSkips += frame.profile.copperSkips;
+    record.profile.copperBlocked += frame.profile.copperBlocked;
+}
+
+void
+DmaProfiler::vsyncHandler()
+{
+    if (!enabled) return;
+
+    synchronized {
+
+        add(total, current);
+
+        history[w] = std::move(current);
+        w = (w + 1) % historySize;
+        if (count < historySize) count++;
+
+        current = FrameRecord();
+        current.profile.frame = agnus.frame.nr;
+    }
+}
@@ -0,0 +1,179 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef _DMA_PROFILER_H
+#define _DMA_PROFILER_H
+
+#include "AmigaComponent.h"
+
+/* Records the workload of the Blitter and the Copper. For each blit, the
+ * control registers, the size, the execution path, the duration in DMA
+ * cycles, and the host time spent are recorded. For the Copper, the number of
+ * executed instructions and the number of cycles in which the Copper was
+ * blocked by another DMA channel are counted. At the end of each frame, the
+ * recorded data is condensed into a histogram which is kept for the most
+ * recent frames. In addition, an accumulated histogram covering all frames
+ * since profiling has been enabled is maintained. The data can be queried via
+ * the API or exported in JSON format.
+ */
+class DmaProfiler : public AmigaComponent {
+
+    // Number of frames kept in the history buffer
+    static const int historySize = 250;
+
+    struct FrameRecord {
+
+        FrameProfile profile;
+
+        // Blitter histogram (indexed by blit signature)
+        map<u64, BlitProfile> blits;
+    };
+
+    // Indicates if profiling is turned on or off
+    bool enabled = false;
+
+    // The frame currently being recorded
+    FrameRecord current;
+
+    // The most recently recorded frames (ring buffer)
+    FrameRecord history[historySize];
+
+    // Write pointer and fill level of the history buffer
+    int w = 0;
+    int count = 0;
+
+    // Accumulated values since profiling has been enabled
+    FrameRecord total;
+
+    // The blit currently in progress
+    BlitProfile blit;
+    bool blitActive = false;
+    Cycle blitStart;
+
+    // Start time of the current host time measurement
+    u64 spanStart;
+
+    // Conversion factors between kernel time and nanoseconds
+    mach_timebase_info_data_t tb;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    DmaProfiler(Amiga &ref);
+
+    void _reset(bool hard) override { blitActive = false; }
+
+
+    //
+    // Configuring
+    //
+
+public:
+
+    // Turns profiling on or off
+    bool isEnabled() { return enabled; }
+    void setEnabled(bool value);
+
+    // Discards all recorded data
+    void clear();
+
+
+    //
+    // Analyzing
+    //
+
+public:
+
+    // Returns the number of frames in the history buffer
+    int frameCount();
+
+    /* Returns the profile of a recorded frame. The most recent frame has
+     * number 0, the frame before number 1, and so on. If the frame is not
+     * recorded (anymore), an empty profile is returned.
+     */
+    FrameProfile getFrame(int nr);
+
+    // Returns the accumulated profile of all recorded frames
+    FrameProfile getTotal();
+
+    // Returns the Blitter histogram of a recorded frame (empty if unknown)
+    vector<BlitProfile> getHistogram(int nr);
+
+    /* Returns the accumulated Blitter histogram. The buckets are sorted by
+     * their total duration, with the most expensive bucket coming first.
+     */
+    vector<BlitProfile> getTotalHistogram();
+
+    // Exports all recorded data in JSON format
+    void dumpJSON(FILE *file);
+    bool dumpJSON(const char *path);
+
+private:
+
+    void dumpJSON(FILE *file, const FrameProfile &profile);
+    void dumpJSON(FILE *file, const map<u64, BlitProfile> &blits);
+
+    // Returns the histogram sorted by the total duration of each bucket
+    vector<BlitProfile> sorted(const map<u64, BlitProfile> &blits);
+
+
+    //
+    // Serializing
+    //
+
+private:
+
+    size_t _size() override { return 0; }
+    size_t _load(u8 *buffer) override { return 0; }
+    size_t _save(u8 *buffer) override { return 0; }
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    // Called by the Blitter when a blit starts
+    void blitterWillStart(u16 bltcon0, u16 bltcon1, u16 bltsizeH, u16 bltsizeV,
+                          int level);
+
+    // Called by the Blitter when a blit has been handed over to a helper thread
+    void blitterDidJoin(u64 helperTime);
+
+    // Called by the Blitter when a blit terminates
+    void blitterDidTerminate();
+
+    // Measures the host time spent inside the Blitter
+    void beginSpan() { if (blitActive) spanStart = mach_absolute_time(); }
+    void endSpan() { if (blitActive) addHostTime(mach_absolute_time() - spanStart); }
+
+    // Called by the Copper
+    void copperDidMove() { if (enabled) current.profile.copperMoves++; }
+    void copperDidWait() { if (enabled) current.profile.copperWaits++; }
+    void copperDidSkip() { if (enabled) current.profile.copperSkips++; }
+    void copperIsBlocked() { if (enabled) current.profile.copperBlocked++; }
+
+    // Finishes the current frame
+    void vsyncHandler();
+
+private:
+
+    void addHostTime(u64 kernelTime);
+
+    // Adds a blit or a frame to an accumulated record
+    void add(FrameRecord &record, const BlitProfile &blit);
+    void add(FrameRecord &record, const FrameRecord &frame);
+};
+
+#endif
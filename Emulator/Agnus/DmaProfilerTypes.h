@@ -0,0 +1,86 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+// This file must conform to standard ANSI-C to be compatible with Swift.
+
+#ifndef _DMA_PROFILER_TYPES_H
+#define _DMA_PROFILER_TYPES_H
+
+#include "Aliases.h"
+
+typedef VA_ENUM(long, BlitPath)
+{
+    BLIT_PATH_FAST,         // Level 0, executed by the emulator thread
+    BLIT_PATH_CONCURRENT,   // Level 0, executed by the helper thread
+    BLIT_PATH_FAKE,         // Level 1 (and level 2 line blits)
+    BLIT_PATH_SLOW,         // Level 2
+    BLIT_PATH_COUNT
+};
+
+static inline bool isBlitPath(long value)
+{
+    return value >= 0 && value < BLIT_PATH_COUNT;
+}
+
+static inline const char *blitPathName(BlitPath value)
+{
+    switch (value) {
+
+        case BLIT_PATH_FAST:       return "fast";
+        case BLIT_PATH_CONCURRENT: return "concurrent";
+        case BLIT_PATH_FAKE:       return "fake";
+        case BLIT_PATH_SLOW:       return "slow";
+        default:                   return "???";
+    }
+}
+
+/* A single bucket of a Blitter histogram. All blits sharing the same control
+ * registers, the same size, and the same execution path are accumulated in
+ * the same bucket. The minterm and the channel usage are part of bltcon0.
+ */
+typedef struct
+{
+    // Signature
+    u16 bltcon0;
+    u16 bltcon1;
+    u16 bltsizeH;
+    u16 bltsizeV;
+    BlitPath path;
+
+    // Number of blits
+    long count;
+
+    // Accumulated duration in DMA cycles
+    i64 cycles;
+
+    // Accumulated host time in nanoseconds
+    i64 hostTime;
+}
+BlitProfile;
+
+typedef struct
+{
+    // The profiled frame
+    i64 frame;
+
+    // Blitter workload
+    long blits;
+    i64 blitCycles;
+    i64 blitHostTime;
+    long blitPaths[BLIT_PATH_COUNT];
+
+    // Copper workload
+    long copperMoves;
+    long copperWaits;
+    long copperSkips;
+    long copperBlocked;
+}
+FrameProfile;
+
+#endif
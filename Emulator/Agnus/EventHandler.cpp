@@ -205,13 +205,14 @@ Agnus::inspectEventSlot(EventSlot nr)
 
             switch (slot[nr].id) {
 
-                case 0:             i->eventName = "none"; break;
-                case BLT_STRT1:     i->eventName = "BLT_STRT1"; break;
-                case BLT_STRT2:     i->eventName = "BLT_STRT2"; break;
-                case BLT_COPY_SLOW: i->eventName = "BLT_COPY_SLOW"; break;
-                case BLT_COPY_FAKE: i->eventName = "BLT_COPY_FAKE"; break;
-                case BLT_LINE_FAKE: i->eventName = "BLT_LINE_FAKE"; break;
-                default:            i->eventName = "*** INVALID ***"; break;
+                case 0:              i->eventName = "none"; break;
+                case BLT_STRT1:      i->eventName = "BLT_STRT1"; break;
+                case BLT_STRT2:      i->eventName = "BLT_STRT2"; break;
+                case BLT_COPY_SLOW:  i->eventName = "BLT_COPY_SLOW"; break;
+                case BLT_COPY_FAKE:  i->eventName = "BLT_COPY_FAKE"; break;
+                case BLT_LINE_FAKE:  i->eventName = "BLT_LINE_FAKE"; break;
+                case BLT_COPY_ASYNC: i->eventName = "BLT_COPY_ASYNC"; break;
+                default:             i->eventName = "*** INVALID ***"; break;
             }
             break;
 
@@ -407,6 +408,8 @@ Agnus::scheduleNextBplEvent(i16 hpos)
 {
     assert(isHPos(hpos));
 
+    if (bplDeferred) cancelDeferredBplEvents();
+
     if (u8 next = nextBplEvent[hpos]) {
         scheduleRel<BPL_SLOT>(DMA_CYCLES(next - pos.h), bplEvent[next]);
     }
@@ -419,6 +422,8 @@ Agnus::scheduleBplEventForCycle(i16 hpos)
     assert(isHPos(hpos));
     assert(hpos >= pos.h);
 
+    if (bplDeferred) cancelDeferredBplEvents();
+
     if (bplEvent[hpos] != EVENT_NONE) {
         scheduleRel<BPL_SLOT>(DMA_CYCLES(hpos - pos.h), bplEvent[hpos]);
     } else {
@@ -237,6 +237,7 @@ void executeEventsUntil(Cycle cycle);
 template <int nr> void serviceCIAEvent();
 void serviceREGEvent(Cycle until);
 void serviceBPLEvent();
+void serviceBPLEvent(EventID id);
 template <int nr> void serviceBPLEventHires();
 template <int nr> void serviceBPLEventLores();
 void serviceBPLEventLores();
@@ -177,6 +177,7 @@ typedef VA_ENUM(long, EventID)
     BLT_COPY_SLOW,
     BLT_COPY_FAKE,
     BLT_LINE_FAKE,
+    BLT_COPY_ASYNC,
     BLT_EVENT_COUNT,
         
     // SEC slot
@@ -286,6 +287,29 @@ static inline bool isBplxEvent(EventID id, int x)
     }
 }
 
+// Returns the bitplane a BPL event fetches data for (0 = no fetch)
+static inline int bplxEventNr(EventID id)
+{
+    switch(id & ~0b11) {
+
+        case BPL_L1: case BPL_H1: return 1;
+        case BPL_L2: case BPL_H2: return 2;
+        case BPL_L3: case BPL_H3: return 3;
+        case BPL_L4: case BPL_H4: return 4;
+        case BPL_L5:              return 5;
+        case BPL_L6:              return 6;
+
+        default:
+            return 0;
+    }
+}
+
+// Checks if a BPL event performs a hires fetch
+static inline bool isHiresBplEvent(EventID id)
+{
+    return (id & ~0b11) >= BPL_H1 && (id & ~0b11) <= BPL_H4;
+}
+
 // Inspection interval in seconds (interval between INS_xxx events)
 static const double inspectionInterval = 0.1;
 
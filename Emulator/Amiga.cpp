@@ -201,6 +201,7 @@ Amiga::getConfigItem(ConfigOption option)
         case OPT_CLX_SPR_SPR:
         case OPT_CLX_SPR_PLF:
         case OPT_CLX_PLF_PLF:
+        case OPT_RENDER_THREAD:
             return denise.getConfigItem(option);
             
         case OPT_RTC_MODEL:
@@ -235,6 +236,7 @@ Amiga::getConfigItem(ConfigOption option)
             return paula.muxer.getConfigItem(option);
 
         case OPT_BLITTER_ACCURACY:
+        case OPT_BLITTER_THREAD:
             return agnus.blitter.getConfigItem(option);
 
         case OPT_DRIVE_SPEED:
@@ -438,6 +440,9 @@ Amiga::_powerOff()
     // Update the recorded debug information
     inspect();
     
+    // Make all snapshots taken so far available to the GUI
+    snapshotWorker.flush();
+    
     messageQueue.put(MSG_POWER_OFF);
 }
 
@@ -496,6 +501,9 @@ Amiga::_pause()
     // Update the recorded debug information
     inspect();
 
+    // Make all snapshots taken so far available to the GUI
+    snapshotWorker.flush();
+
     // Inform the GUI
     messageQueue.put(MSG_PAUSE);
 }
@@ -701,17 +709,20 @@ Amiga::runLoop()
         // Check if special action needs to be taken
         if (runLoopCtrl) {
             
+            // Are there any recorded or replayed inputs to apply?
+            if (runLoopCtrl & RL_INPUT) {
+                inputRecorder.execute();
+            }
+
             // Are we requested to take a snapshot?
             if (runLoopCtrl & RL_AUTO_SNAPSHOT) {
                 trace(RUN_DEBUG, "RL_AUTO_SNAPSHOT\n");
-                autoSnapshot = Snapshot::makeWithAmiga(this);
-                messageQueue.put(MSG_AUTO_SNAPSHOT_TAKEN);
+                snapshotWorker.capture(MSG_AUTO_SNAPSHOT_TAKEN);
                 clearControlFlags(RL_AUTO_SNAPSHOT);
             }
             if (runLoopCtrl & RL_USER_SNAPSHOT) {
                 trace(RUN_DEBUG, "RL_USER_SNAPSHOT\n");
-                userSnapshot = Snapshot::makeWithAmiga(this);
-                messageQueue.put(MSG_USER_SNAPSHOT_TAKEN);
+                snapshotWorker.capture(MSG_USER_SNAPSHOT_TAKEN);
                 clearControlFlags(RL_USER_SNAPSHOT);
             }
 
@@ -750,6 +761,25 @@ Amiga::runLoop()
     }
 }
 
+void
+Amiga::executeFrame()
+{
+    assert(isPoweredOn());
+    assert(!isRunning());
+    
+    i64 frame = agnus.frame.nr;
+    
+    while (agnus.frame.nr == frame) {
+        
+        cpu.execute();
+        
+        // Feed in replayed inputs
+        if (runLoopCtrl & RL_INPUT) {
+            inputRecorder.execute();
+        }
+    }
+}
+
 void
 Amiga::restartTimer()
 {
@@ -807,8 +837,7 @@ Amiga::requestAutoSnapshot()
     if (!isRunning()) {
 
         // Take snapshot immediately
-        autoSnapshot = Snapshot::makeWithAmiga(this);
-        messageQueue.put(MSG_AUTO_SNAPSHOT_TAKEN);
+        snapshotWorker.capture(MSG_AUTO_SNAPSHOT_TAKEN);
         
     } else {
 
@@ -823,8 +852,7 @@ Amiga::requestUserSnapshot()
     if (!isRunning()) {
         
         // Take snapshot immediately
-        userSnapshot = Snapshot::makeWithAmiga(this);
-        messageQueue.put(MSG_USER_SNAPSHOT_TAKEN);
+        snapshotWorker.capture(MSG_USER_SNAPSHOT_TAKEN);
         
     } else {
         
@@ -836,36 +864,73 @@ Amiga::requestUserSnapshot()
 Snapshot *
 Amiga::latestAutoSnapshot()
 {
-    Snapshot *result = autoSnapshot;
-    autoSnapshot = NULL;
-    return result;
+    return snapshotWorker.latestAutoSnapshot();
 }
 
 Snapshot *
 Amiga::latestUserSnapshot()
 {
-    Snapshot *result = userSnapshot;
-    userSnapshot = NULL;
-    return result;
+    return snapshotWorker.latestUserSnapshot();
 }
 
 void
-Amiga::loadFromSnapshotUnsafe(Snapshot *snapshot)
+Amiga::loadFromSnapshotUnsafe(Snapshot *snapshot,
+                              const vector<HardwareComponent *> &selection)
 {
     u8 *ptr;
     
     if (snapshot && (ptr = snapshot->getData())) {
-        load(ptr);
+        
+        NativeByteOrder order(snapshot->isNative());
+        DiskReferences references(snapshot->hasDiskReferences());
+
+        // Chip Ram must not be overwritten while the helper thread is blitting
+        agnus.blitter.joinBlit();
+        
+        if (isSectioned(ptr)) {
+
+            if (!loadSections(ptr, snapshot->getDataSize(), selection)) {
+                warn("Failed to restore snapshot\n");
+                return;
+            }
+        } else {
+            if (!selection.empty()) {
+                warn("Snapshot has no sections. Can't restore a selection\n");
+                return;
+            }
+            serLoadError = false;
+            load(ptr);
+
+            if (serLoadError) {
+                warn("Failed to restore snapshot\n");
+                HardwareComponent::reset(true);
+                return;
+            }
+        }
+
+        // Cached Copper lists are outdated now (Chip Ram is fully restored)
+        agnus.copper.flushCache();
+
         messageQueue.put(MSG_SNAPSHOT_RESTORED);
     }
 }
 
 void
-Amiga::loadFromSnapshotSafe(Snapshot *snapshot)
+Amiga::findDivergences(Amiga &other, vector<HardwareComponent *> &result)
+{
+    agnus.blitter.joinBlit();
+    other.agnus.blitter.joinBlit();
+
+    HardwareComponent::findDivergences(other, result);
+}
+
+void
+Amiga::loadFromSnapshotSafe(Snapshot *snapshot,
+                            const vector<HardwareComponent *> &selection)
 {
     trace(SNP_DEBUG, "loadFromSnapshotSafe\n");
     
     suspend();
-    loadFromSnapshotUnsafe(snapshot);
+    loadFromSnapshotUnsafe(snapshot, selection);
     resume();
 }
@@ -25,6 +25,7 @@
 #include "Denise.h"
 #include "Disk.h"
 #include "Drive.h"
+#include "InputRecorder.h"
 #include "Joystick.h"
 #include "Keyboard.h"
 #include "Memory.h"
@@ -56,6 +57,9 @@
  */
 class Amiga : public HardwareComponent {
 
+    // Switches warp mode from inside the run loop when a replay is over
+    friend class InputRecorder;
+    
     /* The inspection target. In order to update the GUI periodically, the
      * emulator schedules this event in the inspector slot (INS_SLOT in the
      * secondary table) on a periodic basis. If the event is EVENT_NONE, no
@@ -172,8 +176,21 @@ private:
     
 private:
     
-    Snapshot *autoSnapshot = NULL;
-    Snapshot *userSnapshot = NULL;
+    /* Snapshots are finalized in the background to keep the emulator thread
+     * from stalling. The worker also stores the latest snapshots until they
+     * are picked up by the GUI.
+     */
+    SnapshotWorker snapshotWorker = SnapshotWorker(*this);
+
+    
+    //
+    // Input recording
+    //
+    
+public:
+    
+    // Records or replays all external inputs
+    InputRecorder inputRecorder = InputRecorder(*this);
 
     
     //
@@ -257,6 +274,20 @@ private:
     size_t _load(u8 *buffer) override { LOAD_SNAPSHOT_ITEMS }
     size_t _save(u8 *buffer) override { SAVE_SNAPSHOT_ITEMS }
 
+public:
+
+    /* The following functions shadow their counterparts in HardwareComponent.
+     * Before the state is measured, saved, or hashed, a blit running on the
+     * Blitter's helper thread is joined. Otherwise, the Memory section would
+     * copy Chip Ram while the helper thread is still writing into it.
+     */
+    size_t size() { agnus.blitter.joinBlit(); return HardwareComponent::size(); }
+    size_t save(u8 *buffer) { agnus.blitter.joinBlit(); return HardwareComponent::save(buffer); }
+    size_t sectionedSize() { agnus.blitter.joinBlit(); return HardwareComponent::sectionedSize(); }
+    size_t saveSections(u8 *buffer) { agnus.blitter.joinBlit(); return HardwareComponent::saveSections(buffer); }
+    u64 hashState() { agnus.blitter.joinBlit(); return HardwareComponent::hashState(); }
+    void findDivergences(Amiga &other, vector<HardwareComponent *> &result);
+
 
     //
     // Controlling
@@ -354,6 +385,12 @@ public:
      */
     void stepOver();
     
+    /* Emulates the remaining part of the current frame on the calling thread.
+     * The emulator must be powered on, but must not be running. This function
+     * is used to run multiple Amigas in lockstep.
+     */
+    void executeFrame();
+    
     /* The thread enter function. This (private) method is invoked when the
      * emulator thread launches. It has to be declared public to make it
      * accessible by the emulator thread.
@@ -430,10 +467,14 @@ public:
     /* Loads the current state from a snapshot file. There is an thread-unsafe
      * and thread-safe version of this function. The first one can be unsed
      * inside the emulator thread or from outside if the emulator is halted.
-     * The second one can be called any time.
+     * The second one can be called any time. If a selection of components is
+     * provided, only those components are restored (e.g., { &mem } restores
+     * memory and keeps the current state of all other components).
      */
-    void loadFromSnapshotUnsafe(Snapshot *snapshot);
-    void loadFromSnapshotSafe(Snapshot *snapshot);
+    void loadFromSnapshotUnsafe(Snapshot *snapshot,
+                                const vector<HardwareComponent *> &selection = {});
+    void loadFromSnapshotSafe(Snapshot *snapshot,
+                              const vector<HardwareComponent *> &selection = {});
 };
 
 #endif
@@ -17,7 +17,7 @@
 // Snapshot version number
 #define V_MAJOR 0
 #define V_MINOR 9
-#define V_SUBMINOR 14
+#define V_SUBMINOR 16
 
 // Uncomment these settings in a release build
 // #define RELEASEBUILD
@@ -90,6 +90,7 @@ static const int FAS_DEBUG       = 0; // Fast RAM
 static const int DMA_DEBUG       = 0; // DMA registers
 static const int DDF_DEBUG       = 0; // Display data fetch
 static const int NO_PTR_DROPS    = 0; // Never drop a pointer register write
+static const int NO_BPL_BATCHING = 0; // Service each bitplane event in its own DMA cycle
 
 // Copper
 static const int COP_CHECKSUM    = 0; // Compute Copper checksums
@@ -155,5 +156,6 @@ static const int HOLD_MOUSE_R    = 0; // Hold down the right mouse button
 static const int RTC_DEBUG       = 0; // Real-time clock
 static const int KBD_DEBUG       = 0; // Keyboard
 static const int REC_DEBUG       = 0; // Screen recorder
+static const int INP_DEBUG       = 0; // Input recorder
 
 #endif
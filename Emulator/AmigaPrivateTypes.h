@@ -13,5 +13,6 @@
 #include "AgnusPrivateTypes.h"
 #include "PaulaPrivateTypes.h"
 #include "KeyboardPrivateTypes.h"
+#include "InputRecorderPrivateTypes.h"
 
 #endif
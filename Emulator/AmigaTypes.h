@@ -20,6 +20,7 @@
 #include "DeniseTypes.h"
 #include "DiskTypes.h"
 #include "DmaDebuggerTypes.h"
+#include "DmaProfilerTypes.h"
 #include "DriveTypes.h"
 #include "EventHandlerTypes.h"
 #include "FileTypes.h"
@@ -79,9 +80,13 @@ typedef VA_ENUM(long, ConfigOption)
     OPT_CLX_SPR_SPR,
     OPT_CLX_SPR_PLF,
     OPT_CLX_PLF_PLF,
+
+    // Pixel engine
+    OPT_RENDER_THREAD,
         
     // Blitter
     OPT_BLITTER_ACCURACY,
+    OPT_BLITTER_THREAD,
     
     // CIAs
     OPT_TODBUG,
@@ -122,12 +127,13 @@ inline bool isEmulatorState(long value) {
 
 typedef VA_ENUM(u32, RunLoopControlFlag)
 {
-    RL_STOP               = 0b000001,
-    RL_INSPECT            = 0b000010,
-    RL_BREAKPOINT_REACHED = 0b000100,
-    RL_WATCHPOINT_REACHED = 0b001000,
-    RL_AUTO_SNAPSHOT      = 0b010000,
-    RL_USER_SNAPSHOT      = 0b100000
+    RL_STOP               = 0b0000001,
+    RL_INSPECT            = 0b0000010,
+    RL_BREAKPOINT_REACHED = 0b0000100,
+    RL_WATCHPOINT_REACHED = 0b0001000,
+    RL_AUTO_SNAPSHOT      = 0b0010000,
+    RL_USER_SNAPSHOT      = 0b0100000,
+    RL_INPUT              = 0b1000000
 };
 
 typedef VA_ENUM(long, ErrorCode)
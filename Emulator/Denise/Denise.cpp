@@ -26,6 +26,10 @@ Denise::Denise(Amiga& ref) : AmigaComponent(ref)
     config.clxSprSpr = true;
     config.clxSprPlf = true;
     config.clxPlfPlf = true;
+    config.renderThread = false;
+
+    static std::once_flag once;
+    std::call_once(once, initTranslationTables);
 }
 
 void
@@ -34,6 +38,8 @@ Denise::_reset(bool hard)
     RESET_SNAPSHOT_ITEMS(hard)
     
     memset(bBuffer, 0, sizeof(bBuffer));
+    bBufferFirst = sizeof(bBuffer);
+    bBufferLast = 0;
     memset(iBuffer, 0, sizeof(iBuffer));
     memset(mBuffer, 0, sizeof(mBuffer));
     memset(zBuffer, 0, sizeof(zBuffer));
@@ -51,6 +57,7 @@ Denise::getConfigItem(ConfigOption option)
         case OPT_CLX_SPR_SPR:         return config.clxSprSpr;
         case OPT_CLX_SPR_PLF:         return config.clxSprPlf;
         case OPT_CLX_PLF_PLF:         return config.clxPlfPlf;
+        case OPT_RENDER_THREAD:       return config.renderThread;
             
         default: assert(false);
     }
@@ -128,6 +135,16 @@ Denise::setConfigItem(ConfigOption option, long value)
             config.clxPlfPlf = value;
             return true;
 
+        case OPT_RENDER_THREAD:
+
+            if (config.renderThread == value) {
+                return false;
+            }
+
+            config.renderThread = value;
+            pixelEngine.setRenderThread(value);
+            return true;
+
         default:
             return false;
     }
@@ -173,6 +190,7 @@ Denise::_dumpConfig()
     msg("       clxSprSpr: $%x\n", config.clxSprSpr);
     msg("       clxSprPlf: $%x\n", config.clxSprPlf);
     msg("       clxPlfPlf: $%x\n", config.clxPlfPlf);
+    msg("    renderThread: %s\n", config.renderThread ? "yes" : "no");
 }
 
 void
@@ -242,28 +260,8 @@ Denise::fillShiftRegisters(bool odd, bool even)
         case 1: shiftReg[0] = bpldat[0];
     }
     
-    // On Intel machines, call the optimized SSE code
-    #if defined(__i386__) || defined(__x86_64__)
-    
-    if (!NO_SSE) {
-        transposeSSE(shiftReg, slice);
-        return;
-    }
-    
-    #endif
-    
-    // On all other machines, fallback to the slower standard implementation
-    u32 mask = 0x8000;
-    for (int i = 0; i < 16; i++, mask >>= 1) {
-        
-        slice[i] =
-        (!!(shiftReg[0] & mask) << 0) |
-        (!!(shiftReg[1] & mask) << 1) |
-        (!!(shiftReg[2] & mask) << 2) |
-        (!!(shiftReg[3] & mask) << 3) |
-        (!!(shiftReg[4] & mask) << 4) |
-        (!!(shiftReg[5] & mask) << 5);
-    }
+    // Convert the bitplane data into chunky pixels
+    planarToChunky(shiftReg, slice);
 }
 
 template <bool hiresMode> void
@@ -282,30 +280,24 @@ Denise::drawOdd(int offset)
        0b010101          // 6 bitplanes
     };
     
-    u16 mask = masks[bpu()];
+    u8 mask = masks[bpu()];
     i16 currentPixel = agnus.ppos() + offset;
     
-    for (int i = 0; i < 16; i++) {
+    if (hiresMode) {
         
-        u8 index = slice[i] & mask;
+        // Synthesize 16 hires pixels
+        assert(currentPixel + 15 < sizeof(bBuffer));
+        mergeHires(bBuffer + currentPixel, slice, 0b101010, mask);
         
-        if (hiresMode) {
-            
-            // Synthesize one hires pixel
-            assert(currentPixel < sizeof(bBuffer));
-            bBuffer[currentPixel] = (bBuffer[currentPixel] & 0b101010) | index;
-            currentPixel++;
-            
-        } else {
-            
-            // Synthesize two lores pixels
-            assert(currentPixel + 1 < sizeof(bBuffer));
-            bBuffer[currentPixel] = (bBuffer[currentPixel] & 0b101010) | index;
-            currentPixel++;
-            bBuffer[currentPixel] = (bBuffer[currentPixel] & 0b101010) | index;
-            currentPixel++;
-        }
+    } else {
+        
+        // Synthesize 32 lores pixels
+        assert(currentPixel + 31 < sizeof(bBuffer));
+        mergeLores(bBuffer + currentPixel, slice, 0b101010, mask);
     }
+
+    // Remember the range of synthesized pixels (see lineSignature())
+    extendBBufferRange<hiresMode>(currentPixel);
  
     // Disarm and clear the shift registers
     armedOdd = false;
@@ -328,30 +320,24 @@ Denise::drawEven(int offset)
        0b101010          // 6 bitplanes
     };
     
-    u16 mask = masks[bpu()];
+    u8 mask = masks[bpu()];
     i16 currentPixel = agnus.ppos() + offset;
     
-    for (int i = 0; i < 16; i++) {
-
-        u8 index = slice[i] & mask;
-
-        if (hiresMode) {
-            
-            // Synthesize one hires pixel
-            assert(currentPixel < sizeof(bBuffer));
-            bBuffer[currentPixel] = (bBuffer[currentPixel] & 0b010101) | index;
-            currentPixel++;
-
-        } else {
-            
-            // Synthesize two lores pixels
-            assert(currentPixel + 1 < sizeof(bBuffer));
-            bBuffer[currentPixel] = (bBuffer[currentPixel] & 0b010101) | index;
-            currentPixel++;
-            bBuffer[currentPixel] = (bBuffer[currentPixel] & 0b010101) | index;
-            currentPixel++;
-        }
+    if (hiresMode) {
+        
+        // Synthesize 16 hires pixels
+        assert(currentPixel + 15 < sizeof(bBuffer));
+        mergeHires(bBuffer + currentPixel, slice, 0b010101, mask);
+        
+    } else {
+        
+        // Synthesize 32 lores pixels
+        assert(currentPixel + 31 < sizeof(bBuffer));
+        mergeLores(bBuffer + currentPixel, slice, 0b010101, mask);
     }
+
+    // Remember the range of synthesized pixels (see lineSignature())
+    extendBBufferRange<hiresMode>(currentPixel);
  
     // Disarm and clear the shift registers
     armedEven = false;
@@ -371,27 +357,24 @@ Denise::drawBoth(int offset)
         0b111111          // 6 bitplanes
     };
     
-    u16 mask = masks[bpu()];
+    u8 mask = masks[bpu()];
     i16 currentPixel = agnus.ppos() + offset;
     
-    for (int i = 0; i < 16; i++) {
+    if (hiresMode) {
         
-        u8 index = slice[i] & mask;
+        // Synthesize 16 hires pixels
+        assert(currentPixel + 15 < sizeof(bBuffer));
+        mergeHires(bBuffer + currentPixel, slice, 0, mask);
         
-        if (hiresMode) {
-            
-            // Synthesize one hires pixel
-            assert(currentPixel < sizeof(bBuffer));
-            bBuffer[currentPixel++] = index;
-            
-        } else {
-            
-            // Synthesize two lores pixels
-            assert(currentPixel + 1 < sizeof(bBuffer));
-            bBuffer[currentPixel++] = index;
-            bBuffer[currentPixel++] = index;
-        }
+    } else {
+        
+        // Synthesize 32 lores pixels
+        assert(currentPixel + 31 < sizeof(bBuffer));
+        mergeLores(bBuffer + currentPixel, slice, 0, mask);
     }
+
+    // Remember the range of synthesized pixels (see lineSignature())
+    extendBBufferRange<hiresMode>(currentPixel);
     
     // Disarm and clear the shift registers
     armedEven = armedOdd = false;
@@ -439,7 +422,6 @@ Denise::translate()
     bool dual = dbplf(bplcon0);
 
     u16 bplcon2 = initialBplcon2;
-    bool pri = PF2PRI(bplcon2);
     prio1 = zPF1(bplcon2);
     prio2 = zPF2(bplcon2);
 
@@ -453,11 +435,7 @@ Denise::translate()
         RegChange &change = conChanges.elements[i];
 
         // Translate a chunk of bitplane data
-        if (dual) {
-            translateDPF(pri, pixel, trigger);
-        } else {
-            translateSPF(pixel, trigger);
-        }
+        translate(translationTable(dual, bplcon2), pixel, trigger);
         pixel = trigger;
 
         // Apply the register change
@@ -470,7 +448,6 @@ Denise::translate()
 
             case SET_BPLCON2:
                 bplcon2 = change.value;
-                pri = PF2PRI(bplcon2);
                 prio1 = zPF1(bplcon2);
                 prio2 = zPF2(bplcon2);
                 break;
@@ -486,87 +463,144 @@ Denise::translate()
 }
 
 void
-Denise::translateSPF(int from, int to)
+Denise::translate(int table, int from, int to)
 {
-    // The usual case: prio2 is a valid value
-    if (prio2) {
-        for (int i = from; i < to; i++) {
+    assert(table >= 0 && table < 256);
+    assert(to <= (int)sizeof(bBuffer));
 
-            u8 s = bBuffer[i];
+    if (from >= to) return;
 
-            assert(PixelEngine::isRgbaIndex(s));
-            iBuffer[i] = mBuffer[i] = s;
-            zBuffer[i] = s ? prio2 : 0;
-        }
+    translate8(iBuffer + from, bBuffer + from, indexTable[table], to - from);
+    translate16(zBuffer + from, bBuffer + from, depthTable[table], to - from);
+    memcpy(mBuffer + from, iBuffer + from, to - from);
+}
 
-    // The unusual case: prio2 is ivalid
-    } else {
+u64
+Denise::lineSignature()
+{
+    // Only lines without sprites and debug overlays are cached
+    if (wasArmed || config.hiddenLayers || dmaDebugger.isEnabled()) return 0;
+
+    // Hash the bitplane data (all other bBuffer elements are zero)
+    u64 result = fnv_1a_it64(fnv_1a_init64(), bBufferFirst);
+    result = fnv_1a_it64(result, bBufferLast);
+    if (bBufferFirst < bBufferLast) {
+        result = fnv_1a_it64(result, fnv_1a_64x4(bBuffer + bBufferFirst,
+                                                 bBufferLast - bBufferFirst));
+    }
 
-        for (int i = from; i < to; i++) {
+    // Add the registers affecting the translation
+    result = fnv_1a_it64(result, initialBplcon0);
+    result = fnv_1a_it64(result, initialBplcon2);
+    result = conChanges.checksum(result);
 
-             u8 s = bBuffer[i];
+    // Add the parameters affecting the border
+    result = fnv_1a_it64(result, borderColor);
+    result = fnv_1a_it64(result, agnus.diwVFlop);
+    result = fnv_1a_it64(result, agnus.diwHFlop);
+    result = fnv_1a_it64(result, (u16)agnus.diwHFlopOn);
+    result = fnv_1a_it64(result, (u16)agnus.diwHFlopOff);
 
-             assert(PixelEngine::isRgbaIndex(s));
-             iBuffer[i] = mBuffer[i] = (s & 16) ? 16 : s;
-             zBuffer[i] = 0;
-         }
-    }
+    // Add the color registers
+    result = fnv_1a_it64(result, pixelEngine.colorSignature());
+
+    return result ? result : 1;
 }
 
 void
-Denise::translateDPF(bool pf2pri, int from, int to)
+Denise::skipTranslation()
 {
-    pf2pri ? translateDPF<true>(from, to) : translateDPF<false>(from, to);
+    u16 bplcon2 = initialBplcon2;
+
+    for (int i = conChanges.begin(); i != conChanges.end(); i = conChanges.next(i)) {
+        if (conChanges.elements[i].addr == SET_BPLCON2) {
+            bplcon2 = conChanges.elements[i].value;
+        }
+    }
+    prio1 = zPF1(bplcon2);
+    prio2 = zPF2(bplcon2);
+
+    conChanges.clear();
 }
 
-template <bool pf2pri> void
-Denise::translateDPF(int from, int to)
+u8 Denise::indexTable[256][64];
+u16 Denise::depthTable[256][64];
+
+void
+Denise::initTranslationTables()
 {
-    /* If the priority of a playfield is set to an illegal value (prio1 or
-     * prio2 will be 0 in that case), all pixels are drawn transparent.
-     */
-    u8 mask1 = prio1 ? 0b1111 : 0b0000;
-    u8 mask2 = prio2 ? 0b1111 : 0b0000;
+    for (int dual = 0; dual < 2; dual++) {
+        for (u16 bplcon2 = 0; bplcon2 < 128; bplcon2++) {
 
-    for (int i = from; i < to; i++) {
+            u8 *index = indexTable[translationTable(dual, bplcon2)];
+            u16 *depth = depthTable[translationTable(dual, bplcon2)];
 
-        u8 s = bBuffer[i];
+            bool pf2pri = PF2PRI(bplcon2);
+            u16 z1 = zPF1(bplcon2);
+            u16 z2 = zPF2(bplcon2);
 
-        // Determine color indices for both playfields
-        u8 index1 = (((s & 1) >> 0) | ((s & 4) >> 1) | ((s & 16) >> 2));
-        u8 index2 = (((s & 2) >> 1) | ((s & 8) >> 2) | ((s & 32) >> 3));
+            for (u8 s = 0; s < 64; s++) {
 
-        if (index1) {
-            if (index2) {
+                assert(PixelEngine::isRgbaIndex(s));
 
-                // PF1 is solid, PF2 is solid
-                if (pf2pri) {
-                    iBuffer[i] = mBuffer[i] = (index2 | 0b1000) & mask2;
-                    zBuffer[i] = prio2 | Z_DPF21;
-                } else {
-                    iBuffer[i] = mBuffer[i] = index1 & mask1;
-                    zBuffer[i] = prio1 | Z_DPF12;
+                // Single-playfield mode
+                if (!dual) {
+
+                    // If z2 is invalid, bitplane 5 is ignored
+                    if (z2) {
+                        index[s] = s;
+                        depth[s] = s ? z2 : 0;
+                    } else {
+                        index[s] = (s & 16) ? 16 : s;
+                        depth[s] = 0;
+                    }
+                    continue;
                 }
 
-            } else {
+                /* Dual-playfield mode. If the priority of a playfield is set
+                 * to an illegal value (z1 or z2 will be 0 in that case),
+                 * all pixels are drawn transparent.
+                 */
+                u8 mask1 = z1 ? 0b1111 : 0b0000;
+                u8 mask2 = z2 ? 0b1111 : 0b0000;
 
-                // PF1 is solid, PF2 is transparent
-                iBuffer[i] = mBuffer[i] = index1 & mask1;
-                zBuffer[i] = prio1 | Z_DPF1;
-            }
+                // Determine color indices for both playfields
+                u8 index1 = (((s & 1) >> 0) | ((s & 4) >> 1) | ((s & 16) >> 2));
+                u8 index2 = (((s & 2) >> 1) | ((s & 8) >> 2) | ((s & 32) >> 3));
 
-        } else {
-            if (index2) {
+                if (index1) {
+                    if (index2) {
+
+                        // PF1 is solid, PF2 is solid
+                        if (pf2pri) {
+                            index[s] = (index2 | 0b1000) & mask2;
+                            depth[s] = z2 | Z_DPF21;
+                        } else {
+                            index[s] = index1 & mask1;
+                            depth[s] = z1 | Z_DPF12;
+                        }
 
-                // PF1 is transparent, PF2 is solid
-                iBuffer[i] = mBuffer[i] = (index2 | 0b1000) & mask2;
-                zBuffer[i] = prio2 | Z_DPF2;
+                    } else {
 
-            } else {
+                        // PF1 is solid, PF2 is transparent
+                        index[s] = index1 & mask1;
+                        depth[s] = z1 | Z_DPF1;
+                    }
 
-                // PF1 is transparent, PF2 is transparent
-                iBuffer[i] = mBuffer[i] = 0;
-                zBuffer[i] = Z_DPF;
+                } else {
+                    if (index2) {
+
+                        // PF1 is transparent, PF2 is solid
+                        index[s] = (index2 | 0b1000) & mask2;
+                        depth[s] = z2 | Z_DPF2;
+
+                    } else {
+
+                        // PF1 is transparent, PF2 is transparent
+                        index[s] = 0;
+                        depth[s] = Z_DPF;
+                    }
+                }
             }
         }
     }
@@ -577,6 +611,9 @@ Denise::drawSprites()
 {
     if (wasArmed) {
         
+        // Reset the collision masks
+        memset(sprMask, 0, sizeof(sprMask));
+
         if (wasArmed & 0b11000000) drawSpritePair<3>();
         if (wasArmed & 0b00110000) drawSpritePair<2>();
         if (wasArmed & 0b00001100) drawSpritePair<1>();
@@ -829,6 +866,8 @@ Denise::drawSpritePixel(int hpos)
         if (z > zBuffer[hpos + 1]) mBuffer[hpos + 1] = base | col;
         zBuffer[hpos] |= z;
         zBuffer[hpos + 1] |= z;
+        setSprMask<x>(hpos);
+        setSprMask<x>(hpos + 1);
     }
 }
 
@@ -857,10 +896,12 @@ Denise::drawAttachedSpritePixelPair(int hpos)
         if (z > zBuffer[hpos]) {
             mBuffer[hpos] = 0b10000 | col;
             zBuffer[hpos] |= z;
+            setSprMask<x>(hpos);
         }
         if (z > zBuffer[hpos+1]) {
             mBuffer[hpos+1] = 0b10000 | col;
             zBuffer[hpos+1] |= z;
+            setSprMask<x>(hpos + 1);
         }
     }
 }
@@ -923,104 +964,99 @@ Denise::drawBorder()
 #endif
 }
 
+u32
+Denise::clxWindow(const u64 *mask, int pos)
+{
+    assert(pos >= 0 && (pos >> 6) + 1 < clxWords);
+
+    int word = pos >> 6;
+    int shift = pos & 63;
+
+    u64 bits = shift ? (mask[word] >> shift) | (mask[word + 1] << (64 - shift)) : mask[word];
+    return (u32)bits & 0xAAAAAAAA;
+}
+
 template <int x> void
 Denise::checkS2SCollisions(int start, int end)
 {
+    assert(end == start + 31);
+
     // For the odd sprites, only proceed if collision detection is enabled
     if (IS_ODD(x) && !GET_BIT(clxcon, 12 + (x/2))) return;
 
-    // Set up the sprite comparison masks
-    u16 comp01 = Z_SP0 | (GET_BIT(clxcon, 12) ? Z_SP1 : 0);
-    u16 comp23 = Z_SP2 | (GET_BIT(clxcon, 13) ? Z_SP3 : 0);
-    u16 comp45 = Z_SP4 | (GET_BIT(clxcon, 14) ? Z_SP5 : 0);
-    u16 comp67 = Z_SP6 | (GET_BIT(clxcon, 15) ? Z_SP7 : 0);
-
-    // Iterate over all sprite pixels
-    for (int pos = end; pos >= start; pos -= 2) {
-
-        u16 z = zBuffer[pos];
-        
-        // Skip if there are no other sprites at this pixel coordinate
-        if (!(z & (Z_SP01234567 ^ Z_SP[x]))) continue;
-
-        // Skip if the sprite is transparent at this pixel coordinate
-        if (!(z & Z_SP[x])) continue;
-
-        // Set sprite collision bits
-        if ((z & comp45) && (z & comp67)) SET_BIT(clxdat, 14);
-        if ((z & comp23) && (z & comp67)) SET_BIT(clxdat, 13);
-        if ((z & comp23) && (z & comp45)) SET_BIT(clxdat, 12);
-        if ((z & comp01) && (z & comp67)) SET_BIT(clxdat, 11);
-        if ((z & comp01) && (z & comp45)) SET_BIT(clxdat, 10);
-        if ((z & comp01) && (z & comp23)) SET_BIT(clxdat, 9);
-
-        if (CLX_DEBUG) {
-            if ((z & comp45) && (z & comp67)) trace("Collision between 45 and 67\n");
-            if ((z & comp23) && (z & comp67)) trace("Collision between 23 and 67\n");
-            if ((z & comp23) && (z & comp45)) trace("Collision between 23 and 45\n");
-            if ((z & comp01) && (z & comp67)) trace("Collision between 01 and 67\n");
-            if ((z & comp01) && (z & comp45)) trace("Collision between 01 and 45\n");
-            if ((z & comp01) && (z & comp23)) trace("Collision between 01 and 23\n");
-        }
+    // Determine the pixels where the sprite is solid
+    u32 spr = clxWindow(sprMask[x], start);
+    if (!spr) return;
+
+    // Determine the pixels where the sprite groups are solid, too
+    u32 comp01 = clxWindow(sprMask[0], start);
+    u32 comp23 = clxWindow(sprMask[2], start);
+    u32 comp45 = clxWindow(sprMask[4], start);
+    u32 comp67 = clxWindow(sprMask[6], start);
+    if (GET_BIT(clxcon, 12)) comp01 |= clxWindow(sprMask[1], start);
+    if (GET_BIT(clxcon, 13)) comp23 |= clxWindow(sprMask[3], start);
+    if (GET_BIT(clxcon, 14)) comp45 |= clxWindow(sprMask[5], start);
+    if (GET_BIT(clxcon, 15)) comp67 |= clxWindow(sprMask[7], start);
+    comp01 &= spr;
+    comp23 &= spr;
+    comp45 &= spr;
+    comp67 &= spr;
+
+    // Set sprite collision bits
+    if (comp45 & comp67) SET_BIT(clxdat, 14);
+    if (comp23 & comp67) SET_BIT(clxdat, 13);
+    if (comp23 & comp45) SET_BIT(clxdat, 12);
+    if (comp01 & comp67) SET_BIT(clxdat, 11);
+    if (comp01 & comp45) SET_BIT(clxdat, 10);
+    if (comp01 & comp23) SET_BIT(clxdat, 9);
+
+    if (CLX_DEBUG) {
+        if (comp45 & comp67) trace("Collision between 45 and 67\n");
+        if (comp23 & comp67) trace("Collision between 23 and 67\n");
+        if (comp23 & comp45) trace("Collision between 23 and 45\n");
+        if (comp01 & comp67) trace("Collision between 01 and 67\n");
+        if (comp01 & comp45) trace("Collision between 01 and 45\n");
+        if (comp01 & comp23) trace("Collision between 01 and 23\n");
     }
 }
 
 template <int x> void
 Denise::checkS2PCollisions(int start, int end)
 {
-    // debug(CLX_DEBUG, "checkS2PCollisions<%d>(%d, %d)\n", x, start, end);
-    
+    assert(end == start + 31);
+
     // For the odd sprites, only proceed if collision detection is enabled
     if (IS_ODD(x) && !getENSP<x>()) return;
 
-    // Set up the sprite comparison mask
-    u16 sprMask;
-    switch(x) {
-        case 0:
-        case 1: sprMask = Z_SP0 | (getENSP<1>() ? Z_SP1 : 0); break;
-        case 2:
-        case 3: sprMask = Z_SP2 | (getENSP<3>() ? Z_SP3 : 0); break;
-        case 4:
-        case 5: sprMask = Z_SP4 | (getENSP<5>() ? Z_SP5 : 0); break;
-        case 6:
-        case 7: sprMask = Z_SP6 | (getENSP<7>() ? Z_SP7 : 0); break;
-
-        default: sprMask = 0; assert(false);
-    }
+    // Determine the pixels where the sprite is solid
+    u32 spr = clxWindow(sprMask[x], start);
+    if (!spr) return;
+
+    // Sprite pixels are never drawn beyond the end of the pixel buffers
+    assert(start + 32 <= (int)sizeof(bBuffer));
 
     u8 enabled1 = getENBP1();
     u8 enabled2 = getENBP2();
     u8 compare1 = getMVBP1() & enabled1;
     u8 compare2 = getMVBP2() & enabled2;
 
-    // Check for sprite-playfield collisions
-    for (int pos = end; pos >= start; pos -= 2) {
+    // Determine the pixels where the playfields match
+    u32 pf1 = matchMask8(bBuffer + start, enabled1, compare1);
+    u32 pf2 = matchMask8(bBuffer + start, enabled2, compare2);
+    u32 dpf = testMask16(zBuffer + start, Z_DPF);
 
-        u16 z = zBuffer[pos];
-
-        // Skip if the sprite is transparent at this pixel coordinate
-        if (!(z & Z_SP[x])) continue;
-
-        // debug(CLX_DEBUG, "<%d> b[%d] = %X e1 = %X e2 = %X, c1 = %X c2 = %X\n",
-        //     x, pos, bBuffer[pos], enabled1, enabled2, compare1, compare2);
-
-        // Check for a collision with playfield 2
-        if ((bBuffer[pos] & enabled2) == compare2) {
-            trace(CLX_DEBUG, "S%d collides with PF2\n", x);
-            SET_BIT(clxdat, 5 + (x / 2));
-
-        } else {
-            // There is a hardware oddity in single-playfield mode. If PF2
-            // doesn't match, PF1 doesn't match either. No matter what.
-            // See http://eab.abime.net/showpost.php?p=965074&postcount=2
-            if (!(zBuffer[pos] & Z_DPF)) continue;
-        }
+    // Check for a collision with playfield 2
+    if (spr & pf2) {
+        trace(CLX_DEBUG, "S%d collides with PF2\n", x);
+        SET_BIT(clxdat, 5 + (x / 2));
+    }
 
-        // Check for a collision with playfield 1
-        if ((bBuffer[pos] & enabled1) == compare1) {
-            trace(CLX_DEBUG, "S%d collides with PF1\n", x);
-            SET_BIT(clxdat, 1 + (x / 2));
-        }
+    // Check for a collision with playfield 1. There is a hardware oddity in
+    // single-playfield mode. If PF2 doesn't match, PF1 doesn't match either.
+    // No matter what. See http://eab.abime.net/showpost.php?p=965074&postcount=2
+    if (spr & (pf2 | dpf) & pf1) {
+        trace(CLX_DEBUG, "S%d collides with PF1\n", x);
+        SET_BIT(clxdat, 1 + (x / 2));
     }
 }
 
@@ -1091,7 +1127,11 @@ Denise::beginOfLine(int vpos)
     for (int i = 0; i < 6; i++) shiftReg[i] = 0;
 
     // Clear the bBuffer
-    memset(bBuffer, 0, sizeof(bBuffer));
+    if (bBufferFirst < bBufferLast) {
+        memset(bBuffer + bBufferFirst, 0, bBufferLast - bBufferFirst);
+    }
+    bBufferFirst = sizeof(bBuffer);
+    bBufferLast = 0;
 
     // Reset the sprite clipping range
     spriteClipBegin = HPIXELS;
@@ -1106,24 +1146,38 @@ Denise::endOfLine(int vpos)
     // Check if we are below the VBLANK area
     if (vpos >= 26) {
 
-        // Translate bitplane data to color register indices
-        translate();
+        // Check if the line looks the same as in the previous frame
+        u64 signature = lineSignature();
 
-        // Draw sprites
-        drawSprites();
+        if (pixelEngine.isCached(vpos, signature)) {
 
-        // Draw border pixels
-        drawBorder();
+            // Reuse the RGBA values from the previous frame
+            skipTranslation();
+            drawSprites();
+            if (config.clxPlfPlf) checkP2PCollisions();
+            pixelEngine.colorizeCached(vpos);
 
-        // Perform playfield-playfield collision check (if enabled)
-        if (config.clxPlfPlf) checkP2PCollisions();
-        
-        // Synthesize RGBA values and write the result into the frame buffer
-        pixelEngine.colorize(vpos);
+        } else {
+
+            // Translate bitplane data to color register indices
+            translate();
 
-        // Remove certain graphics layers if requested
-        if (config.hiddenLayers) {
-            pixelEngine.hide(vpos, config.hiddenLayers, config.hiddenLayerAlpha);
+            // Draw sprites
+            drawSprites();
+
+            // Draw border pixels
+            drawBorder();
+
+            // Perform playfield-playfield collision check (if enabled)
+            if (config.clxPlfPlf) checkP2PCollisions();
+
+            // Synthesize RGBA values and write the result into the frame buffer
+            pixelEngine.colorize(vpos, signature);
+
+            // Remove certain graphics layers if requested
+            if (config.hiddenLayers) {
+                pixelEngine.hide(vpos, config.hiddenLayers, config.hiddenLayerAlpha);
+            }
         }
     } else {
         
@@ -1140,7 +1194,7 @@ Denise::endOfLine(int vpos)
     dmaDebugger.computeOverlay();
     
     // Encode a HIRES / LORES marker in the first HBLANK pixel
-    *denise.pixelEngine.pixelAddr(HBLANK_MIN * 4) = hires() ? 0 : -1;
+    pixelEngine.writeMarker(hires() ? 0 : -1);
 }
 
 void
@@ -1184,6 +1238,3 @@ template void Denise::drawOdd<false>(int offset);
 template void Denise::drawOdd<true>(int offset);
 template void Denise::drawEven<false>(int offset);
 template void Denise::drawEven<true>(int offset);
-
-template void Denise::translateDPF<true>(int from, int to);
-template void Denise::translateDPF<false>(int from, int to);
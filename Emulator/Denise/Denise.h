@@ -85,7 +85,7 @@ public:
      * written to. This is emulated in function fillShiftRegister().
      *
      * Note: The upper two array elements are dummy elements. We need them in
-     * order to pass the array as parameter to function transposeSSE().
+     * order to pass the array as parameter to function planarToChunky().
      */
     u16 __attribute__ ((aligned (64))) shiftReg[8];
 
@@ -173,6 +173,15 @@ private:
     u16 prio1;
     u16 prio2;
 
+    /* Lookup tables for translating bitplane data. There is a table for each
+     * combination of the dual-playfield bit and the lower seven bits of
+     * BPLCON2. Each table maps all 64 possible bBuffer values to the color
+     * index and the pixel depth computed by translate(). The tables are
+     * constant and shared by all instances.
+     */
+    static u8 indexTable[256][64];
+    static u16 depthTable[256][64];
+
     
     //
     // Rasterline data
@@ -231,6 +240,12 @@ private:
     u8 mBuffer[HPIXELS + (4 * 16) + 6];
     u16 zBuffer[HPIXELS + (4 * 16) + 6];
 
+    /* The range of the bBuffer written in the current rasterline. All other
+     * elements are zero. The range is empty if bitplane DMA is off.
+     */
+    int bBufferFirst = 0;
+    int bBufferLast = 0;
+
     static const u16 Z_0   = 0b10000000'00000000;
     static const u16 Z_SP0 = 0b01000000'00000000;
     static const u16 Z_SP1 = 0b00100000'00000000;
@@ -267,6 +282,18 @@ private:
     static int upperPlayfield(u16 z) {
         return ((z & Z_DUAL) == Z_DPF2 || (z & Z_DUAL) == Z_DPF21) ? 2 : 1;
     }
+
+    /* Sprite collision masks
+     *
+     * For each sprite, a packed bit mask (one bit per pixel) records where
+     * Z_SP[x] has been set in the zBuffer. The masks are built while the
+     * sprites are drawn and allow to check all pixels of a sprite for
+     * collisions with a few logical operations. The number of words is chosen
+     * such that a 64 pixel window can be extracted at the rightmost sprite
+     * position.
+     */
+    static const int clxWords = 18;
+    u64 sprMask[8][clxWords];
     
     
     //
@@ -505,6 +532,12 @@ public:
     template <bool hiresMode> void drawOdd(int offset);
     template <bool hiresMode> void drawEven(int offset);
     template <bool hiresMode> void drawBoth(int offset);
+
+    // Adds the pixels synthesized by a draw function to the bBuffer range
+    template <bool hiresMode> void extendBBufferRange(int pixel) {
+        bBufferFirst = MIN(bBufferFirst, pixel);
+        bBufferLast = MAX(bBufferLast, pixel + (hiresMode ? 16 : 32)); }
+
     void drawHiresOdd()  { if (armedOdd)  drawOdd <true>  (pixelOffsetOdd);  }
     void drawHiresEven() { if (armedEven) drawEven<true>  (pixelOffsetEven); }
     void drawHiresBoth();
@@ -517,12 +550,26 @@ private:
     // Translate bitplane data to color register indices
     void translate();
 
-    // Called by translate() in single-playfield mode
-    void translateSPF(int from, int to);
+    // Called by translate() for each chunk between two register changes
+    void translate(int table, int from, int to);
+
+    // Selects the lookup table matching the current register values
+    static int translationTable(bool dual, u16 bplcon2) {
+        return (dual ? 128 : 0) | (bplcon2 & 0x7F); }
 
-    // Called by translate() in dual-playfield mode
-    void translateDPF(bool pf2pri, int from, int to);
-    template <bool pf2pri> void translateDPF(int from, int to);
+    // Sets up the lookup tables used by translate() (called once)
+    static void initTranslationTables();
+
+    /* Computes a signature of all parameters the current line is drawn with.
+     * If the signature matches the one of the previous frame, the emulator
+     * skips the translation and the colorization stage and reuses the RGBA
+     * values from the previous frame. Lines containing sprites are never
+     * reused (0 is returned in this case).
+     */
+    u64 lineSignature();
+
+    // Performs the side effects of translate() without drawing any pixels
+    void skipTranslation();
 
 public:
 
@@ -566,6 +613,19 @@ public:
     // Checks for playfield-playfield collisions in the current rasterline
     void checkP2PCollisions();
 
+private:
+
+    // Marks a pixel as solid in the collision mask of a sprite
+    template <int x> void setSprMask(int pos) {
+        sprMask[x][pos >> 6] |= 1ULL << (pos & 63);
+    }
+
+    /* Extracts the collision bits of a sprite from a collision mask. Bit i of
+     * the result corresponds to pixel pos + i. Only the pixels that are
+     * checked for collisions (every second one) are kept.
+     */
+    u32 clxWindow(const u64 *mask, int pos);
+
 
     //
     // Delegation methods
@@ -56,6 +56,39 @@ inline bool isPalette(long value) {
     return value >= COLOR_PALETTE && value <= SEPIA_PALETTE;
 }
 
+typedef VA_ENUM(long, VideoFormat)
+{
+    VIDEO_RGBA,          // Raw RGBA pixel data
+    VIDEO_Y4M            // YUV4MPEG2 (4:2:0)
+};
+
+inline bool isVideoFormat(long value) {
+    return value >= VIDEO_RGBA && value <= VIDEO_Y4M;
+}
+
+typedef VA_ENUM(long, AudioFormat)
+{
+    AUDIO_PCM,           // Raw 32 bit float samples (stereo, interleaved)
+    AUDIO_WAV            // WAV file with 32 bit float samples
+};
+
+inline bool isAudioFormat(long value) {
+    return value >= AUDIO_PCM && value <= AUDIO_WAV;
+}
+
+typedef VA_ENUM(long, OutputMode)
+{
+    OUTPUT_FULL,          // Full frame buffer (RGBA)
+    OUTPUT_CROPPED,       // Visible area (RGBA)
+    OUTPUT_CROPPED_HALF,  // Visible area, half horizontal resolution (RGBA)
+    OUTPUT_INDEXED,       // Visible area (8 bit palette indices)
+    OUTPUT_INDEXED_HALF   // Visible area, half horizontal resolution (8 bit)
+};
+
+inline bool isOutputMode(long value) {
+    return value >= OUTPUT_FULL && value <= OUTPUT_INDEXED_HALF;
+}
+
 
 //
 // Structures
@@ -65,9 +98,29 @@ typedef struct
 {
     u32 *data;
     bool longFrame;
+
+    // Sequence number of the frame (increases by one with each frame)
+    u64 frameNr;
+
+    // Compact output buffer (NULL in output mode OUTPUT_FULL)
+    u8 *output;
+
+    // Hash over all pixels (only computed if frame tracking is enabled)
+    u64 hash;
+
+    // Number of lines differing from the previous frame (-1 if unknown)
+    long dirtyLines;
 }
 ScreenBuffer;
 
+typedef struct
+{
+    // First and last pixel + 1 that differ from the previous frame
+    i16 x1;
+    i16 x2;
+}
+DirtySpan;
+
 typedef struct
 {
     // Number of lines the sprite was armed
@@ -106,6 +159,9 @@ typedef struct
 
     // Checks for playfield-playfield collisions
     bool clxPlfPlf;
+
+    // Colorizes pixels in a separate thread
+    bool renderThread;
 }
 DeniseConfig;
 
@@ -8,14 +8,31 @@
 // -----------------------------------------------------------------------------
 
 #include "Amiga.h"
+#include "SSEUtils.h"
 
 PixelEngine::PixelEngine(Amiga& ref) : AmigaComponent(ref)
 {
     setDescription("PixelEngine");
 
     // Allocate frame buffers
-    emuTexture[0].data = new u32[PIXELS]; emuTexture[0].longFrame = true;
-    emuTexture[1].data = new u32[PIXELS]; emuTexture[1].longFrame = true;
+    for (int i = 0; i < bufferCnt; i++) {
+        emuTexture[i].data = new u32[PIXELS];
+        emuTexture[i].longFrame = true;
+        emuTexture[i].frameNr = 0;
+        emuTexture[i].output = NULL;
+        emuTexture[i].hash = 0;
+        emuTexture[i].dirtyLines = -1;
+        readers[i] = 0;
+    }
+    readers[working] = -1;
+
+    // Setup the RGB332 palette for the indexed output modes
+    for (int i = 0; i < 256; i++) {
+        u8 r = (u8)((i >> 5) * 255 / 7);
+        u8 g = (u8)(((i >> 2) & 7) * 255 / 7);
+        u8 b = (u8)((i & 3) * 255 / 3);
+        outputPalette[i] = GpuColor(r, g, b).rawValue;
+    }
     
     // Create random background noise pattern
     const size_t noiseSize = 2 * 512 * 512;
@@ -24,24 +41,32 @@ PixelEngine::PixelEngine(Amiga& ref) : AmigaComponent(ref)
         noise[i] = rand() % 2 ? 0xFF000000 : 0xFFFFFFFF;
     }
 
-    // Setup ECS BRDRBLNK color
-    indexedRgba[64] = GpuColor(0x00, 0x00, 0x00).rawValue;
-    
-    // Setup some debug colors
-    indexedRgba[65] = GpuColor(0xD0, 0x00, 0x00).rawValue;
-    indexedRgba[66] = GpuColor(0xA0, 0x00, 0x00).rawValue;
-    indexedRgba[67] = GpuColor(0x90, 0x00, 0x00).rawValue;
-    indexedRgba[68] = GpuColor(0x00, 0xFF, 0xFF).rawValue;
-    indexedRgba[69] = GpuColor(0x00, 0xD0, 0xD0).rawValue;
-    indexedRgba[70] = GpuColor(0x00, 0xA0, 0xA0).rawValue;
-    indexedRgba[71] = GpuColor(0x00, 0x90, 0x90).rawValue;
-    indexedRgba[72] = GpuColor(0xFF, 0x00, 0x00).rawValue;
+    for (ColorState *s : { &state, &renderState }) {
+
+        // Setup ECS BRDRBLNK color
+        s->indexedRgba[64] = GpuColor(0x00, 0x00, 0x00).rawValue;
+
+        // Setup some debug colors
+        s->indexedRgba[65] = GpuColor(0xD0, 0x00, 0x00).rawValue;
+        s->indexedRgba[66] = GpuColor(0xA0, 0x00, 0x00).rawValue;
+        s->indexedRgba[67] = GpuColor(0x90, 0x00, 0x00).rawValue;
+        s->indexedRgba[68] = GpuColor(0x00, 0xFF, 0xFF).rawValue;
+        s->indexedRgba[69] = GpuColor(0x00, 0xD0, 0xD0).rawValue;
+        s->indexedRgba[70] = GpuColor(0x00, 0xA0, 0xA0).rawValue;
+        s->indexedRgba[71] = GpuColor(0x00, 0x90, 0x90).rawValue;
+        s->indexedRgba[72] = GpuColor(0xFF, 0x00, 0x00).rawValue;
+    }
 }
 
 PixelEngine::~PixelEngine()
 {
-    delete[] emuTexture[0].data;
-    delete[] emuTexture[1].data;
+    if (jobs) {
+        stopRenderThread();
+        delete jobs;
+    }
+
+    for (int i = 0; i < bufferCnt; i++) delete[] emuTexture[i].data;
+    freeOutputBuffers();
     delete[] noise;
 }
 
@@ -55,74 +80,143 @@ PixelEngine::didLoadFromBuffer(u8 *buffer)
 void
 PixelEngine::_powerOn()
 {
+    flush();
+
     // Initialize frame buffers with a checkerboard pattern (for debugging)
     for (unsigned line = 0; line < VPIXELS; line++) {
         for (unsigned i = 0; i < HPIXELS; i++) {
 
             int pos = line * HPIXELS + i;
             int col = (line / 4) % 2 == (i / 8) % 2 ? 0xFF222222 : 0xFF444444;
-            emuTexture[0].data[pos] = col;
-            emuTexture[1].data[pos] = col;
+            for (int nr = 0; nr < bufferCnt; nr++) emuTexture[nr].data[pos] = col;
         }
     }
+    clearLineCache();
+    if (tracking) rehash();
 }
 
 void
 PixelEngine::_reset(bool hard)
 {
+    flush();
+
     RESET_SNAPSHOT_ITEMS(hard)
     
-    frameBuffer = & emuTexture[0];
     updateRGBA();
 }
 
 void
 PixelEngine::setPalette(Palette p)
 {
+    amiga.suspend();
+
     palette = p;
     updateRGBA();
+
+    amiga.resume();
 }
 
 void
 PixelEngine::setBrightness(double value)
 {
+    amiga.suspend();
+
     brightness = value;
     updateRGBA();
+
+    amiga.resume();
 }
 
 void
 PixelEngine::setSaturation(double value)
 {
+    amiga.suspend();
+
     saturation = value;
     updateRGBA();
+
+    amiga.resume();
 }
 
 void
 PixelEngine::setContrast(double value)
 {
+    amiga.suspend();
+
     contrast = value;
     updateRGBA();
 
+    amiga.resume();
 }
 
 void
-PixelEngine::setColor(int reg, u16 value)
+PixelEngine::setOutputMode(OutputMode mode)
+{
+    assert(isOutputMode(mode));
+
+    amiga.suspend();
+
+    flush();
+    claimAllBuffers();
+    freeOutputBuffers();
+    outputMode = mode;
+    allocOutputBuffers();
+    unclaimAllBuffers();
+    clearLineCache();
+
+    amiga.resume();
+}
+
+void
+PixelEngine::setOutputArea(int x1, int y1, int x2, int y2)
+{
+    // Make sure that pixel pairs never cross a line boundary
+    x1 &= ~1;
+    x2 = x1 + ((x2 - x1) & ~1);
+
+    assert(x1 >= 0 && x1 < x2 && x2 <= x1 + HPIXELS);
+    assert(y1 >= 0 && y1 < y2 && y2 < VPIXELS);
+
+    amiga.suspend();
+
+    flush();
+    claimAllBuffers();
+    freeOutputBuffers();
+    area.x1 = x1;
+    area.y1 = y1;
+    area.x2 = x2;
+    area.y2 = y2;
+    allocOutputBuffers();
+    unclaimAllBuffers();
+    clearLineCache();
+
+    amiga.resume();
+}
+
+void
+PixelEngine::setColor(ColorState &s, int reg, u16 value)
 {
     assert(reg < 32);
 
-    colreg[reg] = value & 0xFFF;
+    s.colreg[reg] = value & 0xFFF;
 
     u8 r = (value & 0xF00) >> 8;
     u8 g = (value & 0x0F0) >> 4;
     u8 b = (value & 0x00F);
 
-    indexedRgba[reg] = rgba[value & 0xFFF];
-    indexedRgba[reg + 32] = rgba[((r / 2) << 8) | ((g / 2) << 4) | (b / 2)];
+    s.indexedRgba[reg] = rgba[value & 0xFFF];
+    s.indexedRgba[reg + 32] = rgba[((r / 2) << 8) | ((g / 2) << 4) | (b / 2)];
 }
 
 void
 PixelEngine::updateRGBA()
 {
+    // The render thread must not use the table while it is modified
+    flush();
+
+    // The cached lines have been drawn with the old colors
+    clearLineCache();
+
     // Iterate through all 4096 colors
     for (u16 col = 0x000; col <= 0xFFF; col++) {
 
@@ -139,7 +233,7 @@ PixelEngine::updateRGBA()
     }
 
     // Update all RGBA values that are cached in indexedRgba[]
-    for (int i = 0; i < 32; i++) setColor(i, colreg[i]);
+    for (int i = 0; i < 32; i++) setColor(i, state.colreg[i]);
 }
 
 void
@@ -236,9 +330,196 @@ PixelEngine::isShortFrame(ScreenBuffer *buf)
 ScreenBuffer
 PixelEngine::getStableBuffer()
 {
-    ScreenBuffer result;
-    synchronized { result = (frameBuffer == &emuTexture[0]) ? emuTexture[1] : emuTexture[0]; }
-    return result;
+    return emuTexture[stable.load(std::memory_order_acquire)];
+}
+
+ScreenBuffer
+PixelEngine::acquireBuffer()
+{
+    while (1) {
+
+        int nr = stable.load(std::memory_order_acquire);
+        int count = readers[nr].load();
+
+        // Register as a reader unless the emulator has claimed the buffer
+        while (count >= 0) {
+            if (readers[nr].compare_exchange_weak(count, count + 1)) {
+                return emuTexture[nr];
+            }
+        }
+    }
+}
+
+void
+PixelEngine::releaseBuffer(const ScreenBuffer &buffer)
+{
+    int i = indexOf(buffer);
+
+    assert(readers[i] > 0);
+    readers[i]--;
+}
+
+int
+PixelEngine::indexOf(const ScreenBuffer &buffer)
+{
+    for (int i = 0; i < bufferCnt; i++) {
+        if (emuTexture[i].data == buffer.data) return i;
+    }
+    assert(false);
+    return 0;
+}
+
+void
+PixelEngine::setFrameTracking(bool enable)
+{
+    if (enable == tracking) return;
+
+    amiga.suspend();
+
+    flush();
+    tracking = enable;
+    if (tracking) rehash();
+
+    amiga.resume();
+}
+
+const DirtySpan *
+PixelEngine::getDirtySpans(const ScreenBuffer &buffer)
+{
+    return frameInfo[indexOf(buffer)].dirty;
+}
+
+void
+PixelEngine::trackLine(int buffer, int reference, int line)
+{
+    assert(buffer != reference);
+
+    const u32 *cur = emuTexture[buffer].data + line * HPIXELS;
+    const u32 *ref = emuTexture[reference].data + line * HPIXELS;
+    FrameInfo &info = frameInfo[buffer];
+
+    // Determine the first and the last pixel that differ
+    int x1 = 0, x2 = HPIXELS;
+    while (x1 < HPIXELS && cur[x1] == ref[x1]) x1++;
+    if (x1 == HPIXELS) x1 = x2 = 0;
+    while (x2 > x1 && cur[x2 - 1] == ref[x2 - 1]) x2--;
+
+    info.dirty[line].x1 = (i16)x1;
+    info.dirty[line].x2 = (i16)x2;
+
+    // Only hash the line if it has changed
+    if (x1 == x2) {
+        info.lineHash[line] = frameInfo[reference].lineHash[line];
+    } else {
+        info.lineHash[line] = fnv_1a_64x4((const u8 *)cur, HPIXELS * sizeof(u32));
+    }
+
+    tracked[line] = true;
+}
+
+void
+PixelEngine::rehash()
+{
+    for (int i = 0; i < bufferCnt; i++) {
+        for (int line = 0; line < VPIXELS; line++) {
+
+            u8 *data = (u8 *)(emuTexture[i].data + line * HPIXELS);
+            frameInfo[i].lineHash[line] = fnv_1a_64x4(data, HPIXELS * sizeof(u32));
+        }
+    }
+    memset(tracked, 0, sizeof(tracked));
+}
+
+int
+PixelEngine::outputWidth()
+{
+    int width = area.x2 - area.x1;
+
+    switch (outputMode) {
+        case OUTPUT_CROPPED_HALF:
+        case OUTPUT_INDEXED_HALF: return width / 2;
+        default:                  return width;
+    }
+}
+
+int
+PixelEngine::outputBytesPerPixel()
+{
+    switch (outputMode) {
+        case OUTPUT_INDEXED:
+        case OUTPUT_INDEXED_HALF: return 1;
+        default:                  return 4;
+    }
+}
+
+u32
+PixelEngine::getPixel(const ScreenBuffer &buffer, int x, int y)
+{
+    if (outputMode == OUTPUT_FULL) return buffer.data[y * HPIXELS + x];
+
+    int width = area.x2 - area.x1;
+    int shift = outputWidth() == width ? 0 : 1;
+
+    // Locate the pixel in the output buffer (rows may wrap around)
+    int pos = y * HPIXELS + x - area.x1;
+    int row = pos / HPIXELS - area.y1;
+    int col = pos % HPIXELS;
+    if (pos < 0 || row < 0 || row >= outputHeight() || col >= width) {
+        return 0xFF000000;
+    }
+    int i = row * outputWidth() + (col >> shift);
+
+    switch (outputMode) {
+        case OUTPUT_INDEXED:
+        case OUTPUT_INDEXED_HALF: return outputPalette[buffer.output[i]];
+        default:                  return ((u32 *)buffer.output)[i];
+    }
+}
+
+void
+PixelEngine::allocOutputBuffers()
+{
+    if (outputMode == OUTPUT_FULL) return;
+
+    size_t size = outputWidth() * outputHeight() * outputBytesPerPixel();
+
+    for (int i = 0; i < bufferCnt; i++) {
+        assert(emuTexture[i].output == NULL);
+        emuTexture[i].output = new u8[size]();
+    }
+}
+
+void
+PixelEngine::freeOutputBuffers()
+{
+    for (int i = 0; i < bufferCnt; i++) {
+        delete[] emuTexture[i].output;
+        emuTexture[i].output = NULL;
+    }
+}
+
+void
+PixelEngine::claimAllBuffers()
+{
+    for (int i = 0; i < bufferCnt; i++) {
+
+        if (i == working) continue;
+
+        // Wait until the last reader has handed back the buffer
+        int expected = 0;
+        while (!readers[i].compare_exchange_weak(expected, -1)) {
+            expected = 0;
+            std::this_thread::yield();
+        }
+    }
+}
+
+void
+PixelEngine::unclaimAllBuffers()
+{
+    for (int i = 0; i < bufferCnt; i++) {
+        if (i != working) readers[i].store(0, std::memory_order_release);
+    }
 }
 
 u32 *
@@ -262,11 +543,57 @@ PixelEngine::pixelAddr(int pixel)
 void
 PixelEngine::beginOfFrame()
 {
-    // Switch the working buffer
-    synchronized {
-        frameBuffer = (frameBuffer == &emuTexture[0]) ? &emuTexture[1] : &emuTexture[0];
-        frameBuffer->longFrame = agnus.frame.lof;
+    // Wait until the render thread has completed the frame
+    flush();
+
+    // Finish frame tracking
+    if (tracking && outputMode == OUTPUT_FULL) {
+
+        FrameInfo &info = frameInfo[working];
+        long dirtyLines = 0;
+        u64 hash = fnv_1a_init64();
+
+        for (int line = 0; line < VPIXELS; line++) {
+
+            // Compare the lines that haven't been drawn in this frame
+            if (!tracked[line]) trackLine(working, reference, line);
+
+            if (info.dirty[line].x1 != info.dirty[line].x2) dirtyLines++;
+            hash = fnv_1a_it64(hash, info.lineHash[line]);
+        }
+        frameBuffer->hash = hash;
+        frameBuffer->dirtyLines = dirtyLines;
+        memset(tracked, 0, sizeof(tracked));
+
+    } else {
+
+        frameBuffer->hash = 0;
+        frameBuffer->dirtyLines = -1;
     }
+
+    // Claim a buffer that is neither stable nor in use by a reader
+    int next = -1;
+    for (int i = 0; i < bufferCnt && next < 0; i++) {
+
+        int expected = 0;
+        if (i == working || i == stable) continue;
+        if (readers[i].compare_exchange_strong(expected, -1)) next = i;
+    }
+
+    // Publish the completed frame
+    if (next >= 0) {
+
+        readers[working].store(0, std::memory_order_release);
+        stable.store(working, std::memory_order_release);
+        working = next;
+    }
+
+    // Continue with the next frame
+    reference = stable;
+    previous = (int)(frameBuffer - emuTexture);
+    frameBuffer = &emuTexture[working];
+    frameBuffer->longFrame = agnus.frame.lof;
+    frameBuffer->frameNr = ++frameNr;
     
     dmaDebugger.vSyncHandler();
 }
@@ -281,7 +608,7 @@ PixelEngine::endOfVBlankLine()
 }
 
 void
-PixelEngine::applyRegisterChange(const RegChange &change)
+PixelEngine::applyRegisterChange(ColorState &s, const RegChange &change)
 {
     switch (change.addr) {
 
@@ -289,45 +616,108 @@ PixelEngine::applyRegisterChange(const RegChange &change)
             break;
 
         case BPLCON0:
-            hamMode = Denise::ham(change.value);
+            s.hamMode = Denise::ham(change.value);
             break;
             
         default: // It must be a color register then
             assert(change.addr >= 0x180 && change.addr <= 0x1BE);
-            setColor((change.addr - 0x180) >> 1, change.value);
+            setColor(s, (change.addr - 0x180) >> 1, change.value);
             break;
     }
 }
 
+u64
+PixelEngine::colorSignature()
+{
+    u64 result = fnv_1a_64x4((u8 *)state.colreg, sizeof(state.colreg));
+
+    result = fnv_1a_it64(result, state.hamMode);
+    return colChanges.checksum(result);
+}
+
 void
-PixelEngine::colorize(int line)
+PixelEngine::colorize(int line, u64 signature)
+{
+    // Remember the signature for the next frame
+    this->signature[working][line] = signature;
+
+    // Hand the line over to the render thread if possible
+    if (usesRenderThread()) {
+
+        RenderJob *job = reserveJob(line);
+
+        job->reuse = false;
+        memcpy(job->colreg, state.colreg, sizeof(state.colreg));
+        job->hamMode = state.hamMode;
+        job->colChanges.clear();
+
+        // Check if HAM mode is used anywhere in this line
+        bool ham = state.hamMode;
+
+        for (int i = colChanges.begin(); i != colChanges.end(); i = colChanges.next(i)) {
+
+            RegChange &change = colChanges.elements[i];
+
+            // Copy the recorded change
+            job->colChanges.insert(colChanges.keys[i], change);
+            if (change.addr == BPLCON0) ham |= Denise::ham(change.value);
+
+            // Keep the color registers up to date
+            applyRegisterChange(change);
+        }
+        colChanges.clear();
+
+        // Copy the pixel data (only HAM mode needs the raw bitplane data)
+        memcpy(job->mBuffer, denise.mBuffer, sizeof(job->mBuffer));
+        if (ham) {
+            memcpy(job->bBuffer, denise.bBuffer, sizeof(job->bBuffer));
+            memcpy(job->iBuffer, denise.iBuffer, sizeof(job->iBuffer));
+            memcpy(job->zBuffer, denise.zBuffer, sizeof(job->zBuffer));
+        }
+        return;
+    }
+
+    LineData data = { denise.bBuffer, denise.iBuffer, denise.mBuffer, denise.zBuffer };
+
+    if (outputMode == OUTPUT_FULL) {
+
+        colorize(state, data, frameBuffer->data + line * HPIXELS, colChanges);
+
+    } else {
+
+        colorize(state, data, state.lineBuffer, colChanges);
+        writeOutput(working, line, state.lineBuffer);
+    }
+}
+
+void
+PixelEngine::colorize(ColorState &s, const LineData &data, u32 *dst,
+                      RegChangeRecorder<128> &changes)
 {
-    // Jump to the first pixel in the specified line in the active frame buffer
-    u32 *dst = frameBuffer->data + line * HPIXELS;
     int pixel = 0;
 
     // Initialize the HAM mode hold register with the current background color
-    u16 hold = colreg[0];
+    u16 hold = s.colreg[0];
 
     // Add a dummy register change to ensure we draw until the line end
-    colChanges.insert(HPIXELS, RegChange { SET_NONE, 0 } );
+    changes.insert(HPIXELS, RegChange { SET_NONE, 0 } );
 
     // Iterate over all recorded register changes
-    for (int i = colChanges.begin(); i != colChanges.end(); i = colChanges.next(i)) {
+    for (int i = changes.begin(); i != changes.end(); i = changes.next(i)) {
 
-        Cycle trigger = colChanges.keys[i];
-        RegChange &change = colChanges.elements[i];
+        Cycle trigger = changes.keys[i];
+        RegChange &change = changes.elements[i];
 
         // Colorize a chunk of pixels
-        if (hamMode) {
-            colorizeHAM(dst, pixel, trigger, hold);
+        if (s.hamMode) {
+            colorizeHAM(s, data, dst, pixel, trigger, hold);
         } else {
-            colorize(dst, pixel, trigger);
+            colorize(s, data, dst, pixel, trigger);
         }
         pixel = trigger;
 
         // Perform the register change
-        applyRegisterChange(change);
+        applyRegisterChange(s, change);
     }
 
     // Wipe out the HBLANK area
@@ -336,66 +726,188 @@ PixelEngine::colorize(int line)
     }
 
     // Clear the history cache
+    changes.clear();
+}
+
+bool
+PixelEngine::isCached(int line, u64 signature)
+{
+    assert(line < VPIXELS);
+    return signature && signature == this->signature[previous][line];
+}
+
+void
+PixelEngine::colorizeCached(int line)
+{
+    signature[working][line] = signature[previous][line];
+
+    if (usesRenderThread()) {
+
+        // Let the render thread copy the line
+        reserveJob(line)->reuse = true;
+
+    } else if (outputMode != OUTPUT_FULL) {
+
+        copyOutput(previous, working, line);
+
+    } else {
+
+        // Copy the line from the previous frame (if it was not dropped)
+        u32 *src = emuTexture[previous].data + line * HPIXELS;
+        u32 *dst = emuTexture[working].data + line * HPIXELS;
+        if (src != dst) memcpy(dst, src, HPIXELS * sizeof(u32));
+    }
+
+    // Perform all register changes
+    for (int i = colChanges.begin(); i != colChanges.end(); i = colChanges.next(i)) {
+        applyRegisterChange(colChanges.elements[i]);
+    }
     colChanges.clear();
 }
 
 void
-PixelEngine::colorize(u32 *dst, int from, int to)
+PixelEngine::writeMarker(u32 value)
 {
-    u8 *mbuf = denise.mBuffer;
+    if (openJob) {
 
-    for (int i = from; i < to; i++) {
-        dst[i] = indexedRgba[mbuf[i]];
+        openJob->marker = value;
+        openJob = NULL;
+
+        // Wake up the render thread once a couple of lines have piled up
+        bool wakeUp;
+        {   std::unique_lock<std::mutex> lock(jobLock);
+            jobs->publish();
+            wakeUp = jobs->count() >= 8;
+        }
+        if (wakeUp) jobCond.notify_all();
+
+    } else if (outputMode == OUTPUT_FULL) {
+
+        *pixelAddr(HBLANK_MIN * 4) = value;
+        if (tracking) trackLine(working, reference, agnus.pos.v);
     }
 }
 
+bool
+PixelEngine::outputSegment(int line, int row, int &first, int &count, int &offset)
+{
+    if (row < 0 || row >= outputHeight()) return false;
+
+    int width = area.x2 - area.x1;
+    int shift = outputWidth() == width ? 0 : 1;
+
+    // Intersect the row with the line (in frame buffer coordinates)
+    int rowStart = (area.y1 + row) * HPIXELS + area.x1;
+    int begin = MAX(rowStart, line * HPIXELS);
+    int end = MIN(rowStart + width, (line + 1) * HPIXELS);
+    if (begin >= end) return false;
+
+    first = begin - line * HPIXELS;
+    count = end - begin;
+    offset = row * outputWidth() + ((begin - rowStart) >> shift);
+    return true;
+}
+
 void
-PixelEngine::colorizeHAM(u32 *dst, int from, int to, u16& ham)
+PixelEngine::writeOutput(int buffer, int line, const u32 *src)
 {
-    u8 *bbuf = denise.bBuffer;
-    u8 *ibuf = denise.iBuffer;
-    u8 *mbuf = denise.mBuffer;
+    int bpp = outputBytesPerPixel();
+    int first, count, offset;
 
-    for (int i = from; i < to; i++) {
+    for (int row = line - area.y1 - 1; row <= line - area.y1; row++) {
 
-        u8 index = ibuf[i];
-        assert(isRgbaIndex(index));
+        if (!outputSegment(line, row, first, count, offset)) continue;
+        convertOutput(emuTexture[buffer].output + offset * bpp,
+                      src + first, count);
+    }
+}
 
-        // switch ((index >> 4) & 0b11) {
-        switch ((bbuf[i] >> 4) & 0b11) {
+void
+PixelEngine::copyOutput(int from, int to, int line)
+{
+    if (from == to) return;
 
-            case 0b00: // Get color from register
+    int shift = outputWidth() == area.x2 - area.x1 ? 0 : 1;
+    int bpp = outputBytesPerPixel();
+    int first, count, offset;
 
-                ham = colreg[index];
-                break;
+    for (int row = line - area.y1 - 1; row <= line - area.y1; row++) {
 
-            case 0b01: // Modify blue
+        if (!outputSegment(line, row, first, count, offset)) continue;
+        memcpy(emuTexture[to].output + offset * bpp,
+               emuTexture[from].output + offset * bpp, (count >> shift) * bpp);
+    }
+}
 
-                ham &= 0xFF0;
-                ham |= (index & 0b1111);
-                break;
+void
+PixelEngine::convertOutput(u8 *dst, const u32 *src, int count)
+{
+    // Averages two RGBA values without overflowing into the next channel
+    auto average = [](u32 a, u32 b) { return (a & b) + (((a ^ b) & 0xFEFEFEFE) >> 1); };
 
-            case 0b10: // Modify red
+    // Maps an RGBA value to the RGB332 palette
+    auto index = [](u32 c) {
+        return (u8)((c & 0xE0) | ((c >> 11) & 0x1C) | ((c >> 22) & 0x03));
+    };
 
-                ham &= 0x0FF;
-                ham |= (index & 0b1111) << 8;
-                break;
+    switch (outputMode) {
 
-            case 0b11: // Modify green
+        case OUTPUT_CROPPED:
 
-                ham &= 0xF0F;
-                ham |= (index & 0b1111) << 4;
-                break;
+            memcpy(dst, src, count * sizeof(u32));
+            break;
 
-            default:
-                assert(false);
-        }
+        case OUTPUT_CROPPED_HALF:
 
-        // Synthesize pixel
-        if (denise.spritePixelIsVisible(i)) {
-            dst[i] = rgba[colreg[mbuf[i]]];
-        } else {
-            dst[i] = rgba[ham];
+            for (int i = 0; i < count / 2; i++) {
+                ((u32 *)dst)[i] = average(src[2 * i], src[2 * i + 1]);
+            }
+            break;
+
+        case OUTPUT_INDEXED:
+
+            for (int i = 0; i < count; i++) {
+                dst[i] = index(src[i]);
+            }
+            break;
+
+        case OUTPUT_INDEXED_HALF:
+
+            for (int i = 0; i < count / 2; i++) {
+                dst[i] = index(average(src[2 * i], src[2 * i + 1]));
+            }
+            break;
+
+        default:
+            assert(false);
+    }
+}
+
+void
+PixelEngine::colorize(ColorState &s, const LineData &data, u32 *dst, int from, int to)
+{
+    lookup8(dst + from, data.mBuffer + from, s.indexedRgba, to - from);
+}
+
+void
+PixelEngine::colorizeHAM(ColorState &s, const LineData &data, u32 *dst, int from, int to, u16& ham)
+{
+    const u8 *bbuf = data.bBuffer;
+    const u8 *ibuf = data.iBuffer;
+    const u8 *mbuf = data.mBuffer;
+    const u16 *zbuf = data.zBuffer;
+
+    // Compute the contents of the hold register for each pixel
+    holdHAM(s.hamBuffer + from, bbuf + from, ibuf + from, s.colreg, to - from, ham);
+
+    // Translate the hold register values into RGBA values
+    lookup16(dst + from, s.hamBuffer + from, rgba, to - from);
+
+    // Draw sprites on top
+    for (int i = from; i < to; i++) {
+
+        if (Denise::isSpritePixel(zbuf[i])) {
+            dst[i] = rgba[s.colreg[mbuf[i]]];
         }
     }
 }
@@ -443,3 +955,135 @@ PixelEngine::hide(int line, u16 layers, u8 alpha)
         p[i] = 0xFF000000 | newb << 16 | newg << 8 | newr;
     }
 }
+
+void
+PixelEngine::setRenderThread(bool enable)
+{
+    if (enable == hasRenderThread()) return;
+
+    amiga.suspend();
+
+    if (enable) {
+
+        jobs = new SPSCQueue<RenderJob, 32>;
+        quit = false;
+        renderThread = std::thread(&PixelEngine::renderMain, this);
+
+    } else {
+
+        flush();
+        stopRenderThread();
+        delete jobs;
+        jobs = NULL;
+    }
+
+    amiga.resume();
+}
+
+void
+PixelEngine::flush()
+{
+    if (jobs) {
+        std::unique_lock<std::mutex> lock(jobLock);
+        jobCond.notify_all();
+        jobCond.wait(lock, [this] { return jobs->isEmpty(); });
+    }
+}
+
+void
+PixelEngine::stopRenderThread()
+{
+    {   std::unique_lock<std::mutex> lock(jobLock);
+        quit = true;
+    }
+    jobCond.notify_all();
+    renderThread.join();
+}
+
+bool
+PixelEngine::usesRenderThread()
+{
+    /* The debugging layers are drawn on top of the colorized pixels by the
+     * emulator thread. Lines using them are colorized synchronously.
+     */
+    if (!jobs || denise.getConfig().hiddenLayers || dmaDebugger.isEnabled()) {
+        flush();
+        return false;
+    }
+    return true;
+}
+
+PixelEngine::RenderJob *
+PixelEngine::reserveJob(int line)
+{
+    assert(jobs && !openJob);
+
+    {   std::unique_lock<std::mutex> lock(jobLock);
+        if (!(openJob = jobs->reserve())) {
+            jobCond.notify_all();
+            jobCond.wait(lock, [this] { return (openJob = jobs->reserve()) != NULL; });
+        }
+    }
+
+    openJob->line = line;
+    openJob->buffer = working;
+    openJob->source = previous;
+    openJob->reference = reference;
+    return openJob;
+}
+
+void
+PixelEngine::renderMain()
+{
+    std::unique_lock<std::mutex> lock(jobLock);
+
+    while (1) {
+
+        RenderJob *job = NULL;
+
+        jobCond.wait(lock, [&] { return quit || (job = jobs->front()) != NULL; });
+        if (quit) break;
+
+        // Colorize the line without holding the lock
+        lock.unlock();
+        render(*job);
+        lock.lock();
+
+        jobs->pop();
+        jobCond.notify_all();
+    }
+}
+
+void
+PixelEngine::render(RenderJob &job)
+{
+    bool full = outputMode == OUTPUT_FULL;
+    u32 *dst = full ? emuTexture[job.buffer].data + job.line * HPIXELS : renderState.lineBuffer;
+
+    if (job.reuse) {
+
+        // Copy the line from the previous frame (if it was not dropped)
+        if (full) {
+            u32 *src = emuTexture[job.source].data + job.line * HPIXELS;
+            if (src != dst) memcpy(dst, src, HPIXELS * sizeof(u32));
+        } else {
+            copyOutput(job.source, job.buffer, job.line);
+        }
+
+    } else {
+
+        // Sync the color registers with the emulator thread
+        for (int i = 0; i < 32; i++) setColor(renderState, i, job.colreg[i]);
+        renderState.hamMode = job.hamMode;
+
+        LineData data = { job.bBuffer, job.iBuffer, job.mBuffer, job.zBuffer };
+        colorize(renderState, data, dst, job.colChanges);
+        if (!full) writeOutput(job.buffer, job.line, dst);
+    }
+
+    if (full) {
+
+        dst[HBLANK_MIN * 4] = job.marker;
+        if (tracking) trackLine(job.buffer, job.reference, job.line);
+    }
+}
@@ -12,6 +12,8 @@
 
 #include "AmigaComponent.h"
 
+#include <condition_variable>
+
 class PixelEngine : public AmigaComponent {
 
     friend class DmaDebugger;
@@ -28,49 +30,210 @@ private:
     // Screen buffers
     //
 
-    /* The emulator uses double-buffering for storing the computed textures.
-     * At any time, one of the two buffers is the "working buffer" and the other
-     * one the "stable buffer". All drawing functions write to the working
-     * buffer whereas the GPU reads from the stable buffer. Once a frame has
-     * been completed, the working buffer and the stable buffer are switched.
+    /* The emulator stores the computed textures in a pool of frame buffers.
+     * At any time, one buffer is the "working buffer" and another one is the
+     * "stable buffer" which contains the most recently completed frame. All
+     * drawing functions write to the working buffer. Once a frame has been
+     * completed, it becomes the stable buffer and the emulator continues
+     * with a buffer that is neither stable nor in use by a reader.
+     *
+     * The buffers are handed over without locks. For each buffer, readers[]
+     * counts the readers holding it (see acquireBuffer()). The working buffer
+     * is marked with -1. A buffer can only be claimed for drawing when its
+     * reader count is 0. If no such buffer exists, the emulator drops the
+     * completed frame and draws the next one into the same buffer.
      */
-    ScreenBuffer emuTexture[2];
+    static const int bufferCnt = 4;
+    ScreenBuffer emuTexture[bufferCnt];
+    std::atomic<int> readers[bufferCnt];
+
+    // Index of the working buffer and the stable buffer
+    int working = 0;
+    std::atomic<int> stable { 1 };
+
+    // Index of the buffer holding the previously drawn frame
+    int previous = 1;
 
     // Pointer to the "working buffer"
     ScreenBuffer *frameBuffer = &emuTexture[0];
 
+    // Sequence number of the frame in the working buffer
+    u64 frameNr = 0;
+
+    /* Line cache. For each line of all frame buffers, this array stores a
+     * signature of all parameters the line has been drawn with (computed by
+     * Denise::lineSignature()). If a line is about to be drawn with the same
+     * parameters as in the previous frame, the pixels are copied over from
+     * the previous frame buffer. A value of 0 marks a line as not reusable.
+     */
+    u64 signature[bufferCnt][VPIXELS];
+
+    /* Frame tracking. If enabled, each line is compared with the same line
+     * of the previously completed frame (the reference frame) once it has
+     * been drawn. For each frame buffer, the horizontal span of differing
+     * pixels and a hash of each line is recorded. Lines that haven't changed
+     * inherit the hash from the reference frame. Hence, the hash function
+     * only runs over lines that have changed. The line hashes are combined
+     * into a frame hash once the frame is complete.
+     */
+    struct FrameInfo {
+
+        u64 lineHash[VPIXELS];
+        DirtySpan dirty[VPIXELS];
+    };
+    FrameInfo frameInfo[bufferCnt];
+
+    // Indicates if frame tracking is enabled
+    bool tracking = false;
+
+    // Index of the frame buffer the current frame is compared with
+    int reference = 1;
+
+    // Lines of the current frame that have been compared already
+    bool tracked[VPIXELS];
+
     // Buffer with background noise (random black and white pixels)
     u32 *noise;
 
+
+    //
+    // Output modes
+    //
+
+    /* By default, the colorization stage writes each line into the frame
+     * buffer in full size. In all other output modes, only the visible area
+     * is written into a separate, compact output buffer, either in RGBA
+     * format or as 8 bit indices into a fixed RGB332 palette. Optionally,
+     * the horizontal resolution is halved by averaging two adjacent pixels.
+     * The frame buffer is not updated in these modes.
+     */
+    OutputMode outputMode = OUTPUT_FULL;
+
+    /* The visible area written into the output buffer. The coordinates refer
+     * to the frame buffer. Because the right border of a rasterline is stored
+     * at the beginning of the next line, x2 may exceed HPIXELS. x1 and the
+     * width of the area are always even.
+     */
+    struct { int x1; int y1; int x2; int y2; } area = {
+        4 * HBLANK_MAX + 2, VBLANK_CNT, HPIXELS + 4 * HBLANK_MIN, VPIXELS - 2 };
+
+    // The palette used in the indexed output modes
+    u32 outputPalette[256];
+
     
     //
     // Color management
     //
 
-    // The 32 Amiga color registers
-    u16 colreg[32];
+    static const int rgbaIndexCnt = 32 + 32 + 1 + 8;
+
+    /* The registers the colorization stage operates on. The emulator thread
+     * uses the instance in variable 'state'. In pipelined mode, the render
+     * thread works on a separate instance which is synced with the register
+     * values stored in each job.
+     */
+    struct ColorState {
+
+        // The 32 Amiga color registers
+        u16 colreg[32];
+
+        /* The color register values translated to RGBA
+         * Note that the number of elements exceeds the number of color
+         * registers:
+         *  0 .. 31 : RGBA values of the 32 color registers
+         * 32 .. 63 : RGBA values of the 32 color registers in halfbright mode
+         *       64 : Pure black (used if the ECS BRDRBLNK bit is set)
+         * 65 .. 72 : Additional colors used for debugging
+         */
+        u32 indexedRgba[rgbaIndexCnt];
+
+        // Indicates whether HAM mode is switched
+        bool hamMode;
+
+        // Contents of the HAM hold register for each pixel of the current line
+        u16 hamBuffer[HPIXELS];
+
+        // The colorized line in compact output modes
+        u32 lineBuffer[HPIXELS];
+    };
+
+    ColorState state;
+    ColorState renderState;
 
     // RGBA values for all possible 4096 Amiga colors
     u32 rgba[4096];
 
-    /* The color register values translated to RGBA
-     * Note that the number of elements exceeds the number of color registers:
-     *  0 .. 31 : RGBA values of the 32 color registers
-     * 32 .. 63 : RGBA values of the 32 color registers in halfbright mode
-     *       64 : Pure black (used if the ECS BRDRBLNK bit is set)
-     * 65 .. 72 : Additional colors used for debugging
-     */
-    static const int rgbaIndexCnt = 32 + 32 + 1 + 8;
-    u32 indexedRgba[rgbaIndexCnt];
-
     // Color adjustment parameters
     Palette palette = COLOR_PALETTE;
     double brightness = 50.0;
     double contrast = 100.0;
     double saturation = 1.25;
     
-    // Indicates whether HAM mode is switched
-    bool hamMode;
+
+    //
+    // Render thread
+    //
+
+    // Pointers to the pixel data of a rasterline
+    struct LineData {
+
+        const u8 *bBuffer;
+        const u8 *iBuffer;
+        const u8 *mBuffer;
+        const u16 *zBuffer;
+    };
+
+    // A rasterline waiting to be colorized by the render thread
+    struct RenderJob {
+
+        // Line number and index of the target frame buffer
+        int line;
+        int buffer;
+
+        // Index of the frame buffer holding the previous frame
+        int source;
+
+        // Index of the frame buffer used for frame tracking
+        int reference;
+
+        // Indicates that the line is copied over from the previous frame
+        bool reuse;
+
+        // Value of the HIRES / LORES marker in the first HBLANK pixel
+        u32 marker;
+
+        // Color registers at the beginning of the line
+        u16 colreg[32];
+        bool hamMode;
+
+        // Recorded color register changes
+        RegChangeRecorder<128> colChanges;
+
+        // Copies of Denise's pixel buffers (all but mBuffer in HAM mode only)
+        u8 bBuffer[HPIXELS];
+        u8 iBuffer[HPIXELS];
+        u8 mBuffer[HPIXELS];
+        u16 zBuffer[HPIXELS];
+    };
+
+    /* Lines waiting to be colorized. If the render thread is enabled, Denise
+     * only finishes the chipset-related parts of each line and hands the
+     * pixel data over to the render thread via this queue.
+     */
+    SPSCQueue<RenderJob, 32> *jobs = NULL;
+
+    // A job that has been filled in, but not been handed over yet
+    RenderJob *openJob = NULL;
+
+    // The render thread
+    std::thread renderThread;
+
+    // Synchronization primitives for putting both threads to sleep
+    std::mutex jobLock;
+    std::condition_variable jobCond;
+
+    // Indicates that the render thread should terminate
+    bool quit = false;
     
     
     //
@@ -110,6 +273,15 @@ public:
     
     double getContrast() { return contrast; }
     void setContrast(double value);
+
+    /* Selects the output mode and the visible area. The output buffers are
+     * reallocated. Before that, both functions wait until all readers have
+     * handed back their buffers. Hence, they must not be called by a thread
+     * that holds a buffer itself.
+     */
+    OutputMode getOutputMode() { return outputMode; }
+    void setOutputMode(OutputMode mode);
+    void setOutputArea(int x1, int y1, int x2, int y2);
     
     
     //
@@ -134,8 +306,8 @@ private:
         worker
 
         & colChanges
-        & colreg
-        & hamMode;
+        & state.colreg
+        & state.hamMode;
     }
 
     size_t _size() override { COMPUTE_SNAPSHOT_SIZE }
@@ -164,11 +336,11 @@ public:
     static bool isRgbaIndex(int nr) { return nr < rgbaIndexCnt; }
     
     // Changes one of the 32 Amiga color registers.
-    void setColor(int reg, u16 value);
+    void setColor(int reg, u16 value) { setColor(state, reg, value); }
 
     // Returns a color value in Amiga format or RGBA format
-    u16 getColor(int nr) { assert(nr < 32); return colreg[nr]; }
-    u32 getRGBA(int nr) { assert(nr < 32); return indexedRgba[nr]; }
+    u16 getColor(int nr) { assert(nr < 32); return state.colreg[nr]; }
+    u32 getRGBA(int nr) { assert(nr < 32); return state.indexedRgba[nr]; }
 
     // Returns sprite color in Amiga format or RGBA format
     u16 getSpriteColor(int s, int nr) { assert(s < 8); return getColor(16 + nr + 2 * (s & 6)); }
@@ -181,6 +353,9 @@ public:
 
 private:
 
+    // Changes a color register in the provided color state
+    void setColor(ColorState &s, int reg, u16 value);
+
     // Updates the entire RGBA lookup table
     void updateRGBA();
 
@@ -194,9 +369,44 @@ private:
 
 public:
 
-    // Returns the stable frame buffer for long frames
+    /* Returns the most recently completed frame. The buffer is not reserved
+     * and may be overwritten once the emulator has completed two more frames.
+     * Readers that need more time should use acquireBuffer().
+     */
     ScreenBuffer getStableBuffer();
 
+    /* Reserves the most recently completed frame. The emulator won't draw
+     * into the buffer until it has been handed back with releaseBuffer().
+     * The frame number can be used to detect dropped or repeated frames.
+     * Both functions are lock-free and can be called from any thread.
+     */
+    ScreenBuffer acquireBuffer();
+    void releaseBuffer(const ScreenBuffer &buffer);
+
+    /* Enables or disables frame tracking. If enabled, each completed frame
+     * carries a frame hash and the number of changed lines. getDirtySpans()
+     * returns the horizontal span of changed pixels for each line. Frame
+     * tracking is only supported in output mode OUTPUT_FULL.
+     */
+    bool hasFrameTracking() { return tracking; }
+    void setFrameTracking(bool enable);
+    const DirtySpan *getDirtySpans(const ScreenBuffer &buffer);
+
+    // Returns the size of the compact output buffer in pixels and bytes
+    int outputWidth();
+    int outputHeight() { return area.y2 - area.y1; }
+    int outputBytesPerPixel();
+
+    // Returns the palette used in the indexed output modes
+    const u32 *getOutputPalette() { return outputPalette; }
+
+    /* Returns a pixel of a frame buffer in RGBA format. The coordinates refer
+     * to the full-size frame buffer. In the compact output modes, the pixel
+     * is read from the output buffer. Pixels outside the visible area are
+     * black in these modes.
+     */
+    u32 getPixel(const ScreenBuffer &buffer, int x, int y);
+
     // Returns a pointer to randon noise
     u32 *getNoise();
     
@@ -209,6 +419,49 @@ public:
     // Called after each frame to switch the frame buffers
     void beginOfFrame();
 
+private:
+
+    // Marks all lines as not reusable
+    void clearLineCache() { memset(signature, 0, sizeof(signature)); }
+
+    // Returns the index of a frame buffer in emuTexture[]
+    int indexOf(const ScreenBuffer &buffer);
+
+    // Compares a line with the reference frame
+    void trackLine(int buffer, int reference, int line);
+
+    // Computes the hash of each line from scratch
+    void rehash();
+
+    // Allocates or releases the compact output buffers
+    void allocOutputBuffers();
+    void freeOutputBuffers();
+
+    /* Claims all frame buffers for the emulator. The function blocks until
+     * every reader has handed back its buffer. While the buffers are claimed,
+     * acquireBuffer() blocks.
+     */
+    void claimAllBuffers();
+    void unclaimAllBuffers();
+
+    /* Determines the part of a line that belongs to a certain row of the
+     * output buffer. A line contributes to two rows: Its left part belongs to
+     * the row of the line itself and its first pixels to the right border of
+     * the row above. On success, first and count describe the segment inside
+     * the line and offset is the position of its first pixel in the output
+     * buffer.
+     */
+    bool outputSegment(int line, int row, int &first, int &count, int &offset);
+
+    // Writes a colorized line into the output buffer
+    void writeOutput(int buffer, int line, const u32 *src);
+
+    // Copies the output of a line from one buffer to another
+    void copyOutput(int from, int to, int line);
+
+    // Converts a segment of a line into the selected output format
+    void convertOutput(u8 *dst, const u32 *src, int count);
+
 
     //
     // Working with recorded register changes
@@ -217,7 +470,11 @@ public:
 public:
 
     // Applies a register change
-    void applyRegisterChange(const RegChange &change);
+    void applyRegisterChange(const RegChange &change) { applyRegisterChange(state, change); }
+    void applyRegisterChange(ColorState &s, const RegChange &change);
+
+    // Computes a checksum over all color registers and recorded changes
+    u64 colorSignature();
 
 
     //
@@ -229,14 +486,36 @@ public:
     /* Colorizes a rasterline.
      * This function implements the last stage in the emulator's graphics
      * pipelile. It translates a line of color register indices into a line
-     * of RGBA values in GPU format.
+     * of RGBA values in GPU format. The signature is recorded in the line
+     * cache.
      */
-    void colorize(int line);
-    
+    void colorize(int line, u64 signature = 0);
+
+    /* Checks if a line with the provided signature is stored in the previous
+     * frame. In that case, colorizeCached() can be called instead of
+     * colorize() to copy the line over.
+     */
+    bool isCached(int line, u64 signature);
+    void colorizeCached(int line);
+
+    /* Writes the HIRES / LORES marker into the first HBLANK pixel. If the
+     * current line has been colorized by the render thread, the marker is
+     * added to the pending job which is then handed over.
+     */
+    void writeMarker(u32 value);
+
 private:
-    
-    void colorize(u32 *dst, int from, int to);
-    void colorizeHAM(u32 *dst, int from, int to, u16& ham);
+
+    // Colorizes a line with the provided color state and register changes
+    void colorize(ColorState &s, const LineData &data, u32 *dst,
+                  RegChangeRecorder<128> &changes);
+
+    /* Colorizes a chunk of pixels. The palette lookup and the HAM hold
+     * register computation are carried out by the vectorized functions in
+     * SSEUtils which select the fastest code path at runtime.
+     */
+    void colorize(ColorState &s, const LineData &data, u32 *dst, int from, int to);
+    void colorizeHAM(ColorState &s, const LineData &data, u32 *dst, int from, int to, u16& ham);
     
     /* Hides some graphics layers.
      * This function is an optional stage applied after colorize(). It can
@@ -246,6 +525,40 @@ private:
 public:
     
     void hide(int line, u16 layer, u8 alpha);
+
+
+    //
+    // Running the render thread
+    //
+
+public:
+
+    /* Starts or stops the render thread. If the thread is running, colorize()
+     * and colorizeCached() only record the pixel data of each line. The
+     * emulator thread is freed from computing RGBA values.
+     */
+    void setRenderThread(bool enable);
+    bool hasRenderThread() { return jobs != NULL; }
+
+    // Waits until the render thread has processed all pending lines
+    void flush();
+
+private:
+
+    // Checks whether the current line can be handed over to the render thread
+    bool usesRenderThread();
+
+    // Returns a free job slot (blocks if the queue is full)
+    RenderJob *reserveJob(int line);
+
+    // Terminates the render thread
+    void stopRenderThread();
+
+    // The thread enter function of the render thread
+    void renderMain();
+
+    // Colorizes a line on the render thread
+    void render(RenderJob &job);
 };
 
 #endif
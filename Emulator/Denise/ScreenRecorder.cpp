@@ -40,6 +40,22 @@ ScreenRecorder::_dump()
     msg("%s:%s installed\n", ffmpegPath(), hasFFmpeg() ? "" : " not");
     msg("Video pipe:%s created\n", videoPipe != -1 ? "" : " not");
     msg("Audio pipe:%s created\n", audioPipe != -1 ? "" : " not");
+    msg("Built-in backend:%s active\n", native ? "" : " not");
+    msg("Frames written: %ld\n", writer.framesWritten());
+    msg("Frames dropped: %ld\n", writer.framesDropped());
+}
+
+void
+ScreenRecorder::setCutout(int x1, int y1, int x2, int y2)
+{
+    // Make sure the screen dimensions are even
+    if ((x2 - x1) % 2) x2--;
+    if ((y2 - y1) % 2) y2--;
+    cutout.x1 = x1;
+    cutout.x2 = x2;
+    cutout.y1 = y1;
+    cutout.y2 = y2;
+    debug("Recorded area: (%d,%d) - (%d,%d)\n", x1, y1, x2, y2);
 }
     
 bool
@@ -63,15 +79,10 @@ ScreenRecorder::startRecording(int x1, int y1, int x2, int y2,
     
     synchronized {
 
-        // Make sure the screen dimensions are even
-        if ((x2 - x1) % 2) x2--;
-        if ((y2 - y1) % 2) y2--;
-        cutout.x1 = x1;
-        cutout.x2 = x2;
-        cutout.y1 = y1;
-        cutout.y2 = y2;
-        debug("Recorded area: (%d,%d) - (%d,%d)\n", x1, y1, x2, y2);
-          
+        setCutout(x1, y1, x2, y2);
+        x2 = cutout.x2;
+        y2 = cutout.y2;
+
         //
         // Assemble the command line arguments for the video encoder
         //
@@ -158,6 +169,7 @@ ScreenRecorder::startRecording(int x1, int y1, int x2, int y2,
         audioPipe = open(audioPipePath(), O_WRONLY);
 
         recording = videoFFmpeg && audioFFmpeg && videoPipe != -1 && audioPipe != -1;
+        native = false;
     }
 
     if (isRecording()) {
@@ -168,6 +180,35 @@ ScreenRecorder::startRecording(int x1, int y1, int x2, int y2,
     return false;
 }
 
+bool
+ScreenRecorder::startRecording(int x1, int y1, int x2, int y2,
+                               const char *videoPath, VideoFormat videoFormat,
+                               const char *audioPath, AudioFormat audioFormat,
+                               long aspectX,
+                               long aspectY)
+{
+    if (isRecording()) return false;
+
+    synchronized {
+
+        setCutout(x1, y1, x2, y2);
+
+        recording = writer.open(videoPath, videoFormat,
+                                cutout.x2 - cutout.x1, cutout.y2 - cutout.y1,
+                                frameRate, aspectX, aspectY,
+                                audioPath, audioFormat,
+                                sampleRate, samplesPerFrame);
+        native = true;
+    }
+
+    if (isRecording()) {
+        messageQueue.put(MSG_RECORDING_STARTED);
+        return true;
+    }
+
+    return false;
+}
+
 void
 ScreenRecorder::stopRecording()
 {
@@ -175,22 +216,34 @@ ScreenRecorder::stopRecording()
     
     if (!isRecording()) return;
     
+    /* The streams are shut down while the lock is held. Hence, the vsync
+     * handler can't access them anymore once they are closed.
+     */
     synchronized {
+
         recording = false;
         recordCounter++;
-    }
 
-    // Close pipes
-    close(videoPipe);
-    close(audioPipe);
-    videoPipe = -1;
-    audioPipe = -1;
-     
-    // Shut down encoders
-    pclose(videoFFmpeg);
-    pclose(audioFFmpeg);
-    videoFFmpeg = NULL;
-    audioFFmpeg = NULL;
+        if (native) {
+
+            // Let the built-in backend write all pending frames
+            writer.close();
+
+        } else {
+
+            // Close pipes
+            close(videoPipe);
+            close(audioPipe);
+            videoPipe = -1;
+            audioPipe = -1;
+
+            // Shut down encoders
+            pclose(videoFFmpeg);
+            pclose(audioFFmpeg);
+            videoFFmpeg = NULL;
+            audioFFmpeg = NULL;
+        }
+    }
 
     debug(REC_DEBUG, "Recording has stopped\n");
     messageQueue.put(MSG_RECORDING_STOPPED);
@@ -246,55 +299,97 @@ ScreenRecorder::vsyncHandler(Cycle target)
 {
     if (!isRecording()) return;
     
-    // debug("vsyncHandler\n");
-    assert(videoFFmpeg != NULL);
-    assert(audioFFmpeg != NULL);
-
     synchronized {
         
-        //
-        // Video
-        //
-                        
-        ScreenBuffer buffer = denise.pixelEngine.getStableBuffer();
-        
-        int width = sizeof(u32) * (cutout.x2 - cutout.x1);
-        int height = cutout.y2 - cutout.y1;
-        int offset = cutout.y1 * HPIXELS + cutout.x1 + HBLANK_MIN * 4;
-        u8 *data = new u8[width * height];
-        u8 *src = (u8 *)(buffer.data + offset);
-        u8 *dst = data;
-        for (int y = 0; y < height; y++, src += 4 * HPIXELS, dst += width) {
-            memcpy(dst, src, width);
+        // Check again, because the recording might have been stopped meanwhile
+        if (!recording) return;
+
+        if (native) {
+
+            // Take an empty buffer from the pool
+            StreamWriter::Frame *frame = writer.reserve();
+
+            if (frame) {
+
+                if (!frame->video.empty()) recordVideo(frame->video.data());
+                if (!frame->audio.empty()) recordAudio(frame->audio.data(), target);
+                writer.submit(frame);
+
+            } else {
+
+                // Drop the frame, because the writer thread can't keep up
+                trace(REC_DEBUG, "Dropping frame\n");
+                audioClock = target;
+            }
+
+        } else {
+
+            assert(videoFFmpeg != NULL);
+            assert(audioFFmpeg != NULL);
+
+            int width = cutout.x2 - cutout.x1;
+            int height = cutout.y2 - cutout.y1;
+            videoData.resize(width * height);
+            audioData.resize(2 * samplesPerFrame);
+
+            // Feed the video pipe
+            recordVideo(videoData.data());
+            assert(videoPipe != -1);
+            write(videoPipe, (u8 *)videoData.data(), sizeof(u32) * videoData.size());
+
+            // Feed the audio pipe
+            recordAudio(audioData.data(), target);
+            assert(audioPipe != -1);
+            write(audioPipe, (u8 *)audioData.data(), sizeof(float) * audioData.size());
         }
+    }
+}
 
-        // Feed the video pipe
-        assert(videoPipe != -1);
-        write(videoPipe, data, (size_t)(width * height));
-        
-        //
-        // Audio
-        //
-        
-        // Clone Paula's muxer contents
-        muxer.sampler[0] = paula.muxer.sampler[0];
-        muxer.sampler[1] = paula.muxer.sampler[1];
-        muxer.sampler[2] = paula.muxer.sampler[2];
-        muxer.sampler[3] = paula.muxer.sampler[3];
-        assert(muxer.sampler[0].r == paula.muxer.sampler[0].r);
-        assert(muxer.sampler[0].w == paula.muxer.sampler[0].w);
-
-        // Synthesize audio samples for this frame
-        if (audioClock == 0) audioClock = target-1;
-        muxer.synthesize(audioClock, target, samplesPerFrame);
-        audioClock = target;
-        
-        // Copy samples to buffer
-        float *samples = new float[2 * samplesPerFrame];
-        muxer.copyInterleaved(samples, samplesPerFrame);
-                
-        // Feed the audio pipe
-        assert(audioPipe != -1);
-        write(audioPipe, (u8 *)samples, (size_t)(2 * sizeof(float) * samplesPerFrame));
+void
+ScreenRecorder::recordVideo(u32 *buffer)
+{
+    PixelEngine &pixelEngine = denise.pixelEngine;
+    ScreenBuffer stable = pixelEngine.getStableBuffer();
+
+    int width = cutout.x2 - cutout.x1;
+    int height = cutout.y2 - cutout.y1;
+    int x1 = cutout.x1 + HBLANK_MIN * 4;
+
+    u32 *dst = buffer;
+
+    // In compact output modes, the frame buffer is not updated
+    if (pixelEngine.getOutputMode() != OUTPUT_FULL) {
+
+        for (int y = 0; y < height; y++, dst += width) {
+            for (int x = 0; x < width; x++) {
+                dst[x] = pixelEngine.getPixel(stable, x1 + x, cutout.y1 + y);
+            }
+        }
+        return;
+    }
+
+    u32 *src = stable.data + cutout.y1 * HPIXELS + x1;
+    for (int y = 0; y < height; y++, src += HPIXELS, dst += width) {
+        memcpy(dst, src, sizeof(u32) * width);
     }
 }
+
+void
+ScreenRecorder::recordAudio(float *buffer, Cycle target)
+{
+    // Clone Paula's muxer contents
+    muxer.sampler[0] = paula.muxer.sampler[0];
+    muxer.sampler[1] = paula.muxer.sampler[1];
+    muxer.sampler[2] = paula.muxer.sampler[2];
+    muxer.sampler[3] = paula.muxer.sampler[3];
+    assert(muxer.sampler[0].r == paula.muxer.sampler[0].r);
+    assert(muxer.sampler[0].w == paula.muxer.sampler[0].w);
+
+    // Synthesize audio samples for this frame
+    if (audioClock == 0) audioClock = target-1;
+    muxer.synthesize(audioClock, target, samplesPerFrame);
+    audioClock = target;
+
+    // Copy samples to buffer
+    muxer.copyInterleaved(buffer, samplesPerFrame);
+}
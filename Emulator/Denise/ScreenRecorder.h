@@ -12,6 +12,7 @@
 
 #include "AmigaComponent.h"
 #include "Muxer.h"
+#include "StreamWriter.h"
 
 class ScreenRecorder : public AmigaComponent {
 
@@ -59,6 +60,9 @@ class ScreenRecorder : public AmigaComponent {
     int videoPipe = -1;
     int audioPipe = -1;
 
+    // Built-in backend writing the streams directly into files
+    StreamWriter writer;
+
     
     //
     // Recording status
@@ -67,6 +71,9 @@ class ScreenRecorder : public AmigaComponent {
     // Indicates if a video is being recorded
     bool recording = false;
 
+    // Indicates if the built-in backend is used instead of FFmpeg
+    bool native = false;
+
     // Number of records that have been made
     long recordCounter = 0;
     
@@ -87,6 +94,10 @@ class ScreenRecorder : public AmigaComponent {
     // Pixel aspect ratio
     long aspectX;
     long aspectY;
+
+    // Buffers for feeding the FFmpeg pipes
+    vector<u32> videoData;
+    vector<float> audioData;
             
     
     //
@@ -165,11 +176,29 @@ public:
                         long aspectX,
                         long aspectY);
 
+    /* Starts the screen recorder with the built-in backend. The streams are
+     * written directly into the specified files which makes FFmpeg obsolete.
+     * Pass NULL as path to omit a stream.
+     */
+    bool startRecording(int x1, int y1, int x2, int y2,
+                        const char *videoPath, VideoFormat videoFormat,
+                        const char *audioPath, AudioFormat audioFormat,
+                        long aspectX,
+                        long aspectY);
+
     // Stops the screen recorder
     void stopRecording();
 
     // Exports the recorded video
     bool exportAs(const char *path);
+
+    // Returns the number of frames the built-in backend had to drop
+    long getDroppedFrames() { return writer.framesDropped(); }
+
+private:
+
+    // Sets the recorded texture cutout
+    void setCutout(int x1, int y1, int x2, int y2);
     
     
     //
@@ -183,6 +212,14 @@ public:
     
     // Records a single frame
     void vsyncHandler(Cycle target);
+
+private:
+
+    // Copies the texture cutout of the current frame into a buffer
+    void recordVideo(u32 *buffer);
+
+    // Synthesizes the audio samples of the current frame
+    void recordAudio(float *buffer, Cycle target);
 };
 
 #endif
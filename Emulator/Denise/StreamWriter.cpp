@@ -0,0 +1,281 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "Amiga.h"
+
+StreamWriter::StreamWriter()
+{
+    setDescription("StreamWriter");
+}
+
+StreamWriter::~StreamWriter()
+{
+    close();
+}
+
+bool
+StreamWriter::open(const char *videoPath, VideoFormat videoFormat,
+                   int width, int height, int frameRate, long aspectX, long aspectY,
+                   const char *audioPath, AudioFormat audioFormat,
+                   int sampleRate, int samplesPerFrame)
+{
+    assert(!isOpen());
+    assert(isVideoFormat(videoFormat));
+    assert(isAudioFormat(audioFormat));
+    assert(width % 2 == 0 && height % 2 == 0);
+
+    this->videoFormat = videoFormat;
+    this->audioFormat = audioFormat;
+    this->width = width;
+    this->height = height;
+    this->sampleRate = sampleRate;
+
+    // Create the output files
+    if (videoPath && !(videoFile = fopen(videoPath, "wb"))) {
+        warn("Failed to create %s\n", videoPath);
+        close();
+        return false;
+    }
+    if (audioPath && !(audioFile = fopen(audioPath, "wb"))) {
+        warn("Failed to create %s\n", audioPath);
+        close();
+        return false;
+    }
+
+    // Write the file headers
+    if (videoFile && videoFormat == VIDEO_Y4M) {
+        fprintf(videoFile, "YUV4MPEG2 W%d H%d F%d:1 Ip A%ld:%ld C420jpeg\n",
+                width, height, frameRate, aspectX, 2 * aspectY);
+    }
+    if (audioFile && audioFormat == AUDIO_WAV) {
+        writeWavHeader(sampleRate, 0);
+    }
+    audioBytes = 0;
+    written = 0;
+    dropped = 0;
+
+    // Allocate the frame buffers
+    for (int i = 0; i < poolSize; i++) {
+
+        Frame *frame = new Frame();
+        frame->video.resize(videoFile ? width * height : 0);
+        frame->audio.resize(audioFile ? 2 * samplesPerFrame : 0);
+        frames.push_back(frame);
+        pool.push_back(frame);
+    }
+
+    // Launch the writer thread
+    quit = false;
+    worker = std::thread(&StreamWriter::main, this);
+
+    debug(REC_DEBUG, "Streams opened (%dx%d, %d Hz)\n", width, height, sampleRate);
+    return true;
+}
+
+void
+StreamWriter::close()
+{
+    // Let the writer thread process all pending frames and terminate
+    if (worker.joinable()) {
+
+        {   std::unique_lock<std::mutex> l(lock);
+            quit = true;
+        }
+        frameAvailable.notify_one();
+        worker.join();
+    }
+
+    if (videoFile) {
+        fclose(videoFile);
+        videoFile = NULL;
+    }
+    if (audioFile) {
+
+        // Fill in the final data size
+        if (audioFormat == AUDIO_WAV) {
+            fseek(audioFile, 0, SEEK_SET);
+            writeWavHeader(sampleRate, audioBytes);
+        }
+        fclose(audioFile);
+        audioFile = NULL;
+    }
+
+    // Free all frame buffers, including those that have not been submitted
+    {   std::unique_lock<std::mutex> l(lock);
+
+        for (Frame *frame : frames) delete frame;
+        frames.clear();
+        pool.clear();
+        queue = std::queue<Frame *>();
+    }
+
+    debug(REC_DEBUG, "Streams closed (%ld frames written, %ld dropped)\n",
+          written, dropped);
+}
+
+long
+StreamWriter::framesWritten()
+{
+    std::unique_lock<std::mutex> l(lock);
+    return written;
+}
+
+long
+StreamWriter::framesDropped()
+{
+    std::unique_lock<std::mutex> l(lock);
+    return dropped;
+}
+
+StreamWriter::Frame *
+StreamWriter::reserve()
+{
+    std::unique_lock<std::mutex> l(lock);
+
+    if (pool.empty()) {
+        dropped++;
+        return NULL;
+    }
+
+    Frame *frame = pool.back();
+    pool.pop_back();
+    return frame;
+}
+
+void
+StreamWriter::submit(Frame *frame)
+{
+    assert(frame != NULL);
+
+    {   std::unique_lock<std::mutex> l(lock);
+        queue.push(frame);
+    }
+    frameAvailable.notify_one();
+}
+
+void
+StreamWriter::main()
+{
+    std::unique_lock<std::mutex> l(lock);
+
+    while (1) {
+
+        frameAvailable.wait(l, [this] { return quit || !queue.empty(); });
+        if (queue.empty()) break;
+
+        Frame *frame = queue.front();
+        queue.pop();
+
+        // Do the heavy lifting without holding the lock
+        l.unlock();
+        write(frame);
+        l.lock();
+
+        // Recycle the buffer
+        pool.push_back(frame);
+        written++;
+    }
+}
+
+void
+StreamWriter::write(Frame *frame)
+{
+    if (videoFile) {
+
+        if (videoFormat == VIDEO_Y4M) {
+            writeY4M(frame);
+        } else {
+            fwrite(frame->video.data(), sizeof(u32), frame->video.size(), videoFile);
+        }
+    }
+
+    if (audioFile) {
+
+        size_t bytes = sizeof(float) * frame->audio.size();
+        fwrite(frame->audio.data(), 1, bytes, audioFile);
+        audioBytes += bytes;
+    }
+}
+
+void
+StreamWriter::writeY4M(Frame *frame)
+{
+    int cw = width / 2;
+    int ch = height / 2;
+
+    planes.resize(width * height + 2 * cw * ch);
+    u8 *py = planes.data();
+    u8 *pu = py + width * height;
+    u8 *pv = pu + cw * ch;
+
+    // The pixels are stored as R, G, B, A in memory
+    const u8 *rgba = (const u8 *)frame->video.data();
+
+    // Luma (full resolution)
+    for (int i = 0; i < width * height; i++, rgba += 4) {
+        py[i] = (u8)((77 * rgba[0] + 150 * rgba[1] + 29 * rgba[2] + 128) >> 8);
+    }
+
+    // Chroma (averaged over 2 x 2 pixels)
+    rgba = (const u8 *)frame->video.data();
+    for (int y = 0; y < ch; y++) {
+        for (int x = 0; x < cw; x++) {
+
+            const u8 *p1 = rgba + 4 * (2 * y * width + 2 * x);
+            const u8 *p2 = p1 + 4 * width;
+            int r = (p1[0] + p1[4] + p2[0] + p2[4] + 2) >> 2;
+            int g = (p1[1] + p1[5] + p2[1] + p2[5] + 2) >> 2;
+            int b = (p1[2] + p1[6] + p2[2] + p2[6] + 2) >> 2;
+
+            int cb = (-43 * r - 85 * g + 128 * b + 32896) >> 8;
+            int cr = (128 * r - 107 * g - 21 * b + 32896) >> 8;
+            pu[y * cw + x] = (u8)MIN(cb, 255);
+            pv[y * cw + x] = (u8)MIN(cr, 255);
+        }
+    }
+
+    fputs("FRAME\n", videoFile);
+    fwrite(planes.data(), 1, planes.size(), videoFile);
+}
+
+void
+StreamWriter::writeWavHeader(int sampleRate, u64 dataBytes)
+{
+    u32 size = (u32)MIN(dataBytes, 0xFFFFFFFF - 36);
+    u8 header[44], *ptr = header;
+
+    auto write16 = [&ptr](u16 value) {
+        *ptr++ = value & 0xFF; *ptr++ = value >> 8;
+    };
+    auto write32 = [&ptr](u32 value) {
+        for (int i = 0; i < 4; i++, value >>= 8) *ptr++ = value & 0xFF;
+    };
+
+    // RIFF header
+    memcpy(ptr, "RIFF", 4); ptr += 4;
+    write32(36 + size);
+    memcpy(ptr, "WAVE", 4); ptr += 4;
+
+    // Format chunk (IEEE float, stereo)
+    memcpy(ptr, "fmt ", 4); ptr += 4;
+    write32(16);
+    write16(3);
+    write16(2);
+    write32(sampleRate);
+    write32(sampleRate * 2 * sizeof(float));
+    write16(2 * sizeof(float));
+    write16(8 * sizeof(float));
+
+    // Data chunk
+    memcpy(ptr, "data", 4); ptr += 4;
+    write32(size);
+
+    assert(ptr - header == sizeof(header));
+    fwrite(header, 1, sizeof(header), audioFile);
+}
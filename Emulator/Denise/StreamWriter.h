@@ -0,0 +1,157 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef _STREAM_WRITER_H
+#define _STREAM_WRITER_H
+
+#include "AmigaObject.h"
+
+#include <condition_variable>
+
+/* Writes a video stream and an audio stream into files without the help of
+ * an external encoder. Video frames are stored as raw RGBA data or in Y4M
+ * format. Audio samples are stored as raw 32 bit float PCM data (stereo) or
+ * in WAV format.
+ *
+ * The emulator thread only copies the data of each frame into a buffer taken
+ * from a pool of preallocated buffers. Converting and writing the data is
+ * done by a background thread that hands the buffers back to the pool. If the
+ * pool is empty, because the writer thread can't keep up, the frame is
+ * dropped and counted. Hence, the emulator never blocks on the file system.
+ */
+class StreamWriter : public AmigaObject {
+
+public:
+
+    // The contents of a single frame
+    struct Frame {
+
+        // RGBA pixel data (width * height pixels)
+        vector<u32> video;
+
+        // Interleaved stereo samples
+        vector<float> audio;
+    };
+
+private:
+
+    // Number of preallocated frame buffers
+    static const int poolSize = 16;
+
+    // Output files
+    FILE *videoFile = NULL;
+    FILE *audioFile = NULL;
+
+    // Output formats
+    VideoFormat videoFormat = VIDEO_RGBA;
+    AudioFormat audioFormat = AUDIO_PCM;
+
+    // Frame dimensions
+    int width = 0;
+    int height = 0;
+
+    // Audio sample rate
+    int sampleRate = 0;
+
+    // The writer thread
+    std::thread worker;
+
+    // Synchronization primitives
+    std::mutex lock;
+    std::condition_variable frameAvailable;
+
+    // Frames waiting to be written
+    std::queue<Frame *> queue;
+
+    // Frames that are ready to be filled
+    vector<Frame *> pool;
+
+    // All allocated frames
+    vector<Frame *> frames;
+
+    // Indicates that the writer thread should terminate
+    bool quit = false;
+
+    // Number of bytes written into the audio data chunk
+    u64 audioBytes = 0;
+
+    // Statistics
+    long written = 0;
+    long dropped = 0;
+
+    // Y4M color planes (only accessed by the writer thread)
+    vector<u8> planes;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    StreamWriter();
+    ~StreamWriter();
+
+
+    //
+    // Opening and closing streams
+    //
+
+public:
+
+    /* Creates the output files and launches the writer thread. Both streams
+     * are optional (pass NULL to omit a stream). Returns false if a file
+     * can't be created.
+     */
+    bool open(const char *videoPath, VideoFormat videoFormat,
+              int width, int height, int frameRate, long aspectX, long aspectY,
+              const char *audioPath, AudioFormat audioFormat,
+              int sampleRate, int samplesPerFrame);
+
+    // Writes all pending frames, finalizes the file headers, and closes all files
+    void close();
+
+    // Checks whether the streams are open
+    bool isOpen() { return videoFile || audioFile; }
+
+    // Returns statistical information
+    long framesWritten();
+    long framesDropped();
+
+
+    //
+    // Writing frames
+    //
+
+public:
+
+    /* Returns an empty frame buffer from the pool. If the pool is exhausted,
+     * the frame is dropped and NULL is returned.
+     */
+    Frame *reserve();
+
+    // Hands a filled frame buffer over to the writer thread
+    void submit(Frame *frame);
+
+private:
+
+    // Main function of the writer thread
+    void main();
+
+    // Writes a single frame
+    void write(Frame *frame);
+
+    // Converts a frame to the YCbCr color space and writes it in Y4M format
+    void writeY4M(Frame *frame);
+
+    // Writes the header of a WAV file
+    void writeWavHeader(int sampleRate, u64 dataBytes);
+};
+
+#endif
@@ -30,6 +30,7 @@ Disk::makeWithFile(DiskFile *file)
     }
     
     disk->fnv = file->fnv();
+    disk->recordBaseImage();
     
     return disk;
 }
@@ -40,6 +41,31 @@ Disk::makeWithReader(SerReader &reader, DiskType diskType)
     Disk *disk = new Disk(diskType);
     disk->applyToPersistentItems(reader);
     
+    if (disk->baseHash) {
+        
+        // Look up the base image
+        disk->base = DiskStore::lookup(disk->baseHash);
+        
+        if (disk->storedByReference) {
+            
+            if (!disk->base) {
+                disk->warn("Base image %llx is unavailable\n", disk->baseHash);
+                delete disk;
+                return NULL;
+            }
+            
+            // Restore all unmodified tracks from the base image
+            const u8 *src = disk->base->data();
+            for (int t = 0; t < 168; t++) {
+                if (!disk->dirty[t]) {
+                    memcpy(disk->data.track[t], src + t * trackSize, trackSize);
+                }
+            }
+        }
+        
+        if (!disk->base) disk->discardBaseImage();
+    }
+    
     return disk;
 }
 
@@ -61,6 +87,7 @@ Disk::writeByte(u8 value, Cylinder cylinder, Side side, u16 offset)
     assert(offset < trackSize);
 
     data.cyclinder[cylinder][side][offset] = value;
+    dirty[2 * cylinder + side] = true;
 }
 
 void
@@ -82,6 +109,22 @@ Disk::clearDisk()
     }
     
     fnv = 0;
+    discardBaseImage();
+}
+
+void
+Disk::recordBaseImage()
+{
+    base = DiskStore::add(data.raw, sizeof(data.raw), &baseHash);
+    for (int t = 0; t < 168; t++) dirty[t] = false;
+}
+
+void
+Disk::discardBaseImage()
+{
+    base = NULL;
+    baseHash = 0;
+    for (int t = 0; t < 168; t++) dirty[t] = true;
 }
 
 void
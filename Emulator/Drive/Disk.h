@@ -11,10 +11,13 @@
 #define _AMIGA_DISK_H
 
 #include "HardwareComponent.h"
+#include "DiskStore.h"
 
 class Disk : public AmigaObject {
     
     friend class Drive;
+    friend class InputRecorder;
+    friend class Snapshot;
     
     //
     // Constants
@@ -84,6 +87,22 @@ class Disk : public AmigaObject {
     // Checksum of this disk if it was created from an ADF file, 0 otherwise
     u64 fnv;
     
+    /* The MFM data this disk has been created with. If the disk was created
+     * from a disk file, the initial MFM data is recorded in the disk store and
+     * the tracks written to afterwards are marked as dirty. This enables
+     * snapshots to store the disk as a reference plus all modified tracks.
+     */
+    DiskImage base;
+    
+    // Checksum of the base image (0 if there is no base image)
+    u64 baseHash;
+    
+    // Tracks that differ from the base image
+    bool dirty[168];
+    
+    // Indicates if the disk is serialized as a reference to the base image
+    bool storedByReference;
+    
     
     //
     // Constructing and serializing
@@ -106,13 +125,28 @@ private:
     template <class T>
     void applyToPersistentItems(T& worker)
     {
+        // Determine the storage format (overwritten when loading)
+        storedByReference = baseHash && serDiskReferences;
+        
         worker
 
         & type
-        & data.raw
         & writeProtected
         & modified
-        & fnv;
+        & fnv
+        & baseHash
+        & dirty
+        & storedByReference;
+        
+        if (storedByReference) {
+            
+            // Only store the tracks that differ from the base image
+            for (int t = 0; t < 168; t++) if (dirty[t]) worker & data.track[t];
+            
+        } else {
+            
+            worker & data.raw;
+        }
     }
 
 
@@ -152,6 +186,12 @@ public:
 
     // Initializes the disk with random data
     void clearDisk();
+    
+    // Records the current MFM data as the base image in the disk store
+    void recordBaseImage();
+    
+    // Forgets about the base image
+    void discardBaseImage();
 
     // Initializes a single track with random data or a specific value
     void clearTrack(Track t);
@@ -0,0 +1,65 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "DiskStore.h"
+
+std::mutex DiskStore::lock;
+map<u64, std::weak_ptr<const vector<u8>>> DiskStore::images;
+std::deque<DiskImage> DiskStore::retained;
+
+DiskImage
+DiskStore::add(const u8 *data, size_t size, u64 *hash)
+{
+    assert(data != NULL);
+    assert(hash != NULL);
+    
+    *hash = fnv_1a_64(data, size);
+    
+    std::lock_guard<std::mutex> guard(lock);
+    
+    // Reuse the existing image if the same data has been stored before
+    DiskImage image = images[*hash].lock();
+    
+    if (!image || image->size() != size || memcmp(image->data(), data, size)) {
+        
+        image = std::make_shared<const vector<u8>>(data, data + size);
+        images[*hash] = image;
+    }
+    
+    retain(image);
+    return image;
+}
+
+DiskImage
+DiskStore::lookup(u64 hash)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    
+    auto it = images.find(hash);
+    if (it == images.end()) return NULL;
+    
+    DiskImage image = it->second.lock();
+    
+    // Remove the entry if the image has been freed
+    if (!image) { images.erase(it); return NULL; }
+
+    retain(image);
+    return image;
+}
+
+void
+DiskStore::retain(DiskImage image)
+{
+    for (auto it = retained.begin(); it != retained.end(); it++) {
+        if (*it == image) { retained.erase(it); break; }
+    }
+    
+    retained.push_front(image);
+    if (retained.size() > retainCount) retained.pop_back();
+}
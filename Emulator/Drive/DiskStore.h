@@ -0,0 +1,58 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef _DISK_STORE_H
+#define _DISK_STORE_H
+
+#include "AmigaObject.h"
+
+#include <deque>
+#include <memory>
+
+typedef std::shared_ptr<const vector<u8>> DiskImage;
+
+/* Content-addressed storage for the MFM data of inserted disks. When a disk is
+ * created from a disk file, its MFM encoded data is recorded here as the
+ * disk's base image. In-process snapshots can then refer to the base image by
+ * its checksum and only need to include the tracks that have been written to
+ * since the disk has been inserted.
+ *
+ * The store is shared by all emulator instances. Images are kept alive as
+ * long as a disk refers to them. In addition, the most recently used images
+ * are retained to keep snapshots of ejected disks restorable.
+ */
+class DiskStore {
+    
+    // Number of unreferenced images that are retained
+    static const size_t retainCount = 8;
+    
+    // Protects the static members of this class
+    static std::mutex lock;
+    
+    // All known images, indexed by their checksum
+    static map<u64, std::weak_ptr<const vector<u8>>> images;
+    
+    // The most recently used images
+    static std::deque<DiskImage> retained;
+    
+public:
+    
+    // Adds an image to the store and returns a reference to it
+    static DiskImage add(const u8 *data, size_t size, u64 *hash);
+    
+    // Looks up an image (returns NULL if the image is not available)
+    static DiskImage lookup(u64 hash);
+    
+private:
+    
+    // Moves an image to the front of the retain list
+    static void retain(DiskImage image);
+};
+
+#endif
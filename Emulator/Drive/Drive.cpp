@@ -130,7 +130,7 @@ Drive::_size()
 {
     SerCounter counter;
 
-    applyToPersistentItems(counter);
+    if (!serSkipPersistentItems) applyToPersistentItems(counter);
     applyToHardResetItems(counter);
     applyToResetItems(counter);
 
@@ -172,6 +172,9 @@ Drive::_load(u8 *buffer)
         DiskType diskType;
         reader & diskType;
         disk = Disk::makeWithReader(reader, diskType);
+
+        // Don't silently drop a disk that cannot be recreated
+        if (!disk) serLoadError = true;
     }
 
     trace(SNP_DEBUG, "Recreated from %d bytes\n", reader.ptr - buffer);
@@ -184,7 +187,7 @@ Drive::_save(u8 *buffer)
     SerWriter writer(buffer);
 
     // Write own state
-    applyToPersistentItems(writer);
+    if (!serSkipPersistentItems) applyToPersistentItems(writer);
     applyToHardResetItems(writer);
     applyToResetItems(writer);
 
@@ -561,6 +564,8 @@ Drive::ejectDisk()
 {
     trace(DSK_DEBUG, "ejectDisk()\n");
 
+    if (amiga.inputRecorder.intercept(INP_DISK_EJECT, nr, 0)) return;
+
     if (disk) {
         
         // Flag disk change in the CIAA::PA
@@ -580,6 +585,8 @@ Drive::insertDisk(Disk *disk)
 {
     trace(DSK_DEBUG, "insertDisk(%p)", disk);
 
+    if (disk && amiga.inputRecorder.intercept(nr, disk)) return;
+
     if (disk) {
 
         // Don't insert a disk if there is already one
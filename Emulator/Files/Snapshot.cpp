@@ -21,7 +21,15 @@ Thumbnail::makeWithAmiga(Amiga *amiga, int dx, int dy)
 void
 Thumbnail::take(Amiga *amiga, int dx, int dy)
 {
-    u32 *source = (u32 *)amiga->denise.pixelEngine.getStableBuffer().data;
+    ScreenBuffer buffer = amiga->denise.pixelEngine.acquireBuffer();
+    take(amiga, buffer, dx, dy);
+    amiga->denise.pixelEngine.releaseBuffer(buffer);
+}
+
+void
+Thumbnail::take(Amiga *amiga, const ScreenBuffer &buffer, int dx, int dy)
+{
+    PixelEngine &pixelEngine = amiga->denise.pixelEngine;
     u32 *target = screen;
     
     int xStart = 4 * HBLANK_MAX + 1, xEnd = HPIXELS + 4 * HBLANK_MIN;
@@ -30,13 +38,12 @@ Thumbnail::take(Amiga *amiga, int dx, int dy)
     width  = (xEnd - xStart) / dx;
     height = (yEnd - yStart) / dy;
     
-    source += xStart + yStart * HPIXELS;
-    
+    // In compact output modes, the pixels are read from the output buffer
     for (unsigned y = 0; y < height; y++) {
         for (unsigned x = 0; x < width; x++) {
-            target[x] = source[x * dx];
+            target[x] = pixelEngine.getPixel(buffer,
+                                             xStart + x * dx, yStart + y * dy);
         }
-        source += dy * HPIXELS;
         target += width;
     }
     
@@ -162,16 +169,51 @@ Snapshot::makeWithFile(const char *path)
 }
 
 Snapshot *
-Snapshot::makeWithAmiga(Amiga *amiga)
+Snapshot::makeWithAmiga(Amiga *amiga, bool native)
 {
-    Snapshot *snapshot = new Snapshot(amiga->size());
+    // In-process snapshots refer to the disks in the disk store
+    NativeByteOrder order(native);
+    DiskReferences references;
+
+    Snapshot *snapshot = new Snapshot(amiga->sectionedSize());
 
     snapshot->getHeader()->screenshot.take(amiga);
-    amiga->save(snapshot->getData());
+    amiga->saveSections(snapshot->getData());
+    snapshot->recordDiskReferences(amiga);
+    snapshot->native = native;
 
     return snapshot;
 }
 
+void
+Snapshot::recordDiskReferences(Amiga *amiga)
+{
+    assert(serDiskReferences);
+    
+    references = true;
+    diskReferences.clear();
+    
+    for (Drive *drive : amiga->df) {
+        
+        if (!drive->hasDisk() || !drive->disk->baseHash) continue;
+        
+        auto &components = amiga->subComponents;
+        auto it = std::find(components.begin(), components.end(), drive);
+        assert(it != components.end());
+        
+        // The serialized disk is located at the end of the drive section
+        SerCounter counter;
+        drive->disk->applyToPersistentItems(counter);
+        
+        DiskReference ref;
+        ref.section = it - components.begin();
+        ref.offset = drive->size() - counter.count;
+        ref.type = drive->disk->getType();
+        ref.base = drive->disk->base;
+        diskReferences.push_back(ref);
+    }
+}
+
 bool
 Snapshot::bufferHasSameType(const u8* buffer, size_t length)
 {
@@ -183,3 +225,250 @@ Snapshot::fileHasSameType(const char *path)
 {
     return Snapshot::isSnapshotFile(path, V_MAJOR, V_MINOR, V_SUBMINOR);
 }
+
+size_t
+Snapshot::writeToBuffer(u8 *buffer)
+{
+    // Snapshots in native byte order must not leave the machine
+    if (native) {
+        warn("Native snapshots cannot be exported\n");
+        return 0;
+    }
+    
+    // Disks stored as references must be written in full
+    if (!diskReferences.empty()) return writeExpanded(buffer);
+    
+    return AmigaFile::writeToBuffer(buffer);
+}
+
+size_t
+Snapshot::writeExpanded(u8 *buffer)
+{
+    NativeByteOrder order(false);
+    DiskReferences fullDisks(false);
+    
+    // Read the table of contents
+    u8 *ptr = getData() + 4;
+    size_t count = read32(ptr);
+    vector<size_t> offset(count), length(count), newLength(count);
+    for (size_t i = 0; i < count; i++) {
+        offset[i] = read64(ptr);
+        length[i] = read64(ptr);
+        newLength[i] = length[i];
+    }
+    
+    // Recreate the referenced disks (we keep their base images alive)
+    vector<Disk *> disks(count, NULL);
+    vector<size_t> diskOffset(count, 0);
+    for (DiskReference &ref : diskReferences) {
+        
+        size_t i = ref.section;
+        SerReader reader(getData() + offset[i] + ref.offset);
+        Disk *disk = Disk::makeWithReader(reader, ref.type);
+        assert(disk != NULL);
+        assert(reader.ptr == getData() + offset[i] + length[i]);
+        
+        SerCounter counter;
+        disk->applyToPersistentItems(counter);
+        newLength[i] = ref.offset + counter.count;
+        diskOffset[i] = ref.offset;
+        disks[i] = disk;
+    }
+    
+    // Determine the size of the exported snapshot (the TOC precedes section 0)
+    size_t result = sizeof(SnapshotHeader) + offset[0];
+    for (size_t i = 0; i < count; i++) result += newLength[i];
+    
+    if (buffer) {
+        
+        // Write the header and the table of contents
+        memcpy(buffer, data, sizeof(SnapshotHeader) + 8);
+        u8 *dst = buffer + sizeof(SnapshotHeader) + 8;
+        size_t pos = offset[0];
+        for (size_t i = 0; i < count; i++) {
+            write64(dst, pos);
+            write64(dst, newLength[i]);
+            pos += newLength[i];
+        }
+        
+        // Write all sections
+        for (size_t i = 0; i < count; i++) {
+            
+            const u8 *src = getData() + offset[i];
+            
+            if (disks[i]) {
+                
+                // Keep the drive state and replace the serialized disk
+                memcpy(dst, src, diskOffset[i]);
+                SerWriter writer(dst + diskOffset[i]);
+                disks[i]->applyToPersistentItems(writer);
+                
+            } else {
+                
+                memcpy(dst, src, length[i]);
+            }
+            dst += newLength[i];
+        }
+        assert((size_t)(dst - buffer) == result);
+    }
+    
+    for (Disk *disk : disks) delete disk;
+    return result;
+}
+
+SnapshotWorker::SnapshotWorker(Amiga& ref) : amiga(ref)
+{
+    setDescription("SnapshotWorker");
+    
+    worker = std::thread(&SnapshotWorker::main, this);
+}
+
+SnapshotWorker::~SnapshotWorker()
+{
+    {   std::unique_lock<std::mutex> lock(jobLock);
+        quit = true;
+    }
+    jobAvailable.notify_one();
+    worker.join();
+    
+    delete autoSnapshot;
+    delete userSnapshot;
+}
+
+void
+SnapshotWorker::capture(MessageType type)
+{
+    assert(type == MSG_AUTO_SNAPSHOT_TAKEN || type == MSG_USER_SNAPSHOT_TAKEN);
+    
+    Job job;
+    job.type = type;
+    job.snapshot = NULL;
+    
+    // The snapshot stays in-process until it is exported
+    DiskReferences references;
+    size_t size = amiga.sectionedSize();
+    
+    // Take the pre-allocated buffer if it has the proper size
+    {   std::unique_lock<std::mutex> lock(jobLock);
+        if (spare && spare->getDataSize() == size) {
+            job.snapshot = spare;
+            spare = NULL;
+        }
+    }
+    if (!job.snapshot) job.snapshot = new Snapshot(size);
+    
+    // Serialize the internal state
+    amiga.saveSections(job.snapshot->getData());
+    job.snapshot->recordDiskReferences(&amiga);
+    
+    // Keep the emulator from overwriting the frame until the thumbnail is taken
+    job.frame = amiga.denise.pixelEngine.acquireBuffer();
+    
+    // Hand the job over to the worker thread
+    {   std::unique_lock<std::mutex> lock(jobLock);
+        jobs.push(job);
+    }
+    jobAvailable.notify_one();
+}
+
+void
+SnapshotWorker::flush()
+{
+    std::unique_lock<std::mutex> lock(jobLock);
+    jobsDone.wait(lock, [this] { return jobs.empty() && busy == 0; });
+}
+
+Snapshot *
+SnapshotWorker::latestAutoSnapshot()
+{
+    std::unique_lock<std::mutex> lock(jobLock);
+    
+    Snapshot *result = autoSnapshot;
+    autoSnapshot = NULL;
+    return result;
+}
+
+Snapshot *
+SnapshotWorker::latestUserSnapshot()
+{
+    std::unique_lock<std::mutex> lock(jobLock);
+    
+    Snapshot *result = userSnapshot;
+    userSnapshot = NULL;
+    return result;
+}
+
+void
+SnapshotWorker::main()
+{
+    std::unique_lock<std::mutex> lock(jobLock);
+    
+    while (1) {
+        
+        jobAvailable.wait(lock, [this] { return quit || !jobs.empty(); });
+        if (jobs.empty()) break;
+        
+        Job job = jobs.front();
+        jobs.pop();
+        busy++;
+        
+        // Once published, the snapshot may be claimed by the GUI any time
+        size_t size = job.snapshot->getDataSize();
+        
+        // Do the heavy lifting without holding the lock
+        lock.unlock();
+        finalize(job);
+        lock.lock();
+        
+        busy--;
+        jobsDone.notify_all();
+        
+        // Inform the GUI
+        lock.unlock();
+        amiga.messageQueue.put(job.type);
+        prepareSpare(size);
+        lock.lock();
+    }
+    
+    delete spare;
+    spare = NULL;
+}
+
+void
+SnapshotWorker::finalize(Job &job)
+{
+    trace(SNP_DEBUG, "Finalizing snapshot (%s)\n",
+          job.type == MSG_AUTO_SNAPSHOT_TAKEN ? "auto" : "user");
+    
+    // Take the thumbnail and hand the frame buffer back
+    job.snapshot->getHeader()->screenshot.take(&amiga, job.frame);
+    amiga.denise.pixelEngine.releaseBuffer(job.frame);
+    
+    Snapshot *predecessor;
+    
+    // Make the snapshot available. An unclaimed predecessor is discarded
+    {   std::unique_lock<std::mutex> lock(jobLock);
+        Snapshot *&slot =
+        job.type == MSG_AUTO_SNAPSHOT_TAKEN ? autoSnapshot : userSnapshot;
+        predecessor = slot;
+        slot = job.snapshot;
+    }
+    delete predecessor;
+}
+
+void
+SnapshotWorker::prepareSpare(size_t size)
+{
+    {   std::unique_lock<std::mutex> lock(jobLock);
+        if (spare && spare->getDataSize() == size) return;
+    }
+    
+    // Allocate the buffer and touch all pages outside the emulator thread
+    Snapshot *snapshot = new Snapshot(size);
+    memset(snapshot->getData(), 0, size);
+    
+    {   std::unique_lock<std::mutex> lock(jobLock);
+        std::swap(spare, snapshot);
+    }
+    delete snapshot;
+}
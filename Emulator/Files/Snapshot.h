@@ -11,6 +11,9 @@
 #define _SNAPSHOT_H
 
 #include "AmigaFile.h"
+#include "DiskStore.h"
+
+#include <condition_variable>
 
 class Amiga;
 
@@ -30,6 +33,9 @@ struct Thumbnail {
     
     // Takes a screenshot from a given Amiga
     void take(Amiga *amiga, int dx = 2, int dy = 1);
+    
+    // Takes a screenshot from a frame buffer reserved with acquireBuffer()
+    void take(Amiga *amiga, const ScreenBuffer &buffer, int dx = 2, int dy = 1);
 };
 
 struct SnapshotHeader {
@@ -48,6 +54,37 @@ struct SnapshotHeader {
 
 class Snapshot : public AmigaFile {
  
+    /* Indicates if the state has been saved in native byte order. Such
+     * snapshots are faster to create and restore, but they are meant for
+     * in-process use only (e.g., rewinding). They cannot be written to disk.
+     */
+    bool native = false;
+    
+    /* Indicates if inserted disks have been saved as references into the disk
+     * store (see class DiskReferences). The state of such snapshots can only
+     * be restored inside the current process. When the snapshot is exported,
+     * all referenced disks are written in full.
+     */
+    bool references = false;
+    
+    // A disk that has been saved as a reference into the disk store
+    struct DiskReference {
+        
+        // Section and position of the serialized disk inside the core data
+        size_t section;
+        size_t offset;
+        
+        // Type of the disk
+        DiskType type;
+        
+        // Keeps the base image available as long as the snapshot exists
+        DiskImage base;
+    };
+    
+    // All disks that have been saved as references
+    vector<DiskReference> diskReferences;
+    
+    
     //
     // Class methods
     //
@@ -92,7 +129,7 @@ public:
     
     static Snapshot *makeWithFile(const char *filename);
     static Snapshot *makeWithBuffer(const u8 *buffer, size_t size);
-    static Snapshot *makeWithAmiga(Amiga *amiga);
+    static Snapshot *makeWithAmiga(Amiga *amiga, bool native = false);
     
     
     //
@@ -103,6 +140,12 @@ public:
     const char *typeAsString() override { return "VAMIGA"; }
     bool bufferHasSameType(const u8 *buffer, size_t length) override;
     bool fileHasSameType(const char *filename) override;
+    size_t writeToBuffer(u8 *buffer) override;
+    
+private:
+    
+    // Writes the snapshot with all referenced disks stored in full
+    size_t writeExpanded(u8 *buffer);
     
     
     //
@@ -116,6 +159,21 @@ public:
     
     // Returns pointer to core data
     u8 *getData() { return data + sizeof(SnapshotHeader); }
+
+    // Returns the size of the core data in bytes
+    size_t getDataSize() { return size - sizeof(SnapshotHeader); }
+    
+    // Checks whether the core data is stored in native byte order
+    bool isNative() { return native; }
+    
+    // Checks whether inserted disks are stored as references
+    bool hasDiskReferences() { return references; }
+    
+    /* Records all disks that have been saved as references. This function
+     * must be called right after the state of the Amiga has been saved with
+     * the DiskReferences flag set.
+     */
+    void recordDiskReferences(Amiga *amiga);
     
     // Returns the timestamp
     // GET DIRECTLY FROM SCREENSHOT
@@ -134,4 +192,102 @@ public:
     unsigned getImageHeight() { return getHeader()->screenshot.height; }
 };
 
+/* Finalizes snapshots in the background. Taking a snapshot inside the run loop
+ * is split into two parts. On the emulator thread, capture() serializes the
+ * component state and reserves the stable frame buffer via acquireBuffer().
+ * To keep this part short, the state is written into a buffer that has been
+ * allocated and touched by the worker thread beforehand. All remaining work
+ * (downsampling the frame buffer into the thumbnail, disposing an unclaimed
+ * predecessor, handing the snapshot over to the GUI, preparing the buffer
+ * for the next snapshot) is carried out by the worker thread. Once a
+ * snapshot is ready, MSG_AUTO_SNAPSHOT_TAKEN or MSG_USER_SNAPSHOT_TAKEN is
+ * sent.
+ */
+class SnapshotWorker : public AmigaObject {
+    
+    // A snapshot waiting to be finalized
+    struct Job {
+        
+        // The captured snapshot
+        Snapshot *snapshot;
+        
+        // The frame buffer the thumbnail is taken from (acquired)
+        ScreenBuffer frame;
+        
+        // Message to send after finalization
+        MessageType type;
+    };
+    
+    // Reference to the emulated Amiga
+    Amiga &amiga;
+    
+    // The worker thread
+    std::thread worker;
+    
+    // Synchronization primitives
+    std::mutex jobLock;
+    std::condition_variable jobAvailable;
+    std::condition_variable jobsDone;
+    
+    // Snapshots waiting to be finalized
+    std::queue<Job> jobs;
+    
+    // Number of jobs that have been picked up, but are not finished yet
+    int busy = 0;
+    
+    // Indicates that the worker thread should terminate
+    bool quit = false;
+    
+    // Finalized snapshots waiting to be picked up by the GUI
+    Snapshot *autoSnapshot = NULL;
+    Snapshot *userSnapshot = NULL;
+    
+    // Pre-allocated snapshot for the next call to capture()
+    Snapshot *spare = NULL;
+    
+    
+    //
+    // Initializing
+    //
+    
+public:
+    
+    SnapshotWorker(Amiga& ref);
+    ~SnapshotWorker();
+    
+    
+    //
+    // Taking snapshots
+    //
+    
+public:
+    
+    /* Records the current emulator state and schedules the snapshot for
+     * finalization. type must be MSG_AUTO_SNAPSHOT_TAKEN or
+     * MSG_USER_SNAPSHOT_TAKEN.
+     */
+    void capture(MessageType type);
+    
+    /* Blocks until all scheduled snapshots have been finalized. This function
+     * is called when the emulator is paused or powered off to make sure that
+     * all snapshots taken so far are available to the GUI.
+     */
+    void flush();
+    
+    // Returns the most recent finalized snapshot or NULL if none is available
+    Snapshot *latestAutoSnapshot();
+    Snapshot *latestUserSnapshot();
+    
+private:
+    
+    // The thread enter function
+    void main();
+    
+    // Completes a snapshot
+    void finalize(Job &job);
+    
+    // Provides an allocated and touched buffer for the next snapshot
+    void prepareSpare(size_t size);
+};
+
 #endif
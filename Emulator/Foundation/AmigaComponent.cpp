@@ -21,6 +21,7 @@ agnus(ref.agnus),
 copper(ref.agnus.copper),
 blitter(ref.agnus.blitter),
 dmaDebugger(ref.agnus.dmaDebugger),
+dmaProfiler(ref.agnus.dmaProfiler),
 denise(ref.denise),
 pixelEngine(ref.denise.pixelEngine),
 paula(ref.paula),
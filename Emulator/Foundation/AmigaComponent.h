@@ -24,6 +24,7 @@ class Agnus;
 class Copper;
 class Blitter;
 class DmaDebugger;
+class DmaProfiler;
 class Denise;
 class PixelEngine;
 class Paula;
@@ -56,6 +57,7 @@ protected:
     Copper &copper;
     Blitter &blitter;
     DmaDebugger &dmaDebugger;
+    DmaProfiler &dmaProfiler;
     Denise &denise;
     PixelEngine &pixelEngine;
     Paula &paula;
@@ -8,15 +8,18 @@
 // -----------------------------------------------------------------------------
 
 /* The emulator uses buffers at various places. Most of them are derived from
- * one of the following two classes:
+ * one of the following classes:
  *
  *           RingBuffer : A standard ringbuffer data structure
  *     SortedRingBuffer : A ringbuffer that keeps the entries sorted
+ *            SPSCQueue : A lock-free queue connecting two threads
  */
 
 #ifndef _BUFFERS_H
 #define _BUFFERS_H
 
+#include <atomic>
+
 template <class T, int capacity> struct RingBuffer
 {
     // Element storage
@@ -193,6 +196,16 @@ struct RegChangeRecorder : public SortedRingBuffer<RegChange, capacity>
         return this->isEmpty() ? NEVER : this->keys[this->r];
     }
 
+    // Computes a checksum over all recorded register changes
+    u64 checksum(u64 hash)
+    {
+        for (int i = this->r; i != this->w; i = this->next(i)) {
+            hash = fnv_1a_it64(hash, this->keys[i]);
+            hash = fnv_1a_it64(hash, (u64)this->elements[i].addr << 16 | this->elements[i].value);
+        }
+        return hash;
+    }
+
     void dump()
     {
         printf("%d elements (r = %d w = %d):\n", this->count(), this->r, this->w);
@@ -205,4 +218,47 @@ struct RegChangeRecorder : public SortedRingBuffer<RegChange, capacity>
     }
 };
 
+/* A bounded single-producer single-consumer queue. The producer and the
+ * consumer run in different threads and communicate without locks. To avoid
+ * copying large elements, the producer fills in a reserved slot directly and
+ * the consumer processes the element in place before releasing the slot.
+ */
+template <class T, int capacity> struct SPSCQueue
+{
+    // Element storage
+    T elements[capacity];
+
+    // Number of elements written by the producer and read by the consumer
+    std::atomic<u64> written { 0 };
+    std::atomic<u64> read { 0 };
+
+    u64 count() const { return written.load() - read.load(); }
+    bool isEmpty() const { return count() == 0; }
+    bool isFull() const { return count() == capacity; }
+
+    // Producer: Returns a free slot or NULL if the queue is full
+    T *reserve() {
+        u64 w = written.load(std::memory_order_relaxed);
+        if (w - read.load(std::memory_order_acquire) == capacity) return NULL;
+        return &elements[w % capacity];
+    }
+
+    // Producer: Hands the reserved slot over to the consumer
+    void publish() {
+        written.store(written.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: Returns the oldest element or NULL if the queue is empty
+    T *front() {
+        u64 r = read.load(std::memory_order_relaxed);
+        if (r == written.load(std::memory_order_acquire)) return NULL;
+        return &elements[r % capacity];
+    }
+
+    // Consumer: Releases the oldest element
+    void pop() {
+        read.store(read.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
 #endif
@@ -8,6 +8,109 @@
 // -----------------------------------------------------------------------------
 
 #include "Amiga.h"
+#include <algorithm>
+#include <condition_variable>
+
+/* A set of worker threads used by parallelFor(). The threads are created
+ * once and sleep on a condition variable until work is handed over. The
+ * calling thread participates in the work, too. Calls from different threads
+ * are serialized.
+ */
+class WorkerPool {
+    
+    vector<std::thread> threads;
+    
+    // Serializes calls to run()
+    std::mutex runLock;
+    
+    // Synchronization primitives guarding the variables below
+    std::mutex lock;
+    std::condition_variable wakeUp;
+    std::condition_variable finished;
+    
+    // The current job and the next index to process
+    std::function<void(size_t)> *job = NULL;
+    size_t count = 0;
+    std::atomic<size_t> next { 0 };
+    
+    // Incremented whenever a new job is handed over
+    u64 generation = 0;
+    
+    // Number of worker threads still working on the current job
+    size_t busy = 0;
+    
+    // Indicates that the worker threads should terminate
+    bool quit = false;
+    
+public:
+    
+    WorkerPool(size_t numThreads)
+    {
+        // The calling thread is one of the workers
+        for (size_t i = 1; i < numThreads; i++) {
+            threads.push_back(std::thread(&WorkerPool::main, this));
+        }
+    }
+    
+    ~WorkerPool()
+    {
+        {   std::unique_lock<std::mutex> l(lock);
+            quit = true;
+        }
+        wakeUp.notify_all();
+        for (auto &t : threads) t.join();
+    }
+    
+    void run(size_t count, std::function<void(size_t)> &func)
+    {
+        std::unique_lock<std::mutex> r(runLock);
+        
+        // Hand the job over to the worker threads
+        {   std::unique_lock<std::mutex> l(lock);
+            job = &func;
+            this->count = count;
+            next = 0;
+            busy = threads.size();
+            generation++;
+        }
+        wakeUp.notify_all();
+        
+        // Participate
+        process();
+        
+        // Wait until all worker threads have finished
+        {   std::unique_lock<std::mutex> l(lock);
+            finished.wait(l, [this] { return busy == 0; });
+            job = NULL;
+        }
+    }
+    
+private:
+    
+    void process()
+    {
+        for (size_t i = next++; i < count; i = next++) (*job)(i);
+    }
+    
+    void main()
+    {
+        std::unique_lock<std::mutex> l(lock);
+        u64 seen = 0;
+        
+        while (1) {
+            
+            wakeUp.wait(l, [&] { return quit || generation != seen; });
+            if (quit) break;
+            seen = generation;
+            
+            l.unlock();
+            process();
+            l.lock();
+            
+            if (--busy == 0) finished.notify_all();
+        }
+    }
+};
 
 HardwareComponent::~HardwareComponent()
 {
@@ -129,8 +232,9 @@ HardwareComponent::load(u8 *buffer)
     ptr += didLoadFromBuffer(ptr);
 
     // Verify that the number of written bytes matches the snapshot size
+    // (the state is incomplete if some data could not be restored)
     trace(SNP_DEBUG, "Loaded %d bytes (expected %d)\n", ptr - buffer, size());
-    assert(ptr - buffer == size());
+    assert(serLoadError || ptr - buffer == size());
 
     return ptr - buffer;
 }
@@ -161,6 +265,315 @@ HardwareComponent::save(u8 *buffer)
     return ptr - buffer;
 }
 
+bool
+HardwareComponent::isSectioned(const u8 *buffer)
+{
+    u8 signature[] = { 'S', 'E', 'C', 'T' };
+    
+    return matchingBufferHeader(buffer, signature, sizeof(signature));
+}
+
+size_t
+HardwareComponent::sectionedSize()
+{
+    vector<MemoryBlockRef> blocks = memoryBlocks();
+    size_t result = tocSize(subComponents.size() + 1 + blocks.size());
+
+    // Memory blocks are stored in separate sections
+    SkipMemoryBlocks skip;
+    result += size();
+
+    for (auto &b : blocks) {
+
+        size_t size;
+        b.owner->memoryBlock(b.nr, size);
+        result += size;
+    }
+
+    return result;
+}
+
+size_t
+HardwareComponent::saveSections(u8 *buffer)
+{
+    size_t n = subComponents.size();
+    vector<MemoryBlockRef> blocks = memoryBlocks();
+    size_t count = n + 1 + blocks.size();
+    vector<size_t> offset(count), length(count);
+    vector<u8 *> data(count);
+    
+    // Determine the layout
+    SkipMemoryBlocks skip;
+    size_t pos = tocSize(count);
+    for (size_t i = 0; i < count; i++) {
+        if (i < n) {
+            length[i] = subComponents[i]->size();
+        } else if (i == n) {
+            length[i] = _size();
+        } else {
+            data[i] = blocks[i - n - 1].owner->memoryBlock(blocks[i - n - 1].nr, length[i]);
+        }
+        offset[i] = pos;
+        pos += length[i];
+    }
+    
+    // Write the table of contents
+    u8 *ptr = buffer;
+    write8(ptr, 'S'); write8(ptr, 'E'); write8(ptr, 'C'); write8(ptr, 'T');
+    write32(ptr, (u32)count);
+    for (size_t i = 0; i < count; i++) {
+        write64(ptr, offset[i]);
+        write64(ptr, length[i]);
+    }
+    
+    // Save all sections in parallel
+    bool native = serNativeByteOrder;
+    bool references = serDiskReferences;
+    parallelFor(count, [&](size_t i) {
+        
+        if (i > n) {
+            if (length[i]) memcpy(buffer + offset[i], data[i], length[i]);
+            return;
+        }
+
+        NativeByteOrder order(native);
+        DiskReferences diskReferences(references);
+        SkipMemoryBlocks skip;
+        size_t bytes = i < n ?
+        subComponents[i]->save(buffer + offset[i]) :
+        saveOwnState(buffer + offset[i]);
+        
+        assert(bytes == length[i]);
+    });
+    
+    trace(SNP_DEBUG, "Saved %zu sections (%zu bytes)\n", count, pos);
+    return pos;
+}
+
+bool
+HardwareComponent::loadSections(u8 *buffer, size_t length,
+                                const vector<HardwareComponent *> &selection)
+{
+    size_t n = subComponents.size();
+    vector<MemoryBlockRef> blocks = memoryBlocks();
+    size_t count = n + 1 + blocks.size();
+    vector<size_t> offset(count), sizes(count);
+    
+    // Read the table of contents
+    if (length < tocSize(count) || !isSectioned(buffer)) {
+        warn("Table of contents is missing. Ignoring data.\n");
+        return false;
+    }
+    u8 *ptr = buffer + 4;
+    if (read32(ptr) != count) {
+        warn("Section count mismatch. Ignoring data.\n");
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        
+        offset[i] = read64(ptr);
+        sizes[i] = read64(ptr);
+        
+        if (offset[i] < tocSize(count) ||
+            offset[i] > length || sizes[i] > length - offset[i]) {
+            warn("Section %zu exceeds the buffer. Ignoring data.\n", i);
+            return false;
+        }
+    }
+    
+    // Determine the sections to restore
+    vector<bool> restore(n + 1, selection.empty());
+    for (HardwareComponent *c : selection) {
+        
+        auto it = std::find(subComponents.begin(), subComponents.end(), c);
+        if (it == subComponents.end()) {
+            warn("%s is not a direct subcomponent of %s. Ignoring data.\n",
+                 c->getDescription(), getDescription());
+            return false;
+        }
+        restore[it - subComponents.begin()] = true;
+    }
+    
+    /* Load all selected components one after another (see header file). From
+     * here on, a corrupt section leaves a partially restored state behind
+     * which is cleaned up by a hard reset.
+     */
+    SkipMemoryBlocks skip;
+    serLoadError = false;
+    for (size_t i = 0; i <= n; i++) {
+        
+        if (!restore[i]) continue;
+        
+        size_t bytes = i < n ?
+        subComponents[i]->load(buffer + offset[i]) :
+        loadOwnState(buffer + offset[i]);
+        
+        if (serLoadError) {
+            warn("Section %zu: Data cannot be restored\n", i);
+            reset(true);
+            return false;
+        }
+        if (bytes != sizes[i]) {
+            warn("Section %zu: Loaded %zu bytes (expected %zu)\n",
+                 i, bytes, sizes[i]);
+            reset(true);
+            return false;
+        }
+    }
+    
+    // Check if the memory blocks have been allocated with the proper size
+    vector<u8 *> data(count);
+    for (size_t i = n + 1; i < count; i++) {
+        
+        MemoryBlockRef &b = blocks[i - n - 1];
+        if (!restore[b.section]) continue;
+        
+        size_t blockSize;
+        data[i] = b.owner->memoryBlock(b.nr, blockSize);
+        
+        if (blockSize != sizes[i]) {
+            warn("Section %zu: Memory block has %zu bytes (expected %zu)\n",
+                 i, blockSize, sizes[i]);
+            reset(true);
+            return false;
+        }
+    }
+    
+    // Copy the memory blocks in parallel
+    parallelFor(count - n - 1, [&](size_t i) {
+        
+        i += n + 1;
+        if (data[i] && sizes[i]) memcpy(data[i], buffer + offset[i], sizes[i]);
+    });
+    
+    return true;
+}
+
+vector<HardwareComponent::MemoryBlockRef>
+HardwareComponent::memoryBlocks()
+{
+    vector<MemoryBlockRef> result;
+    size_t n = subComponents.size();
+    
+    for (size_t i = 0; i < n; i++) {
+        subComponents[i]->collectMemoryBlocks(result, i);
+    }
+    for (size_t nr = 0; nr < memoryBlockCount(); nr++) {
+        result.push_back(MemoryBlockRef { this, nr, n });
+    }
+    
+    return result;
+}
+
+void
+HardwareComponent::collectMemoryBlocks(vector<MemoryBlockRef> &result,
+                                       size_t section)
+{
+    for (HardwareComponent *c : subComponents) {
+        c->collectMemoryBlocks(result, section);
+    }
+    for (size_t nr = 0; nr < memoryBlockCount(); nr++) {
+        result.push_back(MemoryBlockRef { this, nr, section });
+    }
+}
+
+u64
+HardwareComponent::hashState()
+{
+    u64 result = hashOwnState();
+
+    for (HardwareComponent *c : subComponents) {
+        result = fnv_1a_it64(result, c->hashState());
+    }
+
+    return result;
+}
+
+u64
+HardwareComponent::hashOwnState()
+{
+    // Reuse the serialization buffer to avoid frequent allocations
+    static thread_local vector<u8> buffer;
+
+    if (!hasGuestState()) return 0;
+
+    SkipPersistentItems skip;
+    SkipMemoryBlocks skipBlocks;
+    NativeByteOrder order;
+
+    size_t size = _size();
+    if (buffer.size() < size) buffer.resize(size);
+
+    size = saveOwnState(buffer.data());
+    assert(size == _size());
+
+    u64 result = fnv_1a_64x4(buffer.data(), size);
+
+    // Memory blocks are hashed separately
+    for (size_t nr = 0; nr < memoryBlockCount(); nr++) {
+        result = fnv_1a_it64(result, hashMemoryBlock(nr));
+    }
+
+    return result;
+}
+
+u64
+HardwareComponent::hashMemoryBlock(size_t nr)
+{
+    size_t size;
+    u8 *data = memoryBlock(nr, size);
+
+    return fnv_1a_64x4(data, size);
+}
+
+void
+HardwareComponent::findDivergences(HardwareComponent &other,
+                                   vector<HardwareComponent *> &result)
+{
+    assert(subComponents.size() == other.subComponents.size());
+
+    if (hashOwnState() != other.hashOwnState()) {
+        result.push_back(this);
+    }
+
+    for (size_t i = 0; i < subComponents.size(); i++) {
+        subComponents[i]->findDivergences(*other.subComponents[i], result);
+    }
+}
+
+size_t
+HardwareComponent::saveOwnState(u8 *buffer)
+{
+    u8 *ptr = buffer;
+    
+    ptr += willSaveToBuffer(ptr);
+    ptr += _save(ptr);
+    ptr += didSaveToBuffer(ptr);
+    
+    return ptr - buffer;
+}
+
+size_t
+HardwareComponent::loadOwnState(u8 *buffer)
+{
+    u8 *ptr = buffer;
+    
+    ptr += willLoadFromBuffer(ptr);
+    ptr += _load(ptr);
+    ptr += didLoadFromBuffer(ptr);
+    
+    return ptr - buffer;
+}
+
+void
+HardwareComponent::parallelFor(size_t count, std::function<void(size_t)> func)
+{
+    // The pool is created on first use and lives until the process ends
+    static WorkerPool pool(std::thread::hardware_concurrency());
+    
+    pool.run(count, func);
+}
+
 void
 HardwareComponent::powerOn()
 {
@@ -13,6 +13,9 @@
 #include "AmigaObject.h"
 #include "Serialization.h"
 
+#include <atomic>
+#include <functional>
+
 /* This class defines the base functionality of all hardware components. It
  * comprises functions for initializing, configuring, and serializing the
  * emulator, as well as functions for powering up and down, running and pausing.
@@ -166,6 +169,121 @@ public:
     virtual size_t willSaveToBuffer(u8 *buffer) {return 0; }
     virtual size_t didSaveToBuffer(u8 *buffer) { return 0; }
     
+    /* Memory blocks. Components owning big blocks of Ram or Rom expose them
+     * via these functions. Sectioned snapshots store each block in a section
+     * of its own (see below).
+     */
+    virtual size_t memoryBlockCount() { return 0; }
+    virtual u8 *memoryBlock(size_t nr, size_t &size) { size = 0; return NULL; }
+
+    /* Computes a hash over the contents of a memory block. Components may
+     * override this function to cache partial results, so that unmodified
+     * memory is not rehashed every time the state hash is computed.
+     */
+    virtual u64 hashMemoryBlock(size_t nr);
+
+    /* Sectioned serialization. In contrast to save(), which writes the state
+     * of all components into a single stream, saveSections() splits the data
+     * into separate sections: One for each subcomponent, one for the
+     * component itself, and one for each memory block found in the component
+     * tree. The sections are preceded by a table of contents:
+     *
+     *     u8[4]      : Magic bytes ('S','E','C','T')
+     *     u32        : Number of sections (n)
+     *     u64[n][2]  : Offset and length of each section
+     *     u8[]       : Section data
+     *
+     * Saving a component has no side effects. Hence, all sections are saved
+     * in parallel. Loading is different, because several components reach
+     * into other components while their state is restored:
+     *
+     *     Memory   : Reallocates all memory blocks and updates the memory
+     *                masks, which are read by other components (e.g., by
+     *                the Copper when flushing its cache).
+     *     Denise   : Recomputes the RGBA palette and flushes the render
+     *                thread of the pixel engine.
+     *     Drives   : Recreate their disks, possibly via the disk store.
+     *     Agnus    : Expects the Blitter's helper thread to be idle. Class
+     *                Amiga joins the helper thread before loading starts.
+     *
+     * Therefore, no component is loaded in parallel with another component.
+     * The component sections are loaded one after another in the same order
+     * as load() processes them. Only the memory block sections are copied in
+     * parallel. They are plain byte copies and are processed after all
+     * components have been loaded, i.e., after the blocks have been
+     * allocated with their final size.
+     */
+    
+    // Checks whether a buffer contains sectioned data
+    static bool isSectioned(const u8 *buffer);
+
+    // Returns the size of the sectioned state in bytes
+    size_t sectionedSize();
+    
+    // Saves the internal state in sectioned format
+    size_t saveSections(u8 *buffer);
+
+    /* Loads the internal state from sectioned data. If a selection is given,
+     * only the listed subcomponents (which must be direct subcomponents) are
+     * restored and the state of this component is left untouched. The
+     * function returns false if the data is rejected. If the table of
+     * contents is corrupt or the selection is invalid, nothing is loaded.
+     * If a section turns out to be corrupt or cannot be restored (see
+     * serLoadError), the state has already been partially overwritten. In
+     * this case, the component is hard-reset.
+     */
+    bool loadSections(u8 *buffer, size_t length,
+                      const vector<HardwareComponent *> &selection = {});
+
+    /* State hashes. hashState() computes a checksum over the state of this
+     * component and all of its subcomponents. hashOwnState() covers this
+     * component, only. Configuration items (persistent items) are excluded.
+     * Hence, two machines that only differ in their configuration produce
+     * the same hash as long as they behave identically. Components holding
+     * emulator-internal data, only, are excluded, too (see hasGuestState()).
+     */
+    u64 hashState();
+    u64 hashOwnState();
+
+    /* Indicates if the state of this component is part of the emulated
+     * machine. Components that only hold emulator-internal data (such as
+     * the audio buffers drained by the host) return false. Their state is
+     * not derived from the emulated machine alone (e.g., it is wiped out
+     * when a snapshot is restored) and is thus left out of state hashes.
+     */
+    virtual bool hasGuestState() { return true; }
+
+    /* Compares the state of this component with the state of a structurally
+     * identical component (e.g., the same component of another Amiga). All
+     * components whose own state differs are appended to the result vector.
+     */
+    void findDivergences(HardwareComponent &other,
+                         vector<HardwareComponent *> &result);
+    
+private:
+    
+    // A memory block and the section of the component it belongs to
+    struct MemoryBlockRef {
+
+        HardwareComponent *owner;
+        size_t nr;
+        size_t section;
+    };
+
+    // Collects all memory blocks found in the component tree
+    vector<MemoryBlockRef> memoryBlocks();
+    void collectMemoryBlocks(vector<MemoryBlockRef> &result, size_t section);
+
+    // Returns the size of the table of contents
+    static size_t tocSize(size_t sections) { return 8 + 16 * sections; }
+    
+    // Saves or loads the state of this component, excluding subcomponents
+    size_t saveOwnState(u8 *buffer);
+    size_t loadOwnState(u8 *buffer);
+    
+    // Runs a function for each section index on the worker threads
+    static void parallelFor(size_t count, std::function<void(size_t)> func);
+    
     
     //
     // Controlling
@@ -260,7 +378,7 @@ protected:
 
 #define COMPUTE_SNAPSHOT_SIZE \
 SerCounter counter; \
-applyToPersistentItems(counter); \
+if (!serSkipPersistentItems) applyToPersistentItems(counter); \
 applyToHardResetItems(counter); \
 applyToResetItems(counter); \
 return counter.count;
@@ -286,7 +404,7 @@ return reader.ptr - buffer; \
 #define SAVE_SNAPSHOT_ITEMS \
 { \
 SerWriter writer(buffer); \
-applyToPersistentItems(writer); \
+if (!serSkipPersistentItems) applyToPersistentItems(writer); \
 applyToHardResetItems(writer); \
 applyToResetItems(writer); \
 debug(SNP_DEBUG, "Serialized to %d bytes\n", writer.ptr - buffer); \
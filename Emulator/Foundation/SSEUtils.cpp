@@ -9,6 +9,162 @@
 
 #include "SSEUtils.h"
 
+#include <utility>
+
+/* Scalar implementation of holdHAM(). It is used on all architectures without
+ * SSE support and processes the pixels that are left over by the vectorized
+ * code.
+ */
+static void
+holdHAMScalar(u16 *target, const u8 *bplData, const u8 *index,
+              const u16 *colreg, size_t count, u16 &hold)
+{
+    for (size_t i = 0; i < count; i++) {
+
+        u8 nr = index[i];
+
+        switch ((bplData[i] >> 4) & 0b11) {
+
+            case 0b00: hold = colreg[nr]; break;
+            case 0b01: hold = (hold & 0xFF0) | (nr & 0xF); break;
+            case 0b10: hold = (hold & 0x0FF) | (nr & 0xF) << 8; break;
+            case 0b11: hold = (hold & 0xF0F) | (nr & 0xF) << 4; break;
+        }
+        target[i] = hold;
+    }
+}
+
+/* Scalar implementation of planarToChunky(). Each byte of the bitplane data
+ * is spread over eight chunky pixels with a single table lookup. Shifting the
+ * looked up value by the plane number moves the bits to the proper position
+ * within each pixel.
+ */
+static void
+planarToChunkyScalar(const u16 *source, u8 *target)
+{
+    static const struct Spread {
+        
+        u64 entry[256];
+        
+        Spread() {
+            for (int i = 0; i < 256; i++) {
+                u8 bytes[8];
+                for (int j = 0; j < 8; j++) bytes[j] = (i >> (7 - j)) & 1;
+                memcpy(&entry[i], bytes, 8);
+            }
+        }
+    } spread;
+    
+    u64 left = 0, right = 0;
+    for (int i = 0; i < 8; i++) {
+        left |= spread.entry[source[i] >> 8] << i;
+        right |= spread.entry[source[i] & 0xFF] << i;
+    }
+    memcpy(target, &left, 8);
+    memcpy(target + 8, &right, 8);
+}
+
+/* Scalar implementation of mergeHires() and mergeLores(). The pixels are
+ * processed eight at a time inside a 64 bit integer.
+ */
+template <bool lores> static void
+mergePixelsScalar(u8 *target, const u8 *source, u8 keep, u8 mask)
+{
+    const u64 k = keep * 0x0101010101010101ULL;
+    const u64 m = mask * 0x0101010101010101ULL;
+    
+    u8 pixels[32];
+    if (lores) {
+        for (int i = 0; i < 16; i++) pixels[2 * i] = pixels[2 * i + 1] = source[i];
+    } else {
+        memcpy(pixels, source, 16);
+    }
+    
+    for (int i = 0; i < (lores ? 32 : 16); i += 8) {
+        
+        u64 t, s;
+        memcpy(&t, target + i, 8);
+        memcpy(&s, pixels + i, 8);
+        t = (t & k) | (s & m);
+        memcpy(target + i, &t, 8);
+    }
+}
+
+/* Scalar implementations of matchMask8() and testMask16(). Eight bytes or
+ * four words are compared at a time inside a 64 bit integer. Afterwards, the
+ * most significant bit of each element is set if the element is nonzero.
+ * These bits are gathered with a single multiplication.
+ */
+static u32
+matchMask8Scalar(const u8 *source, u8 mask, u8 value)
+{
+    const u64 m = mask * 0x0101010101010101ULL;
+    const u64 v = value * 0x0101010101010101ULL;
+    const u64 low = 0x7F7F7F7F7F7F7F7FULL;
+
+    u32 result = 0;
+    for (int i = 0; i < 32; i += 8) {
+
+        u64 s;
+        memcpy(&s, source + i, 8);
+        s = (s & m) ^ v;
+        s = (((s & low) + low) | s) & ~low;
+        result |= (u32)((~s >> 7 & 0x0101010101010101ULL) * 0x0102040810204080ULL >> 56) << i;
+    }
+    return result;
+}
+
+static u32
+testMask16Scalar(const u16 *source, u16 mask)
+{
+    const u64 m = mask * 0x0001000100010001ULL;
+    const u64 low = 0x7FFF7FFF7FFF7FFFULL;
+
+    u32 result = 0;
+    for (int i = 0; i < 32; i += 4) {
+
+        u64 s;
+        memcpy(&s, source + i, 8);
+        s &= m;
+        s = (((s & low) + low) | s) & ~low;
+        result |= (u32)((s >> 15) * 0x0001000200040008ULL >> 48 & 0xF) << i;
+    }
+    return result;
+}
+
+/* Scalar implementations of the minterm functions. The array version
+ * processes four words at a time inside a 64 bit integer.
+ */
+template <u8 m> static u16
+mintermWord(u16 a, u16 b, u16 c)
+{
+    return evalMinterm<m>(a, b, c);
+}
+
+template <u8 m> static u16
+mintermScalar(u16 *target, const u16 *a, const u16 *b, const u16 *c, size_t count)
+{
+    u64 any = 0;
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+
+        u64 x, y, z;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        memcpy(&z, c + i, 8);
+        u64 result = evalMinterm<m>(x, y, z);
+        memcpy(target + i, &result, 8);
+        any |= result;
+    }
+    for (; i < count; i++) {
+
+        target[i] = evalMinterm<m>(a[i], b[i], c[i]);
+        any |= target[i];
+    }
+    return (u16)(any | any >> 16 | any >> 32 | any >> 48);
+}
+
 #if defined(__i386__) || defined(__x86_64__)
 
 #include <x86intrin.h>
@@ -43,6 +199,396 @@ void transposeSSE(u16 *source, u8* target)
     _mm_store_si128((__m128i *)target, shuffled);
 }
 
+static bool
+planarToChunkySSE(const u16 *source, u8 *target)
+{
+    if (NO_SSE) return false;
+    
+    transposeSSE((u16 *)source, target);
+    return true;
+}
+
+/* Merges 16 pixels with a single and/or operation. In lores mode, each pixel
+ * is doubled by interleaving the vector with itself.
+ */
+template <bool lores> static bool
+mergePixelsSSE(u8 *target, const u8 *source, u8 keep, u8 mask)
+{
+    if (NO_SSE) return false;
+    
+    const __m128i k = _mm_set1_epi8((char)keep);
+    const __m128i m = _mm_set1_epi8((char)mask);
+    
+    __m128i pixels = _mm_and_si128(_mm_loadu_si128((__m128i *)source), m);
+    
+    if (lores) {
+        
+        __m128i left = _mm_unpacklo_epi8(pixels, pixels);
+        __m128i right = _mm_unpackhi_epi8(pixels, pixels);
+        __m128i t1 = _mm_loadu_si128((__m128i *)target);
+        __m128i t2 = _mm_loadu_si128((__m128i *)(target + 16));
+        _mm_storeu_si128((__m128i *)target, _mm_or_si128(_mm_and_si128(t1, k), left));
+        _mm_storeu_si128((__m128i *)(target + 16), _mm_or_si128(_mm_and_si128(t2, k), right));
+        
+    } else {
+        
+        __m128i t = _mm_loadu_si128((__m128i *)target);
+        _mm_storeu_si128((__m128i *)target, _mm_or_si128(_mm_and_si128(t, k), pixels));
+    }
+    return true;
+}
+
+/* Reverses the byte order of all elements using SSSE3 extensions. Each
+ * iteration converts 16 bytes with a single shuffle. If at least 16 bytes are
+ * converted, the remaining bytes are covered by an additional iteration that
+ * is aligned with the end of the array. Otherwise, they are processed by the
+ * scalar code in copySwapped().
+ */
+template <int width> static size_t
+copySwappedSSE(u8 *target, const u8 *source, size_t bytes)
+{
+    static const u8 masks[3][16] = {
+        { 1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14 },
+        { 3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12 },
+        { 7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8 }
+    };
+    const u8 *m = masks[width == 2 ? 0 : width == 4 ? 1 : 2];
+    __m128i mask = _mm_loadu_si128((__m128i *)m);
+    
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128((__m128i *)(source + i));
+        _mm_storeu_si128((__m128i *)(target + i), _mm_shuffle_epi8(v, mask));
+    }
+    if (i && i < bytes) {
+        __m128i v = _mm_loadu_si128((__m128i *)(source + bytes - 16));
+        _mm_storeu_si128((__m128i *)(target + bytes - 16), _mm_shuffle_epi8(v, mask));
+        i = bytes;
+    }
+    return i;
+}
+
+
+bool hasAVX2()
+{
+    static const bool result = __builtin_cpu_supports("avx2");
+    return result;
+}
+
+/* Looks up 8 values at a time with the AVX2 gather instruction. The function
+ * is compiled for AVX2 regardless of the compiler settings and must only be
+ * called if hasAVX2() returns true.
+ */
+__attribute__((target("avx2"))) static size_t
+lookup8AVX2(u32 *target, const u8 *source, const u32 *table, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i idx = _mm_loadl_epi64((__m128i *)(source + i));
+        __m256i val = _mm256_i32gather_epi32((const int *)table,
+                                             _mm256_cvtepu8_epi32(idx), 4);
+        _mm256_storeu_si256((__m256i *)(target + i), val);
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) static size_t
+lookup16AVX2(u32 *target, const u16 *source, const u32 *table, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i idx = _mm_loadu_si128((__m128i *)(source + i));
+        __m256i val = _mm256_i32gather_epi32((const int *)table,
+                                             _mm256_cvtepu16_epi32(idx), 4);
+        _mm256_storeu_si256((__m256i *)(target + i), val);
+    }
+    return i;
+}
+
+// Selects bits from a where mask is set and from b elsewhere
+static inline __m128i
+select(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/* Propagates the most recently written value of a color component to all
+ * following pixels. v contains the written values and w marks the pixels
+ * that write the component. Pixels preceding the first write receive the
+ * value carried over from the previous chunk.
+ */
+static inline __m128i
+prefixHold(__m128i v, __m128i w, __m128i carry)
+{
+    v = select(w, v, _mm_slli_si128(v, 1)); w = _mm_or_si128(w, _mm_slli_si128(w, 1));
+    v = select(w, v, _mm_slli_si128(v, 2)); w = _mm_or_si128(w, _mm_slli_si128(w, 2));
+    v = select(w, v, _mm_slli_si128(v, 4)); w = _mm_or_si128(w, _mm_slli_si128(w, 4));
+    v = select(w, v, _mm_slli_si128(v, 8)); w = _mm_or_si128(w, _mm_slli_si128(w, 8));
+    
+    return select(w, v, carry);
+}
+
+static size_t
+holdHAMSSE(u16 *target, const u8 *bplData, const u8 *index,
+           const u16 *colreg, size_t count, u16 &hold)
+{
+    // Split up the first 16 color registers into their components
+    u8 r[16], g[16], b[16];
+    for (int i = 0; i < 16; i++) {
+        r[i] = (colreg[i] >> 8) & 0xF;
+        g[i] = (colreg[i] >> 4) & 0xF;
+        b[i] = (colreg[i] >> 0) & 0xF;
+    }
+    const __m128i tabR = _mm_loadu_si128((__m128i *)r);
+    const __m128i tabG = _mm_loadu_si128((__m128i *)g);
+    const __m128i tabB = _mm_loadu_si128((__m128i *)b);
+    
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i hiNibble = _mm_set1_epi8((char)0xF0);
+    const __m128i loNibble = _mm_set1_epi8(0x0F);
+    const __m128i ops[3] = {
+        _mm_set1_epi8(1), _mm_set1_epi8(2), _mm_set1_epi8(3) };
+    
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        
+        __m128i data = _mm_loadu_si128((__m128i *)(bplData + i));
+        __m128i nr = _mm_loadu_si128((__m128i *)(index + i));
+        
+        // Extract the HAM operation (0 = load, 1 = blue, 2 = red, 3 = green)
+        __m128i op = _mm_and_si128(_mm_srli_epi16(data, 4), ops[2]);
+        __m128i load = _mm_cmpeq_epi8(op, zero);
+        
+        // Only color registers 0 to 15 can be looked up with a shuffle
+        __m128i big = _mm_andnot_si128(_mm_cmpeq_epi8(_mm_and_si128(nr, hiNibble), zero), load);
+        if (_mm_movemask_epi8(big)) {
+            holdHAMScalar(target + i, bplData + i, index + i, colreg, 16, hold);
+            continue;
+        }
+        
+        __m128i nib = _mm_and_si128(nr, loNibble);
+        __m128i carryR = _mm_set1_epi8((hold >> 8) & 0xF);
+        __m128i carryG = _mm_set1_epi8((hold >> 4) & 0xF);
+        __m128i carryB = _mm_set1_epi8((hold >> 0) & 0xF);
+        
+        // Compute the value of each color component
+        __m128i vR = select(load, _mm_shuffle_epi8(tabR, nib), nib);
+        __m128i vG = select(load, _mm_shuffle_epi8(tabG, nib), nib);
+        __m128i vB = select(load, _mm_shuffle_epi8(tabB, nib), nib);
+        
+        // Propagate the values to all following pixels
+        vR = prefixHold(vR, _mm_or_si128(load, _mm_cmpeq_epi8(op, ops[1])), carryR);
+        vG = prefixHold(vG, _mm_or_si128(load, _mm_cmpeq_epi8(op, ops[2])), carryG);
+        vB = prefixHold(vB, _mm_or_si128(load, _mm_cmpeq_epi8(op, ops[0])), carryB);
+        
+        // Assemble the 12 bit color values
+        __m128i lo = _mm_or_si128(_mm_or_si128(
+            _mm_slli_epi16(_mm_unpacklo_epi8(vR, zero), 8),
+            _mm_slli_epi16(_mm_unpacklo_epi8(vG, zero), 4)),
+            _mm_unpacklo_epi8(vB, zero));
+        __m128i hi = _mm_or_si128(_mm_or_si128(
+            _mm_slli_epi16(_mm_unpackhi_epi8(vR, zero), 8),
+            _mm_slli_epi16(_mm_unpackhi_epi8(vG, zero), 4)),
+            _mm_unpackhi_epi8(vB, zero));
+        _mm_storeu_si128((__m128i *)(target + i), lo);
+        _mm_storeu_si128((__m128i *)(target + i + 8), hi);
+        
+        hold = target[i + 15];
+    }
+    return i;
+}
+
+/* Looks up 16 bytes in a 64 entry table. Each quarter of the table is
+ * accessed with a single shuffle. The results are combined by selecting the
+ * quarter that is addressed by the upper two bits of each index.
+ */
+static inline __m128i
+shuffle64(const __m128i *table, __m128i index)
+{
+    const __m128i loBits = _mm_set1_epi8(0x0F);
+    const __m128i hiBits = _mm_set1_epi8(0x30);
+    
+    __m128i lo = _mm_and_si128(index, loBits);
+    __m128i hi = _mm_and_si128(index, hiBits);
+    __m128i result = _mm_setzero_si128();
+    
+    for (int i = 0; i < 4; i++) {
+        
+        __m128i hit = _mm_cmpeq_epi8(hi, _mm_set1_epi8((char)(i << 4)));
+        result = _mm_or_si128(result, _mm_and_si128(hit, _mm_shuffle_epi8(table[i], lo)));
+    }
+    return result;
+}
+
+static size_t
+translate8SSE(u8 *target, const u8 *source, const u8 *table, size_t count)
+{
+    if (NO_SSE) return 0;
+    
+    __m128i tab[4];
+    for (int i = 0; i < 4; i++) tab[i] = _mm_loadu_si128((__m128i *)(table + 16 * i));
+    
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        
+        __m128i index = _mm_loadu_si128((__m128i *)(source + i));
+        _mm_storeu_si128((__m128i *)(target + i), shuffle64(tab, index));
+    }
+    return i;
+}
+
+static size_t
+translate16SSE(u16 *target, const u8 *source, const u16 *table, size_t count)
+{
+    if (NO_SSE) return 0;
+    
+    // Split up the table into the lower and the upper bytes
+    const u8 split[16] = { 0,2,4,6,8,10,12,14,1,3,5,7,9,11,13,15 };
+    const __m128i mask = _mm_loadu_si128((__m128i *)split);
+    
+    __m128i lo[4], hi[4];
+    for (int i = 0; i < 4; i++) {
+        
+        __m128i a = _mm_loadu_si128((__m128i *)(table + 16 * i));
+        __m128i b = _mm_loadu_si128((__m128i *)(table + 16 * i + 8));
+        a = _mm_shuffle_epi8(a, mask);
+        b = _mm_shuffle_epi8(b, mask);
+        lo[i] = _mm_unpacklo_epi64(a, b);
+        hi[i] = _mm_unpackhi_epi64(a, b);
+    }
+    
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        
+        __m128i index = _mm_loadu_si128((__m128i *)(source + i));
+        __m128i l = shuffle64(lo, index);
+        __m128i h = shuffle64(hi, index);
+        _mm_storeu_si128((__m128i *)(target + i), _mm_unpacklo_epi8(l, h));
+        _mm_storeu_si128((__m128i *)(target + i + 8), _mm_unpackhi_epi8(l, h));
+    }
+    return i;
+}
+
+/* Compares 16 elements per iteration and extracts the result with a single
+ * movemask instruction.
+ */
+static bool
+matchMask8SSE(const u8 *source, u8 mask, u8 value, u32 &result)
+{
+    if (NO_SSE) return false;
+
+    const __m128i m = _mm_set1_epi8((char)mask);
+    const __m128i v = _mm_set1_epi8((char)value);
+
+    __m128i s1 = _mm_and_si128(_mm_loadu_si128((__m128i *)source), m);
+    __m128i s2 = _mm_and_si128(_mm_loadu_si128((__m128i *)(source + 16)), m);
+    u32 lo = (u16)_mm_movemask_epi8(_mm_cmpeq_epi8(s1, v));
+    u32 hi = (u16)_mm_movemask_epi8(_mm_cmpeq_epi8(s2, v));
+
+    result = lo | hi << 16;
+    return true;
+}
+
+static bool
+testMask16SSE(const u16 *source, u16 mask, u32 &result)
+{
+    if (NO_SSE) return false;
+
+    const __m128i m = _mm_set1_epi16((short)mask);
+    const __m128i zero = _mm_setzero_si128();
+
+    result = 0;
+    for (int i = 0; i < 32; i += 16) {
+
+        __m128i s1 = _mm_and_si128(_mm_loadu_si128((__m128i *)(source + i)), m);
+        __m128i s2 = _mm_and_si128(_mm_loadu_si128((__m128i *)(source + i + 8)), m);
+        __m128i z1 = _mm_cmpeq_epi16(s1, zero);
+        __m128i z2 = _mm_cmpeq_epi16(s2, zero);
+        u32 bits = (u16)~_mm_movemask_epi8(_mm_packs_epi16(z1, z2));
+        result |= bits << i;
+    }
+    return true;
+}
+
+/* Shifts eight words per iteration. The neighbouring words are fetched with
+ * a second unaligned load that is displaced by one element. If the number of
+ * words is not a multiple of eight, the last iteration is aligned with the
+ * end of the array and overlaps the previous one. This is faster than
+ * processing the remaining words with scalar code.
+ */
+static size_t
+shiftRight16SSE(u16 *target, const u16 *source, size_t count, int shift)
+{
+    if (NO_SSE || count < 8) return 0;
+
+    const __m128i r = _mm_cvtsi32_si128(shift);
+    const __m128i l = _mm_cvtsi32_si128(16 - shift);
+
+    for (size_t i = 0; i < count; i += 8) {
+
+        if (i + 8 > count) i = count - 8;
+
+        __m128i cur = _mm_loadu_si128((__m128i *)(source + i));
+        __m128i prv = _mm_loadu_si128((__m128i *)(source + i - 1));
+        __m128i res = _mm_or_si128(_mm_sll_epi16(prv, l), _mm_srl_epi16(cur, r));
+        _mm_storeu_si128((__m128i *)(target + i), res);
+    }
+    return count;
+}
+
+static size_t
+shiftLeft16SSE(u16 *target, const u16 *source, size_t count, int shift)
+{
+    if (NO_SSE || count < 8) return 0;
+
+    const __m128i l = _mm_cvtsi32_si128(shift);
+    const __m128i r = _mm_cvtsi32_si128(16 - shift);
+
+    for (size_t i = 0; i < count; i += 8) {
+
+        if (i + 8 > count) i = count - 8;
+
+        __m128i cur = _mm_loadu_si128((__m128i *)(source + i));
+        __m128i nxt = _mm_loadu_si128((__m128i *)(source + i + 1));
+        __m128i res = _mm_or_si128(_mm_sll_epi16(cur, l), _mm_srl_epi16(nxt, r));
+        _mm_storeu_si128((__m128i *)(target + i), res);
+    }
+    return count;
+}
+
+/* Evaluates a minterm for eight words per iteration. The remaining words
+ * are handled the same way as in the shift functions.
+ */
+template <u8 m> static size_t
+mintermSSE(u16 *target, const u16 *a, const u16 *b, const u16 *c,
+           size_t count, u16 &any)
+{
+    if (NO_SSE || count < 8) return 0;
+
+    __m128i acc = _mm_setzero_si128();
+
+    for (size_t i = 0; i < count; i += 8) {
+
+        if (i + 8 > count) i = count - 8;
+
+        __m128i va = _mm_loadu_si128((__m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((__m128i *)(b + i));
+        __m128i vc = _mm_loadu_si128((__m128i *)(c + i));
+        __m128i res = evalMinterm<m>(va, vb, vc);
+
+        _mm_storeu_si128((__m128i *)(target + i), res);
+        acc = _mm_or_si128(acc, res);
+    }
+
+    // Fold the accumulated words into a single word
+    acc = _mm_or_si128(acc, _mm_srli_si128(acc, 8));
+    acc = _mm_or_si128(acc, _mm_srli_si128(acc, 4));
+    acc = _mm_or_si128(acc, _mm_srli_si128(acc, 2));
+    any |= (u16)_mm_cvtsi128_si32(acc);
+
+    return count;
+}
+
 #else
 
 void transposeSSE(u16 *source, u8* target)
@@ -50,4 +596,265 @@ void transposeSSE(u16 *source, u8* target)
     assert(false);
 }
 
+static bool
+planarToChunkySSE(const u16 *source, u8 *target)
+{
+    return false;
+}
+
+template <bool lores> static bool
+mergePixelsSSE(u8 *target, const u8 *source, u8 keep, u8 mask)
+{
+    return false;
+}
+
+template <int width> static size_t
+copySwappedSSE(u8 *target, const u8 *source, size_t bytes)
+{
+    return 0;
+}
+
+bool hasAVX2()
+{
+    return false;
+}
+
+static size_t
+lookup8AVX2(u32 *target, const u8 *source, const u32 *table, size_t count)
+{
+    return 0;
+}
+
+static size_t
+lookup16AVX2(u32 *target, const u16 *source, const u32 *table, size_t count)
+{
+    return 0;
+}
+
+static size_t
+holdHAMSSE(u16 *target, const u8 *bplData, const u8 *index,
+           const u16 *colreg, size_t count, u16 &hold)
+{
+    return 0;
+}
+
+static size_t
+translate8SSE(u8 *target, const u8 *source, const u8 *table, size_t count)
+{
+    return 0;
+}
+
+static size_t
+translate16SSE(u16 *target, const u8 *source, const u16 *table, size_t count)
+{
+    return 0;
+}
+
+static bool
+matchMask8SSE(const u8 *source, u8 mask, u8 value, u32 &result)
+{
+    return false;
+}
+
+static bool
+testMask16SSE(const u16 *source, u16 mask, u32 &result)
+{
+    return false;
+}
+
+static size_t
+shiftRight16SSE(u16 *target, const u16 *source, size_t count, int shift)
+{
+    return 0;
+}
+
+static size_t
+shiftLeft16SSE(u16 *target, const u16 *source, size_t count, int shift)
+{
+    return 0;
+}
+
+template <u8 m> static size_t
+mintermSSE(u16 *target, const u16 *a, const u16 *b, const u16 *c,
+           size_t count, u16 &any)
+{
+    return 0;
+}
+
 #endif
+
+template <int width> static void
+copySwapped(u8 *target, const u8 *source, size_t count)
+{
+    size_t bytes = count * width;
+    
+    // Convert as many bytes as possible with vector instructions
+    size_t i = copySwappedSSE<width>(target, source, bytes);
+
+    // Convert the rest
+    for (; i < bytes; i += width) {
+        for (int j = 0; j < width; j++) {
+            target[i + j] = source[i + width - 1 - j];
+        }
+    }
+}
+
+void copySwapped16(u8 *target, const u8 *source, size_t count)
+{
+    copySwapped<2>(target, source, count);
+}
+
+void copySwapped32(u8 *target, const u8 *source, size_t count)
+{
+    copySwapped<4>(target, source, count);
+}
+
+void copySwapped64(u8 *target, const u8 *source, size_t count)
+{
+    copySwapped<8>(target, source, count);
+}
+
+void lookup8(u32 *target, const u8 *source, const u32 *table, size_t count)
+{
+    size_t i = hasAVX2() ? lookup8AVX2(target, source, table, count) : 0;
+
+    for (; i < count; i++) {
+        target[i] = table[source[i]];
+    }
+}
+
+void lookup16(u32 *target, const u16 *source, const u32 *table, size_t count)
+{
+    size_t i = hasAVX2() ? lookup16AVX2(target, source, table, count) : 0;
+
+    for (; i < count; i++) {
+        target[i] = table[source[i]];
+    }
+}
+
+void holdHAM(u16 *target, const u8 *bplData, const u8 *index,
+             const u16 *colreg, size_t count, u16 &hold)
+{
+    size_t i = holdHAMSSE(target, bplData, index, colreg, count, hold);
+    
+    holdHAMScalar(target + i, bplData + i, index + i, colreg, count - i, hold);
+}
+
+void planarToChunky(const u16 *source, u8 *target)
+{
+    if (!planarToChunkySSE(source, target)) {
+        planarToChunkyScalar(source, target);
+    }
+}
+
+void mergeHires(u8 *target, const u8 *source, u8 keep, u8 mask)
+{
+    if (!mergePixelsSSE<false>(target, source, keep, mask)) {
+        mergePixelsScalar<false>(target, source, keep, mask);
+    }
+}
+
+void mergeLores(u8 *target, const u8 *source, u8 keep, u8 mask)
+{
+    if (!mergePixelsSSE<true>(target, source, keep, mask)) {
+        mergePixelsScalar<true>(target, source, keep, mask);
+    }
+}
+
+void translate8(u8 *target, const u8 *source, const u8 *table, size_t count)
+{
+    size_t i = translate8SSE(target, source, table, count);
+    
+    for (; i < count; i++) {
+        assert(source[i] < 64);
+        target[i] = table[source[i]];
+    }
+}
+
+void translate16(u16 *target, const u8 *source, const u16 *table, size_t count)
+{
+    size_t i = translate16SSE(target, source, table, count);
+    
+    for (; i < count; i++) {
+        assert(source[i] < 64);
+        target[i] = table[source[i]];
+    }
+}
+
+u32 matchMask8(const u8 *source, u8 mask, u8 value)
+{
+    u32 result;
+
+    if (!matchMask8SSE(source, mask, value, result)) {
+        result = matchMask8Scalar(source, mask, value);
+    }
+    return result;
+}
+
+u32 testMask16(const u16 *source, u16 mask)
+{
+    u32 result;
+
+    if (!testMask16SSE(source, mask, result)) {
+        result = testMask16Scalar(source, mask);
+    }
+    return result;
+}
+
+void shiftRight16(u16 *target, const u16 *source, size_t count, int shift)
+{
+    assert(shift >= 0 && shift < 16);
+
+    size_t i = shiftRight16SSE(target, source, count, shift);
+
+    for (; i < count; i++) {
+        target[i] = (u16)(source[(long)i - 1] << (16 - shift) | source[i] >> shift);
+    }
+}
+
+void shiftLeft16(u16 *target, const u16 *source, size_t count, int shift)
+{
+    assert(shift >= 0 && shift < 16);
+
+    size_t i = shiftLeft16SSE(target, source, count, shift);
+
+    for (; i < count; i++) {
+        target[i] = (u16)(source[i] << shift | source[i + 1] >> (16 - shift));
+    }
+}
+
+template <u8 m> static u16
+mintermArray(u16 *target, const u16 *a, const u16 *b, const u16 *c, size_t count)
+{
+    u16 any = 0;
+    size_t i = mintermSSE<m>(target, a, b, c, count, any);
+
+    return any | mintermScalar<m>(target + i, a + i, b + i, c + i, count - i);
+}
+
+// Instantiates the minterm functions for all 256 minterms
+template <size_t... m> static const MintermFunc *
+mintermFuncs(std::index_sequence<m...>)
+{
+    static const MintermFunc table[] = { &mintermWord<(u8)m>... };
+    return table;
+}
+
+template <size_t... m> static const MintermKernel *
+mintermKernels(std::index_sequence<m...>)
+{
+    static const MintermKernel table[] = { &mintermArray<(u8)m>... };
+    return table;
+}
+
+MintermFunc mintermFunc(u8 minterm)
+{
+    static const MintermFunc *table = mintermFuncs(std::make_index_sequence<256>());
+    return table[minterm];
+}
+
+MintermKernel mintermKernel(u8 minterm)
+{
+    static const MintermKernel *table = mintermKernels(std::make_index_sequence<256>());
+    return table[minterm];
+}
@@ -34,4 +34,141 @@
  */
 void transposeSSE(u16 *source, u8* target);
 
+/* Copies an array of 16, 32, or 64 bit values and reverses the byte order of
+ * each element. Source and target may be unaligned, but must not overlap.
+ * The functions are used by the serializer to convert large arrays from the
+ * native byte order to big endian format and vice versa.
+ *
+ *     count:   Number of array elements (not bytes)
+ */
+void copySwapped16(u8 *target, const u8 *source, size_t count);
+void copySwapped32(u8 *target, const u8 *source, size_t count);
+void copySwapped64(u8 *target, const u8 *source, size_t count);
+
+/* Checks whether the CPU supports the AVX2 instruction set extension. The
+ * functions below use this information to select the fastest code path at
+ * runtime. The scalar code path is used on all other architectures.
+ */
+bool hasAVX2();
+
+/* Translates an array of 8 or 16 bit indices into 32 bit values by looking
+ * them up in a table (target[i] = table[source[i]]). The functions are used
+ * to convert color indices into RGBA values.
+ *
+ *     count:   Number of array elements
+ */
+void lookup8(u32 *target, const u8 *source, const u32 *table, size_t count);
+void lookup16(u32 *target, const u16 *source, const u32 *table, size_t count);
+
+/* Computes the value of the HAM hold register for a sequence of pixels. For
+ * each pixel, bits 4 and 5 of the bitplane data select the HAM operation and
+ * the color index provides either the color register number or the new value
+ * of the modified color component.
+ *
+ *     target:  Receives the 12 bit color of each pixel
+ *     bplData: Raw bitplane data (the bBuffer of Denise)
+ *     index:   Color register indices (the iBuffer of Denise)
+ *     colreg:  The 32 color registers
+ *     hold:    Value of the hold register before the first pixel. Receives
+ *              the value of the hold register after the last pixel.
+ *
+ * The vectorized version runs 16 pixels in parallel. It computes the hold
+ * register with a logarithmic prefix scan, separately for each color
+ * component.
+ */
+void holdHAM(u16 *target, const u8 *bplData, const u8 *index,
+             const u16 *colreg, size_t count, u16 &hold);
+
+/* Converts 16 pixels from planar to chunky format. The function has the same
+ * semantics as transposeSSE(). It calls transposeSSE() on Intel machines and
+ * runs a table-driven conversion on all other architectures.
+ *
+ *     source:  A pointer to a u16[8] array (one bitplane per element)
+ *     target:  A pointer to a u8[16] array (one pixel per element)
+ */
+void planarToChunky(const u16 *source, u8 *target);
+
+/* Merges 16 chunky pixels into a pixel buffer. Each target pixel is computed
+ * as (target & keep) | (source & mask). The keep mask preserves the bits that
+ * belong to the other playfield. mergeHires() writes 16 pixels. mergeLores()
+ * writes each pixel twice and therefore modifies 32 pixels.
+ */
+void mergeHires(u8 *target, const u8 *source, u8 keep, u8 mask);
+void mergeLores(u8 *target, const u8 *source, u8 keep, u8 mask);
+
+/* Translates an array of 6 bit values by looking them up in a table with 64
+ * entries (target[i] = table[source[i]]). Denise utilizes these functions to
+ * translate bitplane data into color indices and pixel depths. All source
+ * values must be smaller than 64. On Intel machines, 16 values are looked up
+ * at once with four SSSE3 shuffles.
+ */
+void translate8(u8 *target, const u8 *source, const u8 *table, size_t count);
+void translate16(u16 *target, const u8 *source, const u16 *table, size_t count);
+
+/* Packs a comparison result for 32 consecutive array elements into a bit
+ * mask. Bit i of the result is set if (source[i] & mask) == value or if
+ * (source[i] & mask) != 0, respectively. Denise utilizes these functions to
+ * check all pixels of a sprite for collisions at once.
+ */
+u32 matchMask8(const u8 *source, u8 mask, u8 value);
+u32 testMask16(const u16 *source, u16 mask);
+
+/* Runs the barrel shifter of the Blitter on an array of words. Each target
+ * word is composed of a source word and one of its neighbours:
+ *
+ *     shiftRight16: target[i] = source[i - 1] << (16 - shift) | source[i] >> shift
+ *      shiftLeft16: target[i] = source[i] << shift | source[i + 1] >> (16 - shift)
+ *
+ * The caller has to provide the neighbour of the first or the last element
+ * in source[-1] or source[count], respectively. shift ranges from 0 to 15.
+ */
+void shiftRight16(u16 *target, const u16 *source, size_t count, int shift);
+void shiftLeft16(u16 *target, const u16 *source, size_t count, int shift);
+
+/* Evaluates the minterm logic circuit of the Blitter for a minterm that is
+ * known at compile time. Bit n of the minterm determines the value of each
+ * result bit whose input bits satisfy n = a << 2 | b << 1 | c. The minterm is
+ * evaluated as a tree of multiplexers whose leaves are constants. Since all
+ * multiplexers with constant inputs are folded by the compiler, frequently
+ * used minterms shrink to a few instructions. E.g., 0xF0 (D = A) becomes a
+ * plain assignment and 0xCA (cookie cut) becomes three logical operations.
+ * T can be any integer or vector type supporting the bitwise operators.
+ */
+template <u8 m, class T> inline T
+evalMinterm(T a, T b, T c)
+{
+    const T zero = c ^ c;
+
+    // Selects one of the four functions of c that two minterm bits describe
+    auto leaf = [&](int bits) -> T {
+        switch (bits) {
+            case 0:  return zero;
+            case 1:  return ~c;
+            case 2:  return c;
+            default: return ~zero;
+        }
+    };
+
+    // Selects bits from t where s is set and from f elsewhere
+    auto sel = [](T s, T t, T f) -> T { return f ^ (s & (t ^ f)); };
+
+    T x0 = sel(b, leaf(m >> 2 & 3), leaf(m & 3));
+    T x1 = sel(b, leaf(m >> 6 & 3), leaf(m >> 4 & 3));
+    return sel(a, x1, x0);
+}
+
+/* Returns a function that evaluates a particular minterm. For each of the 256
+ * minterms, a specialized version is generated at compile time. The first
+ * function processes a single word. The second function processes arrays
+ * of words and returns the result of or'ing all target words together, which
+ * tells the caller whether all words are zero. The Blitter looks up these
+ * functions once per blit.
+ */
+typedef u16 (*MintermFunc)(u16 a, u16 b, u16 c);
+typedef u16 (*MintermKernel)(u16 *target, const u16 *a, const u16 *b,
+                             const u16 *c, size_t count);
+
+MintermFunc mintermFunc(u8 minterm);
+MintermKernel mintermKernel(u8 minterm);
+
 #endif
@@ -19,85 +19,247 @@
 #include "TimeDelayed.h"
 #include "Sampler.h"
 #include "AudioStream.h"
+#include "SSEUtils.h"
+
+#include <type_traits>
+
+//
+// Byte order
+//
+
+/* By default, all data is serialized in big endian format which makes
+ * snapshots portable across machines. In-process snapshots that never leave
+ * the machine (e.g., snapshots taken for rewinding or run-ahead) can skip the
+ * conversion by switching to the native byte order. The setting is evaluated
+ * when a SerReader or SerWriter is created and applies to the calling thread,
+ * only. Use class NativeByteOrder to change it inside a certain scope.
+ */
+inline thread_local bool serNativeByteOrder = false;
+
+struct NativeByteOrder {
+    
+    bool saved;
+
+    NativeByteOrder(bool enable = true) : saved(serNativeByteOrder)
+    {
+        serNativeByteOrder = enable;
+    }
+    ~NativeByteOrder()
+    {
+        serNativeByteOrder = saved;
+    }
+};
+
+
+/* Floppy disks are usually serialized with their complete MFM data. If this
+ * flag is set, disks that have been created from a disk file are serialized
+ * as a reference into the disk store, followed by the modified tracks. Only
+ * use this format for snapshots that stay inside the current process. Use
+ * class DiskReferences to change the flag inside a certain scope.
+ */
+inline thread_local bool serDiskReferences = false;
+
+struct DiskReferences {
+    
+    bool saved;
+
+    DiskReferences(bool enable = true) : saved(serDiskReferences)
+    {
+        serDiskReferences = enable;
+    }
+    ~DiskReferences()
+    {
+        serDiskReferences = saved;
+    }
+};
+
+
+/* Persistent items mainly store configuration options. If this flag is set,
+ * they are left out when the component state is sized or saved. This is done
+ * when state hashes are computed, because two machines with a different
+ * configuration (e.g., a different Blitter accuracy level) are supposed to
+ * be in the same emulation state. Use class SkipPersistentItems to change
+ * the flag inside a certain scope.
+ */
+inline thread_local bool serSkipPersistentItems = false;
+
+struct SkipPersistentItems {
+    
+    bool saved;
+
+    SkipPersistentItems(bool enable = true) : saved(serSkipPersistentItems)
+    {
+        serSkipPersistentItems = enable;
+    }
+    ~SkipPersistentItems()
+    {
+        serSkipPersistentItems = saved;
+    }
+};
+
+
+/* Components owning big blocks of Ram or Rom serialize the block contents
+ * together with the rest of their state. If this flag is set, the contents
+ * are left out. It is set when sectioned snapshots are created or restored,
+ * because those store each memory block in a section of its own (see
+ * HardwareComponent::memoryBlock()). Use class SkipMemoryBlocks to change the
+ * flag inside a certain scope.
+ */
+inline thread_local bool serSkipMemoryBlocks = false;
+
+struct SkipMemoryBlocks {
+
+    bool saved;
+
+    SkipMemoryBlocks(bool enable = true) : saved(serSkipMemoryBlocks)
+    {
+        serSkipMemoryBlocks = enable;
+    }
+    ~SkipMemoryBlocks()
+    {
+        serSkipMemoryBlocks = saved;
+    }
+};
+
+
+/* Components set this flag if they come across data they cannot restore
+ * while loading (e.g., a disk stored by reference whose base image is no
+ * longer available in the disk store). It is cleared before loading starts
+ * and checked once a component has been loaded.
+ */
+inline thread_local bool serLoadError = false;
+
 
 //
 // Basic memory buffer I/O
 //
 
-inline u8 read8(u8 *& buffer)
+inline u8 read8(u8 *& buffer, bool native = false)
 {
     u8 result = *buffer;
     buffer += 1;
     return result;
 }
 
-inline u16 read16(u8 *& buffer)
+inline u16 read16(u8 *& buffer, bool native = false)
 {
-    u16 result = ntohs(*((u16 *)buffer));
+    u16 result = *((u16 *)buffer);
     buffer += 2;
-    return result;
+    return native ? result : ntohs(result);
 }
 
-inline u32 read32(u8 *& buffer)
+inline u32 read32(u8 *& buffer, bool native = false)
 {
-    u32 result = ntohl(*((u32 *)buffer));
+    u32 result = *((u32 *)buffer);
     buffer += 4;
-    return result;
+    return native ? result : ntohl(result);
 }
 
-inline u64 read64(u8 *& buffer)
+inline u64 read64(u8 *& buffer, bool native = false)
 {
+    if (native) {
+        u64 result = *((u64 *)buffer);
+        buffer += 8;
+        return result;
+    }
     u32 hi = read32(buffer);
     u32 lo = read32(buffer);
     return ((u64)hi << 32) | lo;
 }
 
-inline float readFloat(u8 *& buffer)
+inline float readFloat(u8 *& buffer, bool native = false)
 {
     float result;
-    *((u32 *)(&result)) = read32(buffer);
+    *((u32 *)(&result)) = read32(buffer, native);
     return result;
 }
 
-inline double readDouble(u8 *& buffer)
+inline double readDouble(u8 *& buffer, bool native = false)
 {
     double result;
-    *((u64 *)(&result)) = read64(buffer);
+    *((u64 *)(&result)) = read64(buffer, native);
     return result;
 }
  
-inline void write8(u8 *& buffer, u8 value)
+inline void write8(u8 *& buffer, u8 value, bool native = false)
 {
     *buffer = value;
     buffer += 1;
 }
 
-inline void write16(u8 *& buffer, u16 value)
+inline void write16(u8 *& buffer, u16 value, bool native = false)
 {
-    *((u16 *)buffer) = htons(value);
+    *((u16 *)buffer) = native ? value : htons(value);
     buffer += 2;
 }
 
-inline void write32(u8 *& buffer, u32 value)
+inline void write32(u8 *& buffer, u32 value, bool native = false)
 {
-    *((u32 *)buffer) = htonl(value);
+    *((u32 *)buffer) = native ? value : htonl(value);
     buffer += 4;
 }
 
-inline void write64(u8 *& buffer, u64 value)
+inline void write64(u8 *& buffer, u64 value, bool native = false)
 {
+    if (native) {
+        *((u64 *)buffer) = value;
+        buffer += 8;
+        return;
+    }
     write32(buffer, (u32)(value >> 32));
     write32(buffer, (u32)(value));
 }
 
-inline void writeFloat(u8 *& buffer, float value)
+inline void writeFloat(u8 *& buffer, float value, bool native = false)
+{
+    write32(buffer, *((u32 *)(&value)), native);
+}
+
+inline void writeDouble(u8 *& buffer, double value, bool native = false)
+{
+    write64(buffer, *((u64 *)(&value)), native);
+}
+
+
+//
+// Bulk memory buffer I/O
+//
+
+/* Arrays of integral or floating point values are processed as a single
+ * block instead of element by element. Because each element is stored in
+ * big endian format, a block is either copied as a whole (byte arrays and
+ * native byte order) or copied with all elements byte-swapped.
+ */
+template <class T> constexpr bool isBulkType()
+{
+    return std::is_arithmetic<T>::value && !std::is_same<T, bool>::value;
+}
+
+inline void copyBlock(u8 *target, const u8 *source,
+                      size_t count, size_t width, bool native)
+{
+    if (native || width == 1 || __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__) {
+        memcpy(target, source, count * width);
+        return;
+    }
+    switch (width) {
+        case 2: copySwapped16(target, source, count); break;
+        case 4: copySwapped32(target, source, count); break;
+        case 8: copySwapped64(target, source, count); break;
+        default: assert(false);
+    }
+}
+
+template <class T> void readBlock(u8 *& buffer, T *values, size_t count, bool native)
 {
-    write32(buffer, *((u32 *)(&value)));
+    copyBlock((u8 *)values, buffer, count, sizeof(T), native);
+    buffer += count * sizeof(T);
 }
 
-inline void writeDouble(u8 *& buffer, double value)
+template <class T> void writeBlock(u8 *& buffer, const T *values, size_t count, bool native)
 {
-    write64(buffer, *((u64 *)(&value)));
+    copyBlock(buffer, (const u8 *)values, count, sizeof(T), native);
+    buffer += count * sizeof(T);
 }
 
 //
@@ -176,8 +338,12 @@ public:
     template <class T, size_t N>
     SerCounter& operator&(T (&v)[N])
     {
-        for(size_t i = 0; i < N; ++i) {
-            *this & v[i];
+        if constexpr (isBulkType<typename std::remove_all_extents<T>::type>()) {
+            count += sizeof(v);
+        } else {
+            for(size_t i = 0; i < N; ++i) {
+                *this & v[i];
+            }
         }
         return *this;
     }
@@ -191,7 +357,7 @@ public:
 #define DESERIALIZE(type,function) \
 SerReader& operator&(type& v) \
 { \
-v = (type)function(ptr); \
+v = (type)function(ptr, native); \
 return *this; \
 }
 
@@ -207,8 +373,11 @@ class SerReader
 public:
 
     u8 *ptr;
+    
+    // Indicates if data is stored in native byte order
+    bool native;
 
-    SerReader(u8 *p) : ptr(p)
+    SerReader(u8 *p) : ptr(p), native(serNativeByteOrder)
     {
     }
 
@@ -259,8 +428,14 @@ public:
     template <class T, size_t N>
     SerReader& operator&(T (&v)[N])
     {
-        for(size_t i = 0; i < N; ++i) {
-            *this & v[i];
+        typedef typename std::remove_all_extents<T>::type E;
+        
+        if constexpr (isBulkType<E>()) {
+            readBlock(ptr, (E *)v, sizeof(v) / sizeof(E), native);
+        } else {
+            for(size_t i = 0; i < N; ++i) {
+                *this & v[i];
+            }
         }
         return *this;
     }
@@ -280,7 +455,7 @@ public:
 #define SERIALIZE(type,function,cast) \
 SerWriter& operator&(type& v) \
 { \
-function(ptr, (cast)v); \
+function(ptr, (cast)v, native); \
 return *this; \
 }
 
@@ -296,8 +471,11 @@ class SerWriter
 public:
 
     u8 *ptr;
+    
+    // Indicates if data is stored in native byte order
+    bool native;
 
-    SerWriter(u8 *p) : ptr(p)
+    SerWriter(u8 *p) : ptr(p), native(serNativeByteOrder)
     {
     }
 
@@ -348,8 +526,14 @@ public:
     template <class T, size_t N>
     SerWriter& operator&(T (&v)[N])
     {
-        for(size_t i = 0; i < N; ++i) {
-            *this & v[i];
+        typedef typename std::remove_all_extents<T>::type E;
+        
+        if constexpr (isBulkType<E>()) {
+            writeBlock(ptr, (const E *)v, sizeof(v) / sizeof(E), native);
+        } else {
+            for(size_t i = 0; i < N; ++i) {
+                *this & v[i];
+            }
         }
         return *this;
     }
@@ -425,8 +609,12 @@ public:
     template <class T, size_t N>
     SerResetter& operator&(T (&v)[N])
     {
-        for(size_t i = 0; i < N; ++i) {
-            *this & v[i];
+        if constexpr (isBulkType<typename std::remove_all_extents<T>::type>()) {
+            memset((void *)v, 0, sizeof(v));
+        } else {
+            for(size_t i = 0; i < N; ++i) {
+                *this & v[i];
+            }
         }
         return *this;
     }
@@ -284,6 +284,39 @@ fnv_1a_64(const u8 *addr, size_t size)
     return hash;
 }
 
+u64
+fnv_1a_64x4(const u8 *addr, size_t size)
+{
+    if (addr == NULL || size == 0) return 0;
+
+    u64 lane[4] = {
+        fnv_1a_init64(), fnv_1a_init64() ^ 1,
+        fnv_1a_init64() ^ 2, fnv_1a_init64() ^ 3 };
+
+    // Process 32 byte chunks
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        for (int j = 0; j < 4; j++) {
+            u64 word;
+            memcpy(&word, addr + i + 8 * j, 8);
+            lane[j] = fnv_1a_it64(lane[j], word);
+        }
+    }
+
+    // Process the remaining bytes
+    for (; i < size; i++) {
+        lane[0] = fnv_1a_it64(lane[0], (u64)addr[i]);
+    }
+
+    // Combine all lanes
+    u64 hash = fnv_1a_it64(fnv_1a_init64(), size);
+    for (int j = 0; j < 4; j++) {
+        hash = fnv_1a_it64(hash, lane[j]);
+    }
+
+    return hash;
+}
+
 u16 crc16(const u8 *addr, size_t size)
 {
     u8 x;
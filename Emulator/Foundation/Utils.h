@@ -209,6 +209,12 @@ inline u64 fnv_1a_it64(u64 prv, u64 val) { return (prv ^ val) * 0x100000001b3; }
 u32 fnv_1a_32(const u8 *addr, size_t size);
 u64 fnv_1a_64(const u8 *addr, size_t size);
 
+/* Computes a FNV-1a based checksum for large buffers. The buffer is processed
+ * in 64-bit words by four independent hash lanes which are combined at the
+ * end. The result differs from fnv_1a_64(), but is several times faster.
+ */
+u64 fnv_1a_64x4(const u8 *addr, size_t size);
+
 // Computes a CRC checksum for a given buffer
 u16 crc16(const u8 *addr, size_t size);
 u32 crc32(const u8 *addr, size_t size);
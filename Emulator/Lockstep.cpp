@@ -0,0 +1,74 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "Amiga.h"
+#include "Lockstep.h"
+
+Lockstep::Lockstep(Amiga &a, Amiga &b) : a(a), b(b)
+{
+    setDescription("Lockstep");
+}
+
+bool
+Lockstep::run(i64 count)
+{
+    assert(a.isPaused() && b.isPaused());
+
+    bool warpA = a.inWarpMode();
+    bool warpB = b.inWarpMode();
+    a.setWarp(true);
+    b.setWarp(true);
+
+    // Make sure both machines start in the same state
+    bool diverged = compare();
+
+    for (i64 i = 0; i < count && !diverged; i++) {
+
+        a.executeFrame();
+        b.executeFrame();
+        frames++;
+
+        diverged = compare();
+    }
+
+    a.setWarp(warpA);
+    b.setWarp(warpB);
+
+    return diverged;
+}
+
+bool
+Lockstep::compare()
+{
+    if (a.agnus.frame.nr == b.agnus.frame.nr && a.hashState() == b.hashState()) {
+        return false;
+    }
+
+    divergentFrame = a.agnus.frame.nr;
+    divergentComponents.clear();
+    a.findDivergences(b, divergentComponents);
+
+    return true;
+}
+
+void
+Lockstep::report()
+{
+    if (divergentFrame < 0) {
+        msg("No divergence in %lld frames\n", frames);
+        return;
+    }
+
+    msg("States diverged in frame %lld (after %lld frames)\n",
+        divergentFrame, frames);
+
+    for (HardwareComponent *c : divergentComponents) {
+        msg("    %s\n", c->getDescription());
+    }
+}
@@ -0,0 +1,74 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef _LOCKSTEP_H
+#define _LOCKSTEP_H
+
+#include "AmigaObject.h"
+
+class Amiga;
+class HardwareComponent;
+
+/* Runs two Amigas frame by frame and compares their states. The class is
+ * used to verify that performance-related options (e.g., the Blitter accuracy
+ * level) do not change the behaviour of the emulated machine. Both Amigas
+ * are expected to start in the same state (e.g., by restoring the same
+ * snapshot) and may be configured differently. After each frame, a hash over
+ * the state of each machine is computed. If the hashes differ, the frame
+ * number and all components with a diverging state are recorded.
+ */
+class Lockstep : public AmigaObject {
+
+    // The machines to compare
+    Amiga &a;
+    Amiga &b;
+
+public:
+
+    // Number of frames that have been compared
+    i64 frames = 0;
+
+    // Frame in which the states have diverged (-1 if no divergence was found)
+    i64 divergentFrame = -1;
+
+    // Components of the first Amiga whose state differs
+    vector<HardwareComponent *> divergentComponents;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    Lockstep(Amiga &a, Amiga &b);
+
+
+    //
+    // Running
+    //
+
+public:
+
+    /* Runs both Amigas for the specified number of frames or until their
+     * states diverge. Both machines must be powered on and paused. They are
+     * run in warp mode. Returns true if a divergence has been detected.
+     */
+    bool run(i64 count);
+
+    // Prints the result of the comparison
+    void report();
+
+private:
+
+    // Compares the current states and records a divergence
+    bool compare();
+};
+
+#endif
@@ -28,6 +28,8 @@ Memory::Memory(Amiga& ref) : AmigaComponent(ref)
     config.bankF0F7       = MEM_NONE;
 
     config.extStart = 0xE0;
+
+    markAllDirty();
 }
 
 Memory::~Memory()
@@ -44,6 +46,8 @@ Memory::dealloc()
     if (chip) { delete[] chip; chip = NULL; }
     if (slow) { delete[] slow; slow = NULL; }
     if (fast) { delete[] fast; fast = NULL; }
+
+    markAllDirty();
 }
 
 void
@@ -264,16 +268,26 @@ Memory::_size()
 {
     SerCounter counter;
 
-    applyToPersistentItems(counter);
+    if (!serSkipPersistentItems) applyToPersistentItems(counter);
     applyToHardResetItems(counter);
     applyToResetItems(counter);
 
-    counter.count += sizeof(config.romSize) + config.romSize;
-    counter.count += sizeof(config.womSize) + config.womSize;
-    counter.count += sizeof(config.extSize) + config.extSize;
-    counter.count += sizeof(config.chipSize) + config.chipSize;
-    counter.count += sizeof(config.slowSize) + config.slowSize;
-    counter.count += sizeof(config.fastSize) + config.fastSize;
+    counter.count += sizeof(config.romSize);
+    counter.count += sizeof(config.womSize);
+    counter.count += sizeof(config.extSize);
+    counter.count += sizeof(config.chipSize);
+    counter.count += sizeof(config.slowSize);
+    counter.count += sizeof(config.fastSize);
+
+    if (!serSkipMemoryBlocks) {
+
+        counter.count += config.romSize;
+        counter.count += config.womSize;
+        counter.count += config.extSize;
+        counter.count += config.chipSize;
+        counter.count += config.slowSize;
+        counter.count += config.fastSize;
+    }
 
     return counter.count;
 }
@@ -300,7 +314,7 @@ Memory::didLoadFromBuffer(u8 *buffer)
     if (config.slowSize > KB(512)) { config.slowSize = 0; assert(false); }
     if (config.fastSize > MB(8)) { config.fastSize = 0; assert(false); }
 
-    // Free previously allocated memory
+    // Free previously allocated memory (invalidates all cached hashes)
     dealloc();
 
     // Allocate new memory
@@ -311,6 +325,9 @@ Memory::didLoadFromBuffer(u8 *buffer)
     if (config.slowSize) slow = new (std::nothrow) u8[config.slowSize];
     if (config.fastSize) fast = new (std::nothrow) u8[config.fastSize];
 
+    // Sectioned snapshots store the memory contents separately
+    if (serSkipMemoryBlocks) return reader.ptr - buffer;
+
     // Load memory contents from buffer
     reader.copy(rom, config.romSize);
     reader.copy(wom, config.womSize);
@@ -335,6 +352,9 @@ Memory::didSaveToBuffer(u8 *buffer)
     & config.slowSize
     & config.fastSize;
 
+    // Sectioned snapshots store the memory contents separately
+    if (serSkipMemoryBlocks) return writer.ptr - buffer;
+
     // Save memory contents
     writer.copy(rom, config.romSize);
     writer.copy(wom, config.womSize);
@@ -346,6 +366,58 @@ Memory::didSaveToBuffer(u8 *buffer)
     return writer.ptr - buffer;
 }
 
+u8 *
+Memory::memoryBlock(size_t nr, size_t &size)
+{
+    switch (nr) {
+
+        case 0: size = config.romSize; return rom;
+        case 1: size = config.womSize; return wom;
+        case 2: size = config.extSize; return ext;
+        case 3: size = config.chipSize; return chip;
+        case 4: size = config.slowSize; return slow;
+        case 5: size = config.fastSize; return fast;
+
+        default: assert(false); size = 0; return NULL;
+    }
+}
+
+u64
+Memory::hashMemoryBlock(size_t nr)
+{
+    size_t size;
+    u8 *data = memoryBlock(nr, size);
+
+    if (data == NULL || size == 0) return 0;
+    assert(size <= 128 * KB(64));
+
+    u64 result = fnv_1a_init64();
+
+    for (size_t bank = 0, offset = 0; offset < size; bank++, offset += KB(64)) {
+
+        // Only rehash the banks that have been modified
+        if (bankDirty[nr][bank]) {
+
+            bankHash[nr][bank] = fnv_1a_64x4(data + offset, MIN(size - offset, (size_t)KB(64)));
+            bankDirty[nr][bank] = false;
+        }
+        result = fnv_1a_it64(result, bankHash[nr][bank]);
+    }
+
+    return result;
+}
+
+void
+Memory::markChipDirty(i64 lo, i64 hi)
+{
+    lo = MAX(lo, (i64)0);
+    hi = MIN(hi, (i64)config.chipSize);
+
+    for (i64 bank = lo >> 16; bank << 16 < hi; bank++) {
+        bankDirty[3][bank] = true;
+    }
+}
+
 void
 Memory::_dump()
 {
@@ -449,6 +521,7 @@ Memory::alloc(size_t bytes, u8 *&ptr, size_t &size, u32 &mask)
         mask = bytes - 1;
         fillRamWithInitPattern();
     }
+    markAllDirty();
     updateMemSrcTables();
     return true;
 }
@@ -457,6 +530,10 @@ void
 Memory::fillRamWithInitPattern()
 {
     assert(!isRunning());
+
+    // Cached Copper lists and memory hashes are outdated now
+    copper.flushCache();
+    markAllDirty();
     
     switch (config.ramInitPattern) {
             
@@ -632,6 +709,7 @@ Memory::loadRom(AmigaFile *file, u8 *target, size_t length)
             if ((c = file->read()) == EOF) break;
             *(target++) = c;
         }
+        markAllDirty();
     }
 }
 
@@ -787,6 +865,9 @@ Memory::updateCpuMemSrcTable()
 void
 Memory::updateAgnusMemSrcTable()
 {
+    // Cached Copper lists might no longer be reachable
+    copper.flushCache();
+
     int banks = config.chipSize / 0x10000;
     assert(banks == 0 || banks == 8 || banks == 16 || banks == 32);
     
@@ -813,7 +894,12 @@ Memory::peek16 <CPU_ACCESS, MEM_NONE> (u32 addr)
 {
     switch (config.unmappingType) {
             
-        case UNMAPPED_FLOATING:   return dataBus;
+        case UNMAPPED_FLOATING:
+
+            // Make sure the data bus carries the most recent value
+            agnus.syncBplEvents<CPU_ACCESS>();
+            return dataBus;
+
         case UNMAPPED_ALL_ONES:   return 0xFFFF;
         case UNMAPPED_ALL_ZEROES: return 0x0000;
 
@@ -856,6 +942,7 @@ template<> u8
 Memory::peek8 <CPU_ACCESS, MEM_CHIP> (u32 addr)
 {
     ASSERT_CHIP_ADDR(addr);
+    blitter.joinBlit(addr & chipMask);
     agnus.executeUntilBusIsFree();
     
     stats.chipReads.raw++;
@@ -867,6 +954,7 @@ template<> u16
 Memory::peek16 <CPU_ACCESS, MEM_CHIP> (u32 addr)
 {
     ASSERT_CHIP_ADDR(addr);
+    blitter.joinBlit(addr & chipMask);
     agnus.executeUntilBusIsFree();
     
     stats.chipReads.raw++;
@@ -878,6 +966,7 @@ template<> u16
 Memory::peek16 <AGNUS_ACCESS, MEM_CHIP> (u32 addr)
 {
     assert((addr & agnus.ptrMask) == addr);
+    blitter.joinBlit(addr & chipMask);
     
     dataBus = READ_CHIP_16(addr);
     return dataBus;
@@ -1002,6 +1091,7 @@ Memory::peek8 <CPU_ACCESS, MEM_RTC> (u32 addr)
     ASSERT_RTC_ADDR(addr);
     
     // agnus.executeUntilBusIsFree();
+    agnus.syncBplEvents<CPU_ACCESS>();
     
     dataBus = peekRTC8(addr);
     return dataBus;
@@ -1013,6 +1103,7 @@ Memory::peek16 <CPU_ACCESS, MEM_RTC> (u32 addr)
     ASSERT_RTC_ADDR(addr);
     
     // agnus.executeUntilBusIsFree();
+    agnus.syncBplEvents<CPU_ACCESS>();
 
     dataBus = peekRTC16(addr);
     return dataBus;
@@ -1060,6 +1151,7 @@ template<> u8
 Memory::peek8 <CPU_ACCESS, MEM_AUTOCONF> (u32 addr)
 {
     ASSERT_AUTO_ADDR(addr);
+    agnus.syncBplEvents<CPU_ACCESS>();
     
     // Experimental code to match UAE output (for debugging)
     if (MIMIC_UAE && fastRamSize() == 0) {
@@ -1078,6 +1170,7 @@ Memory::peek16 <CPU_ACCESS, MEM_AUTOCONF> (u32 addr)
     ASSERT_AUTO_ADDR(addr);
     
     // agnus.executeUntilBusIsFree();
+    agnus.syncBplEvents<CPU_ACCESS>();
     
     u8 hi = zorro.peekFastRamDevice(addr) << 4;
     u8 lo = zorro.peekFastRamDevice(addr + 1) << 4;
@@ -1298,6 +1391,7 @@ template <> void
 Memory::poke8 <CPU_ACCESS, MEM_NONE> (u32 addr, u8 value)
 {
     trace(MEM_DEBUG, "poke8(%x [NONE], %x)\n", addr, value);
+    agnus.syncBplEvents<CPU_ACCESS>();
     dataBus = value;
 }
 
@@ -1305,6 +1399,7 @@ template <> void
 Memory::poke16 <CPU_ACCESS, MEM_NONE> (u32 addr, u16 value)
 {
     trace(MEM_DEBUG, "poke16 <CPU> (%x [NONE], %x)\n", addr, value);
+    agnus.syncBplEvents<CPU_ACCESS>();
     dataBus = value;
 }
 
@@ -1320,12 +1415,15 @@ template <> void
 Memory::poke8 <CPU_ACCESS, MEM_CHIP> (u32 addr, u8 value)
 {
     ASSERT_CHIP_ADDR(addr);
+    blitter.joinBlit(addr & chipMask);
+    copper.invalidate(addr & chipMask);
     
     if (BLT_GUARD && blitter.memguard[addr & mem.chipMask]) {
         trace("CPU(8) OVERWRITES BLITTER AT ADDR %x\n", addr);
     }
 
     agnus.executeUntilBusIsFree();
+    agnus.syncBplEvents<CPU_ACCESS>(addr & chipMask);
     
     stats.chipWrites.raw++;
     dataBus = value;
@@ -1336,12 +1434,15 @@ template <> void
 Memory::poke16 <CPU_ACCESS, MEM_CHIP> (u32 addr, u16 value)
 {
     ASSERT_CHIP_ADDR(addr);
+    blitter.joinBlit(addr & chipMask);
+    copper.invalidate(addr & chipMask);
     
     if (BLT_GUARD && blitter.memguard[addr & mem.chipMask]) {
         trace("CPU OVERWRITES BLITTER AT ADDR %x\n", addr);
     }
     
     agnus.executeUntilBusIsFree();
+    agnus.syncBplEvents<CPU_ACCESS>(addr & chipMask);
     
     stats.chipWrites.raw++;
     dataBus = value;
@@ -1352,11 +1453,14 @@ template <> void
 Memory::poke16 <AGNUS_ACCESS, MEM_CHIP> (u32 addr, u16 value)
 {
     assert((addr & agnus.ptrMask) == addr);
+    blitter.joinBlit(addr & chipMask);
+    copper.invalidate(addr & chipMask);
 
     if (BLT_GUARD && blitter.memguard[addr & mem.chipMask]) {
         trace("AGNUS OVERWRITES BLITTER AT ADDR %x\n", addr);
     }
 
+    agnus.syncBplEvents<AGNUS_ACCESS>(addr & chipMask);
     dataBus = value;
     WRITE_CHIP_16(addr, value);
 }
@@ -1487,6 +1591,7 @@ Memory::poke8 <CPU_ACCESS, MEM_AUTOCONF> (u32 addr, u8 value)
     ASSERT_AUTO_ADDR(addr);
     
     // agnus.executeUntilBusIsFree();
+    agnus.syncBplEvents<CPU_ACCESS>();
     
     dataBus = value;
     zorro.pokeFastRamDevice(addr, value);
@@ -1498,6 +1603,7 @@ Memory::poke16 <CPU_ACCESS, MEM_AUTOCONF> (u32 addr, u16 value)
     ASSERT_AUTO_ADDR(addr);
     
     // agnus.executeUntilBusIsFree();
+    agnus.syncBplEvents<CPU_ACCESS>();
 
     dataBus = value;
     zorro.pokeFastRamDevice(addr, HI_BYTE(value));
@@ -1834,6 +1940,7 @@ Memory::peekCustom16(u32 addr)
     u32 result;
 
     assert(IS_EVEN(addr));
+    agnus.syncBplEvents<CPU_ACCESS>();
 
     switch ((addr >> 1) & 0xFF) {
             
@@ -1940,6 +2047,7 @@ Memory::pokeCustom16(u32 addr, u16 value)
 
     assert(IS_EVEN(addr));
 
+    agnus.syncBplEvents<s>();
     dataBus = value;
 
     switch ((addr >> 1) & 0xFF) {
@@ -74,25 +74,28 @@ assert((x) >= 0xE80000 && (x) <= 0xE8FFFF);
 #define WRITE_16(x,y) (*(u16 *)(x) = htons(y))
 // #define WRITE_16(x,y) *(u8 *)(x) = HI_BYTE(y); *(u8 *)((x)+1) = LO_BYTE(y)
 
+// Marks the 64 KB bank of a memory block as modified (see memoryBlock())
+#define TOUCH(nr,offset) (bankDirty[nr][(offset) >> 16] = true)
+
 // Writes a value into Chip RAM in big endian format
-#define WRITE_CHIP_8(x,y)  WRITE_8 (chip + ((x) & chipMask), (y))
-#define WRITE_CHIP_16(x,y) WRITE_16(chip + ((x) & chipMask), (y))
+#define WRITE_CHIP_8(x,y)  (TOUCH(3, (x) & chipMask), WRITE_8 (chip + ((x) & chipMask), (y)))
+#define WRITE_CHIP_16(x,y) (TOUCH(3, (x) & chipMask), WRITE_16(chip + ((x) & chipMask), (y)))
 
 // Writes a value into Fast RAM in big endian format
-#define WRITE_FAST_8(x,y)  WRITE_8 (fast + ((x) - FAST_RAM_STRT), (y))
-#define WRITE_FAST_16(x,y) WRITE_16(fast + ((x) - FAST_RAM_STRT), (y))
+#define WRITE_FAST_8(x,y)  (TOUCH(5, (x) - FAST_RAM_STRT), WRITE_8 (fast + ((x) - FAST_RAM_STRT), (y)))
+#define WRITE_FAST_16(x,y) (TOUCH(5, (x) - FAST_RAM_STRT), WRITE_16(fast + ((x) - FAST_RAM_STRT), (y)))
 
 // Writes a value into Slow RAM in big endian format
-#define WRITE_SLOW_8(x,y)  WRITE_8 (slow + ((x) & slowMask), (y))
-#define WRITE_SLOW_16(x,y) WRITE_16(slow + ((x) & slowMask), (y))
+#define WRITE_SLOW_8(x,y)  (TOUCH(4, (x) & slowMask), WRITE_8 (slow + ((x) & slowMask), (y)))
+#define WRITE_SLOW_16(x,y) (TOUCH(4, (x) & slowMask), WRITE_16(slow + ((x) & slowMask), (y)))
 
 // Writes a value into Kickstart WOM in big endian format
-#define WRITE_WOM_8(x,y)  WRITE_8 (wom + ((x) & womMask), (y))
-#define WRITE_WOM_16(x,y) WRITE_16(wom + ((x) & womMask), (y))
+#define WRITE_WOM_8(x,y)  (TOUCH(1, (x) & womMask), WRITE_8 (wom + ((x) & womMask), (y)))
+#define WRITE_WOM_16(x,y) (TOUCH(1, (x) & womMask), WRITE_16(wom + ((x) & womMask), (y)))
 
 // Writes a value into Extended ROM in big endian format
-#define WRITE_EXT_8(x,y)  WRITE_8 (ext + ((x) & extMask), (y))
-#define WRITE_EXT_16(x,y) WRITE_16(ext + ((x) & extMask), (y))
+#define WRITE_EXT_8(x,y)  (TOUCH(2, (x) & extMask), WRITE_8 (ext + ((x) & extMask), (y)))
+#define WRITE_EXT_16(x,y) (TOUCH(2, (x) & extMask), WRITE_16(ext + ((x) & extMask), (y)))
 
 
 class Memory : public AmigaComponent {
@@ -177,6 +180,15 @@ public:
     MemorySource cpuMemSrc[256];
     MemorySource agnusMemSrc[256];
 
+    /* To speed up state hashing, each memory block is divided into banks of
+     * 64 KB. The hash of a bank is cached and only recomputed if the bank has
+     * been modified in the meantime. All write accesses mark the affected
+     * bank as dirty.
+     * See also: hashMemoryBlock()
+     */
+    u64 bankHash[6][128];
+    bool bankDirty[6][128];
+
     // The last value on the data bus
     u16 dataBus;
 
@@ -269,6 +281,19 @@ private:
     size_t didLoadFromBuffer(u8 *buffer) override;
     size_t didSaveToBuffer(u8 *buffer) override;
 
+    // Exposes Rom, Wom, Ext, Chip Ram, Slow Ram, and Fast Ram (in that order)
+    size_t memoryBlockCount() override { return 6; }
+    u8 *memoryBlock(size_t nr, size_t &size) override;
+    u64 hashMemoryBlock(size_t nr) override;
+
+public:
+
+    // Informs about a write access that bypasses the poke functions
+    void markChipDirty(i64 lo, i64 hi);
+
+    // Invalidates all cached bank hashes
+    void markAllDirty() { memset(bankDirty, true, sizeof(bankDirty)); }
+
     
     //
     // Controlling
@@ -362,9 +387,9 @@ public:
     bool hasExt() { return ext != NULL; }
 
     // Erases an installed Rom
-    void eraseRom() { assert(rom); memset(rom, 0, config.romSize); }
-    void eraseWom() { assert(wom); memset(wom, 0, config.womSize); }
-    void eraseExt() { assert(ext); memset(ext, 0, config.extSize); }
+    void eraseRom() { assert(rom); memset(rom, 0, config.romSize); markAllDirty(); }
+    void eraseWom() { assert(wom); memset(wom, 0, config.womSize); markAllDirty(); }
+    void eraseExt() { assert(ext); memset(ext, 0, config.extSize); markAllDirty(); }
 
     // Installs a Boot Rom or Kickstart Rom
     bool loadRom(RomFile *rom);
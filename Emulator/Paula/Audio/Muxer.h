@@ -185,6 +185,9 @@ private:
     size_t _size() override { COMPUTE_SNAPSHOT_SIZE }
     size_t _load(u8 *buffer) override { LOAD_SNAPSHOT_ITEMS }
     size_t _save(u8 *buffer) override { SAVE_SNAPSHOT_ITEMS }
+
+    // The sample buffers feed the host's audio device, only
+    bool hasGuestState() override { return false; }
     
     
     //
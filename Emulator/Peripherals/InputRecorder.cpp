@@ -0,0 +1,470 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "Amiga.h"
+
+thread_local bool InputRecorder::injecting = false;
+
+InputRecorder::InputRecorder(Amiga& ref) : amiga(ref)
+{
+    setDescription("InputRecorder");
+}
+
+InputRecorder::~InputRecorder()
+{
+    clear();
+}
+
+void
+InputRecorder::clear()
+{
+    std::lock_guard<std::mutex> lock(pendingLock);
+
+    for (Disk *disk : pendingDisks) delete disk;
+    pending.clear();
+    pendingDisks.clear();
+
+    delete snapshot;
+    snapshot = NULL;
+    log.clear();
+    next = 0;
+}
+
+void
+InputRecorder::startRecording()
+{
+    amiga.suspend();
+
+    stopRecording();
+    stopReplay();
+    clear();
+
+    // Record the starting state and continue from the recorded state
+    snapshot = Snapshot::makeWithAmiga(&amiga);
+    amiga.loadFromSnapshotUnsafe(snapshot);
+
+    recording = true;
+    debug(INP_DEBUG, "Recording started at cycle %lld\n", amiga.agnus.clock);
+
+    amiga.resume();
+}
+
+void
+InputRecorder::stopRecording()
+{
+    if (!recording) return;
+
+    amiga.suspend();
+
+    // Apply all inputs that have not been picked up by the run loop yet
+    execute();
+    recording = false;
+    debug(INP_DEBUG, "Recording stopped (%zu events)\n", log.size());
+
+    amiga.resume();
+}
+
+bool
+InputRecorder::startReplay()
+{
+    if (!snapshot) return false;
+
+    amiga.suspend();
+
+    stopRecording();
+    stopReplay();
+
+    amiga.loadFromSnapshotUnsafe(snapshot);
+    next = 0;
+    replaying = true;
+
+    // Replays are not throttled
+    warpBeforeReplay = amiga.inWarpMode();
+    amiga.setWarp(true);
+
+    // Apply all events that have been recorded before the first instruction
+    execute();
+
+    amiga.resume();
+    return true;
+}
+
+void
+InputRecorder::stopReplay()
+{
+    if (!replaying) return;
+
+    amiga.suspend();
+
+    debug(INP_DEBUG, "Replay stopped at event %zu of %zu\n", next, log.size());
+    finishReplay();
+
+    amiga.resume();
+}
+
+void
+InputRecorder::finishReplay()
+{
+    replaying = false;
+    amiga.clearControlFlags(RL_INPUT);
+
+    /* Restore the warp state. Amiga::setWarp() can't be used here, because
+     * this function is also called by the emulator thread which can't suspend
+     * itself. All other callers have suspended the emulator already.
+     */
+    amiga.HardwareComponent::setWarp(warpBeforeReplay);
+}
+
+size_t
+InputRecorder::writeLog(u8 *buffer)
+{
+    if (!snapshot) return 0;
+
+    size_t snpSize = snapshot->writeToBuffer(NULL);
+    size_t result = 8 + snpSize + 8;
+
+    for (InputEvent &e : log) {
+        result += 6 * 8;
+        if (e.type == INP_DISK_INSERT) result += 8 + e.disk->size();
+    }
+
+    if (buffer) {
+
+        u8 *ptr = buffer;
+
+        write64(ptr, snpSize);
+        snapshot->writeToBuffer(ptr);
+        ptr += snpSize;
+
+        write64(ptr, log.size());
+        for (InputEvent &e : log) {
+
+            write64(ptr, e.cycle);
+            write64(ptr, e.type);
+            write64(ptr, e.target);
+            write64(ptr, e.value);
+            writeDouble(ptr, e.x);
+            writeDouble(ptr, e.y);
+
+            if (e.type == INP_DISK_INSERT) {
+
+                write64(ptr, e.disk->size());
+                memcpy(ptr, e.disk->data(), e.disk->size());
+                ptr += e.disk->size();
+            }
+        }
+        assert((size_t)(ptr - buffer) == result);
+    }
+
+    return result;
+}
+
+bool
+InputRecorder::readLog(const u8 *buffer, size_t length)
+{
+    u8 *ptr = (u8 *)buffer;
+    u8 *end = ptr + length;
+
+    vector<InputEvent> events;
+    Snapshot *start = NULL;
+
+    #define FAIL { warn("Corrupted input log\n"); delete start; return false; }
+    #define REMAINING(n) if ((u64)(end - ptr) < (u64)(n)) FAIL
+
+    // Read the starting snapshot
+    REMAINING(8);
+    u64 snpSize = read64(ptr);
+    REMAINING(snpSize);
+    if (!(start = Snapshot::makeWithBuffer(ptr, snpSize))) FAIL
+    ptr += snpSize;
+
+    // Read the events
+    REMAINING(8);
+    u64 count = read64(ptr);
+
+    for (u64 i = 0; i < count; i++) {
+
+        InputEvent e;
+
+        REMAINING(6 * 8);
+        e.cycle = read64(ptr);
+        e.type = (InputEventType)read64(ptr);
+        e.target = read64(ptr);
+        e.value = read64(ptr);
+        e.x = readDouble(ptr);
+        e.y = readDouble(ptr);
+
+        if (!isValid(e)) FAIL
+        if (i && e.cycle < events.back().cycle) FAIL
+
+        if (e.type == INP_DISK_INSERT) {
+
+            REMAINING(8);
+            u64 size = read64(ptr);
+            REMAINING(size);
+            e.disk = std::make_shared<vector<u8>>(ptr, ptr + size);
+            ptr += size;
+        }
+        events.push_back(e);
+    }
+
+    #undef REMAINING
+    #undef FAIL
+
+    amiga.suspend();
+
+    stopRecording();
+    stopReplay();
+    clear();
+
+    snapshot = start;
+    log = std::move(events);
+
+    amiga.resume();
+    return true;
+}
+
+bool
+InputRecorder::isValid(const InputEvent &e)
+{
+    u32 inputPins = RXD_MASK | CTS_MASK | DSR_MASK | CD_MASK | RI_MASK;
+
+    if (!isInputEventType(e.type)) return false;
+
+    switch (e.type) {
+
+        case INP_KEY_PRESS:
+        case INP_KEY_RELEASE:
+
+            return e.target == 0 && e.value >= 0 && e.value < 0x80;
+
+        case INP_JOYSTICK:
+        case INP_MOUSE:
+
+            return isPortNr(e.target) && isGamePadAction(e.value);
+
+        case INP_MOUSE_XY:
+        case INP_MOUSE_DELTA_XY:
+
+            return isPortNr(e.target) && std::isfinite(e.x) && std::isfinite(e.y);
+
+        case INP_MOUSE_LEFT:
+        case INP_MOUSE_RIGHT:
+
+            return isPortNr(e.target) && (e.value == 0 || e.value == 1);
+
+        case INP_DISK_INSERT:
+
+            return e.target >= 0 && e.target <= 3 && isDiskType((DiskType)e.value);
+
+        case INP_DISK_EJECT:
+
+            return e.target >= 0 && e.target <= 3;
+
+        case INP_SERIAL_PIN:
+
+            return e.target >= 1 && e.target <= 25 &&
+            ((1 << e.target) & inputPins) && (e.value == 0 || e.value == 1);
+
+        default:
+            return false;
+    }
+}
+
+bool
+InputRecorder::intercept(InputEventType type, long target, long value)
+{
+    InputEvent event = { 0, type, target, value, 0.0, 0.0, NULL };
+    return intercept(event, NULL);
+}
+
+bool
+InputRecorder::intercept(InputEventType type, long target, double x, double y)
+{
+    InputEvent event = { 0, type, target, 0, x, y, NULL };
+    return intercept(event, NULL);
+}
+
+bool
+InputRecorder::intercept(long nr, Disk *disk)
+{
+    InputEvent event = { 0, INP_DISK_INSERT, nr, 0, 0.0, 0.0, NULL };
+    return intercept(event, disk);
+}
+
+bool
+InputRecorder::intercept(InputEvent &event, Disk *disk)
+{
+    // Let the recorder's own calls pass through
+    if (injecting) return false;
+
+    // Ignore all live inputs while replaying
+    if (replaying) {
+        delete disk;
+        return true;
+    }
+
+    if (!recording) return false;
+
+    // If the emulator is running, defer the input to the next run loop check
+    if (amiga.isRunning()) {
+
+        std::lock_guard<std::mutex> lock(pendingLock);
+
+        pending.push_back(event);
+        pendingDisks.push_back(disk);
+        amiga.setControlFlags(RL_INPUT);
+        return true;
+    }
+
+    record(event, disk);
+    return true;
+}
+
+void
+InputRecorder::execute()
+{
+    if (replaying) {
+
+        // Apply all events that are due
+        while (next < log.size() && log[next].cycle <= amiga.agnus.clock) {
+            apply(log[next++], NULL);
+        }
+
+        // Keep the run loop checking until the log has been processed
+        if (next < log.size()) {
+            amiga.setControlFlags(RL_INPUT);
+        } else {
+            debug(INP_DEBUG, "Replay finished (%zu events)\n", log.size());
+            finishReplay();
+        }
+        return;
+    }
+
+    vector<InputEvent> events;
+    vector<Disk *> disks;
+
+    amiga.clearControlFlags(RL_INPUT);
+
+    {   std::lock_guard<std::mutex> lock(pendingLock);
+        events.swap(pending);
+        disks.swap(pendingDisks);
+    }
+
+    for (size_t i = 0; i < events.size(); i++) {
+        record(events[i], disks[i]);
+    }
+}
+
+void
+InputRecorder::record(InputEvent &event, Disk *disk)
+{
+    event.cycle = amiga.agnus.clock;
+
+    // Keep a copy of inserted disks to recreate them in a replay
+    if (event.type == INP_DISK_INSERT && disk) {
+
+        SerCounter counter;
+        disk->applyToPersistentItems(counter);
+
+        event.value = disk->getType();
+        event.disk = std::make_shared<vector<u8>>(counter.count);
+
+        SerWriter writer(event.disk->data());
+        disk->applyToPersistentItems(writer);
+    }
+
+    log.push_back(event);
+    apply(event, disk);
+}
+
+void
+InputRecorder::apply(InputEvent &event, Disk *disk)
+{
+    trace(INP_DEBUG, "%lld: Event %ld (%ld, %ld)\n",
+          event.cycle, event.type, event.target, event.value);
+
+    injecting = true;
+
+    switch (event.type) {
+
+        case INP_KEY_PRESS:
+
+            amiga.keyboard.pressKey(event.value);
+            break;
+
+        case INP_KEY_RELEASE:
+
+            amiga.keyboard.releaseKey(event.value);
+            break;
+
+        case INP_JOYSTICK:
+
+            (event.target == 1 ? amiga.joystick1 : amiga.joystick2)
+            .trigger((GamePadAction)event.value);
+            break;
+
+        case INP_MOUSE:
+
+            (event.target == 1 ? amiga.mouse1 : amiga.mouse2)
+            .trigger((GamePadAction)event.value);
+            break;
+
+        case INP_MOUSE_XY:
+
+            (event.target == 1 ? amiga.mouse1 : amiga.mouse2)
+            .setXY(event.x, event.y);
+            break;
+
+        case INP_MOUSE_DELTA_XY:
+
+            (event.target == 1 ? amiga.mouse1 : amiga.mouse2)
+            .setDeltaXY(event.x, event.y);
+            break;
+
+        case INP_MOUSE_LEFT:
+
+            (event.target == 1 ? amiga.mouse1 : amiga.mouse2)
+            .setLeftButton(event.value);
+            break;
+
+        case INP_MOUSE_RIGHT:
+
+            (event.target == 1 ? amiga.mouse1 : amiga.mouse2)
+            .setRightButton(event.value);
+            break;
+
+        case INP_DISK_INSERT:
+
+            // Recreate the disk when replaying
+            if (!disk && event.disk) {
+                SerReader reader(event.disk->data());
+                disk = Disk::makeWithReader(reader, (DiskType)event.value);
+            }
+            if (disk) {
+                amiga.df[event.target]->insertDisk(disk);
+            }
+            break;
+
+        case INP_DISK_EJECT:
+
+            amiga.df[event.target]->ejectDisk();
+            break;
+
+        case INP_SERIAL_PIN:
+
+            amiga.serialPort.setPin((int)event.target, event.value);
+            break;
+
+        default:
+            assert(false);
+    }
+
+    injecting = false;
+}
@@ -0,0 +1,191 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef _INPUT_RECORDER_H
+#define _INPUT_RECORDER_H
+
+#include "AmigaObject.h"
+
+#include <memory>
+#include <mutex>
+
+class Amiga;
+class Disk;
+class Snapshot;
+
+// A single external input, time-stamped with the master clock
+struct InputEvent {
+
+    // Master cycle at which the input took effect
+    Cycle cycle;
+
+    // Kind of input
+    InputEventType type;
+
+    // Port, drive or pin number (depending on the event type)
+    long target;
+
+    // Keycode, gamepad action, button or pin state (depending on the type)
+    long value;
+
+    // Mouse coordinates (INP_MOUSE_XY and INP_MOUSE_DELTA_XY)
+    double x;
+    double y;
+
+    // Serialized disk (INP_DISK_INSERT)
+    std::shared_ptr<vector<u8>> disk;
+};
+
+/* Records and replays all external inputs of a virtual Amiga. A recording
+ * starts with a snapshot and lists every keyboard, gamepad, mouse, disk and
+ * serial port input together with the master cycle it became effective in.
+ * Because the emulator is deterministic otherwise, restoring the snapshot and
+ * feeding in the inputs at the same cycles reproduces the recorded session
+ * bit by bit.
+ *
+ * Inputs from the GUI arrive asynchronously while the CPU is in the middle of
+ * an instruction. To give them a well-defined point in time, they are queued
+ * while the emulator is running and applied by the run loop between two
+ * instructions (RL_INPUT). In replay mode, the run loop applies each logged
+ * event at the first instruction boundary that reaches its time stamp, which
+ * is exactly the boundary it was recorded at. Live inputs are ignored while a
+ * replay is in progress.
+ */
+class InputRecorder : public AmigaObject {
+
+    // Reference to the emulated Amiga
+    Amiga &amiga;
+
+    // The state the recording starts from
+    Snapshot *snapshot = NULL;
+
+    // The recorded inputs in chronological order
+    vector<InputEvent> log;
+
+    // Index of the next event to replay
+    size_t next = 0;
+
+    // Inputs waiting to be applied by the run loop
+    vector<InputEvent> pending;
+
+    // Disks belonging to the pending INP_DISK_INSERT events
+    vector<Disk *> pendingDisks;
+
+    // Protects the pending queue
+    std::mutex pendingLock;
+
+    // Current mode of operation
+    bool recording = false;
+    bool replaying = false;
+
+    // Warp state to restore when a replay is over
+    bool warpBeforeReplay = false;
+
+    // Set while the recorder itself calls an input function
+    static thread_local bool injecting;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    InputRecorder(Amiga& ref);
+    ~InputRecorder();
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    /* Starts a new recording. The current emulator state is written into a
+     * snapshot that is loaded back immediately. Hence, the live session and
+     * all later replays start from the very same state, including all items
+     * that are discarded when a snapshot is restored (e.g., joystick axes).
+     */
+    void startRecording();
+    void stopRecording();
+    bool isRecording() { return recording; }
+
+
+    //
+    // Replaying
+    //
+
+public:
+
+    /* Restores the starting snapshot and replays all recorded inputs. The
+     * replay runs in warp mode. Once the last event has been applied, the
+     * previous warp state is restored.
+     */
+    bool startReplay();
+    void stopReplay();
+    bool isReplaying() { return replaying; }
+
+    // Returns the number of recorded events and the replay position
+    size_t numEvents() { return log.size(); }
+    size_t replayPosition() { return next; }
+
+
+    //
+    // Exporting and importing
+    //
+
+public:
+
+    /* Writes the starting snapshot and the event log into a buffer. If NULL
+     * is passed in, only the required buffer size is computed.
+     */
+    size_t writeLog(u8 *buffer);
+
+    // Reads a recording that has been created by writeLog()
+    bool readLog(const u8 *buffer, size_t length);
+
+
+    //
+    // Processing inputs
+    //
+
+public:
+
+    /* Hooks for the input functions. They return true if the caller must not
+     * perform the action itself, either because the recorder takes care of it
+     * or because a replay is in progress.
+     */
+    bool intercept(InputEventType type, long target, long value);
+    bool intercept(InputEventType type, long target, double x, double y);
+    bool intercept(long nr, Disk *disk);
+
+    // Applies pending and due events (called by the run loop on RL_INPUT)
+    void execute();
+
+private:
+
+    bool intercept(InputEvent &event, Disk *disk);
+
+    // Adds an event to the log and carries out the action
+    void record(InputEvent &event, Disk *disk);
+
+    // Carries out the action described by an event
+    void apply(InputEvent &event, Disk *disk);
+
+    // Checks if an event read from a log is well-formed
+    bool isValid(const InputEvent &event);
+
+    // Leaves replay mode and restores the warp state
+    void finishReplay();
+
+    // Discards the recording
+    void clear();
+};
+
+#endif
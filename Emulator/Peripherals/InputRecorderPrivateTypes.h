@@ -0,0 +1,32 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef _INPUT_RECORDER_PRIVATE_TYPES_H
+#define _INPUT_RECORDER_PRIVATE_TYPES_H
+
+enum InputEventType : long
+{
+    INP_KEY_PRESS,       // Keyboard::pressKey()
+    INP_KEY_RELEASE,     // Keyboard::releaseKey()
+    INP_JOYSTICK,        // Joystick::trigger()
+    INP_MOUSE,           // Mouse::trigger()
+    INP_MOUSE_XY,        // Mouse::setXY()
+    INP_MOUSE_DELTA_XY,  // Mouse::setDeltaXY()
+    INP_MOUSE_LEFT,      // Mouse::setLeftButton()
+    INP_MOUSE_RIGHT,     // Mouse::setRightButton()
+    INP_DISK_INSERT,     // Drive::insertDisk()
+    INP_DISK_EJECT,      // Drive::ejectDisk()
+    INP_SERIAL_PIN       // SerialPort::setPin()
+};
+
+inline bool isInputEventType(long value) {
+    return value >= 0 && value <= INP_SERIAL_PIN;
+}
+
+#endif
@@ -38,6 +38,7 @@ Joystick::didLoadFromBuffer(u8 *buffer)
     button = false;
     axisX = 0;
     axisY = 0;
+    bulletCounter = 0;
 
     return 0;
 }
@@ -113,6 +114,8 @@ Joystick::trigger(GamePadAction event)
 {
     assert(isGamePadAction(event));
 
+    if (amiga.inputRecorder.intercept(INP_JOYSTICK, nr, event)) return;
+
     trace(PORT_DEBUG, "trigger(%d)\n", event);
      
     switch (event) {
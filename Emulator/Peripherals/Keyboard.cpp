@@ -77,6 +77,8 @@ Keyboard::pressKey(long keycode)
 {
     assert(keycode < 0x80);
 
+    if (amiga.inputRecorder.intercept(INP_KEY_PRESS, 0, keycode)) return;
+
     if (!keyDown[keycode] && !bufferIsFull()) {
 
         trace(KBD_DEBUG, "Pressing Amiga key %02X\n", keycode);
@@ -96,6 +98,8 @@ Keyboard::releaseKey(long keycode)
 {
     assert(keycode < 0x80);
 
+    if (amiga.inputRecorder.intercept(INP_KEY_RELEASE, 0, keycode)) return;
+
     if (keyDown[keycode] && !bufferIsFull()) {
 
         trace(KBD_DEBUG, "Releasing Amiga key %02X\n", keycode);
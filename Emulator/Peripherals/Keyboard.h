@@ -101,7 +101,8 @@ private:
         & spLow
         & spHigh
         & typeAheadBuffer
-        & bufferIndex;
+        & bufferIndex
+        & keyDown;
     }
 
     
@@ -20,15 +20,6 @@ Mouse::Mouse(PortNr n, Amiga& ref) : nr(n), AmigaComponent(ref)
 void Mouse::_reset(bool hard)
 {
     RESET_SNAPSHOT_ITEMS(hard)
-    
-    leftButton = false;
-    rightButton = false;
-    mouseX = 0;
-    mouseY = 0;
-    oldMouseX = 0;
-    oldMouseY = 0;
-    targetX = 0;
-    targetY = 0;
 }
 
 void
@@ -107,6 +98,8 @@ Mouse::getXY()
 void
 Mouse::setXY(double x, double y)
 {
+    if (amiga.inputRecorder.intercept(INP_MOUSE_XY, nr, x, y)) return;
+
     targetX = x / dividerX;
     targetY = y / dividerY;
 }
@@ -114,6 +107,8 @@ Mouse::setXY(double x, double y)
 void
 Mouse::setDeltaXY(double dx, double dy)
 {
+    if (amiga.inputRecorder.intercept(INP_MOUSE_DELTA_XY, nr, dx, dy)) return;
+
     targetX += dx / dividerX;
     targetY += dy / dividerY;
 }
@@ -121,6 +116,8 @@ Mouse::setDeltaXY(double dx, double dy)
 void
 Mouse::setLeftButton(bool value)
 {
+    if (amiga.inputRecorder.intercept(INP_MOUSE_LEFT, nr, value)) return;
+
     trace(PORT_DEBUG, "setLeftButton(%d)\n", value);
     leftButton = value;
 }
@@ -128,6 +125,8 @@ Mouse::setLeftButton(bool value)
 void
 Mouse::setRightButton(bool value)
 {
+    if (amiga.inputRecorder.intercept(INP_MOUSE_RIGHT, nr, value)) return;
+
     trace(PORT_DEBUG, "setRightButton(%d)\n", value);
     rightButton = value;
 }
@@ -137,6 +136,8 @@ Mouse::trigger(GamePadAction event)
 {
     assert(isGamePadAction(event));
 
+    if (amiga.inputRecorder.intercept(INP_MOUSE, nr, event)) return;
+
     trace(PORT_DEBUG, "trigger(%d)\n", event);
 
     switch (event) {
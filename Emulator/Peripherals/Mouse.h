@@ -93,6 +93,16 @@ private:
     template <class T>
     void applyToResetItems(T& worker)
     {
+        worker
+
+        & leftButton
+        & rightButton
+        & mouseX
+        & mouseY
+        & oldMouseX
+        & oldMouseY
+        & targetX
+        & targetY;
     }
 
     size_t _size() override { COMPUTE_SNAPSHOT_SIZE }
@@ -90,6 +90,11 @@ SerialPort::setPin(int nr, bool value)
     // debug(SER_DEBUG, "setPin(%d,%d)\n", nr, value);
     assert(nr >= 1 && nr <= 25);
 
+    // Record all pins driven from the outside
+    u32 inputPins = RXD_MASK | CTS_MASK | DSR_MASK | CD_MASK | RI_MASK;
+    if (((1 << nr) & inputPins) &&
+        amiga.inputRecorder.intercept(INP_SERIAL_PIN, nr, value)) return;
+
     setPort(1 << nr, value);
 }
 
@@ -308,10 +308,11 @@ class Renderer: NSObject, MTKViewDelegate {
     
     func updateTexture() {
                 
-        let buffer = parent.amiga.denise.stableBuffer()
-        
+        let buffer = parent.amiga.denise.acquireBuffer()
+        defer { parent.amiga.denise.releaseBuffer(buffer) }
+
         // Only proceed if the emulator delivers a new texture
-        if prevBuffer?.data == buffer.data { return }
+        if prevBuffer?.frameNr == buffer.frameNr { return }
         prevBuffer = buffer
 
         // Determine if the new texture is a long frame or a short frame
@@ -337,6 +337,15 @@ struct SerialPortWrapper;
 - (EventInfo) getEventInfo;
 - (AgnusStats) getStats;
 
+- (BOOL) isProfiling;
+- (void) setProfiling:(BOOL)value;
+- (NSInteger) profiledFrames;
+- (FrameProfile) getFrameProfile:(NSInteger)nr;
+- (FrameProfile) getTotalProfile;
+- (NSArray<NSValue *> *) getHistogram:(NSInteger)nr;
+- (NSArray<NSValue *> *) getTotalHistogram;
+- (BOOL) dumpProfile:(NSURL *)url;
+
 @end
 
 
@@ -433,6 +442,8 @@ struct SerialPortWrapper;
 @property double contrast;
 
 - (ScreenBuffer) stableBuffer;
+- (ScreenBuffer) acquireBuffer;
+- (void) releaseBuffer:(ScreenBuffer)buffer;
 - (u32 *) noise;
 
 @end
@@ -479,6 +479,46 @@ struct SerialPortWrapper { SerialPort *port; };
 {
     return wrapper->agnus->getStats();
 }
+- (BOOL) isProfiling
+{
+    return wrapper->agnus->dmaProfiler.isEnabled();
+}
+- (void) setProfiling:(BOOL)value
+{
+    wrapper->agnus->dmaProfiler.setEnabled(value);
+}
+- (NSInteger) profiledFrames
+{
+    return wrapper->agnus->dmaProfiler.frameCount();
+}
+- (FrameProfile) getFrameProfile:(NSInteger)nr
+{
+    return wrapper->agnus->dmaProfiler.getFrame((int)nr);
+}
+- (FrameProfile) getTotalProfile
+{
+    return wrapper->agnus->dmaProfiler.getTotal();
+}
+- (NSArray<NSValue *> *) histogram:(const vector<BlitProfile> &)buckets
+{
+    NSMutableArray<NSValue *> *result = [NSMutableArray arrayWithCapacity:buckets.size()];
+    for (const BlitProfile &bucket : buckets) {
+        [result addObject:[NSValue valueWithBytes:&bucket objCType:@encode(BlitProfile)]];
+    }
+    return result;
+}
+- (NSArray<NSValue *> *) getHistogram:(NSInteger)nr
+{
+    return [self histogram:wrapper->agnus->dmaProfiler.getHistogram((int)nr)];
+}
+- (NSArray<NSValue *> *) getTotalHistogram
+{
+    return [self histogram:wrapper->agnus->dmaProfiler.getTotalHistogram()];
+}
+- (BOOL) dumpProfile:(NSURL *)url
+{
+    return wrapper->agnus->dmaProfiler.dumpJSON([url fileSystemRepresentation]);
+}
 
 @end
 
@@ -728,6 +768,14 @@ struct SerialPortWrapper { SerialPort *port; };
 {
     return wrapper->denise->pixelEngine.getStableBuffer();
 }
+- (ScreenBuffer) acquireBuffer
+{
+    return wrapper->denise->pixelEngine.acquireBuffer();
+}
+- (void) releaseBuffer:(ScreenBuffer)buffer
+{
+    wrapper->denise->pixelEngine.releaseBuffer(buffer);
+}
 - (u32 *) noise
 {
     return wrapper->denise->pixelEngine.getNoise(); 
@@ -1364,8 +1412,9 @@ struct SerialPortWrapper { SerialPort *port; };
 - (NSData *)data
 {
     Snapshot *snapshot = (Snapshot *)wrapper->file;
-    return [NSData dataWithBytes: (void *)snapshot->getHeader()
-                          length: snapshot->sizeOnDisk()];
+    NSMutableData *data = [NSMutableData dataWithLength: snapshot->sizeOnDisk()];
+    snapshot->writeToBuffer((u8 *)[data mutableBytes]);
+    return data;
 }
     
 @end